@@ -33,17 +33,28 @@ EXPERIMENTS = {
     },
     "off": {
         "core_end2end_test": [
+            "pass_through_exec_ctx",
             "promise_based_client_call",
         ],
+        "cq_test": [
+            "pass_through_exec_ctx",
+            "sharded_completion_queue",
+        ],
         "endpoint_test": [
+            "pressure_aware_buffer_sizing",
+            "slice_pool",
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
         ],
         "event_engine_client_test": [
             "event_engine_client",
         ],
+        "event_engine_timer_test": [
+            "timer_wheel",
+        ],
         "flow_control_test": [
             "peer_state_based_framing",
+            "pressure_aware_buffer_sizing",
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
         ],
@@ -52,6 +63,9 @@ EXPERIMENTS = {
         ],
         "resource_quota_test": [
             "memory_pressure_controller",
+            "per_cpu_memory_quota",
+            "pressure_aware_buffer_sizing",
+            "slice_pool",
             "unconstrained_max_quota_buffer_size",
         ],
     },
@@ -291,6 +291,19 @@ typedef struct {
  *  protector.
  */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** EXPERIMENTAL. If positive, TSI handshaker steps of security handshakes are
+    run on a dedicated pool of up to this many threads instead of on the thread
+    that received the handshake bytes, so that expensive handshakes do not stall
+    I/O for established connections. The pool is shared by the whole process:
+    it has as many threads as the largest value set, capped at the number of
+    CPU cores. Int valued, defaults to 0 (disabled). */
+#define GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD_MAX_CONCURRENT \
+  "grpc.experimental.security_handshake_offload_max_concurrent"
+/** EXPERIMENTAL. Maximum time a security handshake step may wait for a thread
+    of the handshake offload pool before the handshake is failed. Int valued,
+    milliseconds. Defaults to 10 seconds. */
+#define GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD_QUEUE_TIMEOUT_MS \
+  "grpc.experimental.security_handshake_offload_queue_timeout_ms"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
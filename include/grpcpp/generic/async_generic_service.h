@@ -21,6 +21,10 @@
 
 #include <grpc/impl/codegen/port_platform.h>
 
+#include <memory>
+#include <utility>
+
+#include <grpcpp/impl/channel_interface.h>
 #include <grpcpp/impl/server_callback_handlers.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/byte_buffer.h>
@@ -130,6 +134,41 @@ class CallbackGenericService {
   grpc::Server* server_{nullptr};
 };
 
+namespace experimental {
+
+/// Splices the call of \a ctx onto a new call to the same method on
+/// \a channel and returns the reactor of the incoming call, to be returned
+/// from CallbackGenericService::CreateReactor. Messages are forwarded in both
+/// directions as the ByteBuffers they arrived in, sharing their slices, and
+/// are never parsed or re-encoded. The client metadata, deadline and
+/// cancellation of the incoming call are propagated to the outgoing one, and
+/// the initial metadata, trailing metadata and status of the outgoing call
+/// are returned to the client. Each direction has one message in flight at a
+/// time, so a slow reader on either side pushes back on the other.
+ServerGenericBidiReactor* SpliceGenericCall(
+    GenericCallbackServerContext* ctx,
+    std::shared_ptr<grpc::ChannelInterface> channel);
+
+/// A generic service that forwards every call it receives to \a channel with
+/// SpliceGenericCall. Proxies that route by method or host can instead call
+/// SpliceGenericCall from their own CallbackGenericService.
+class CallbackGenericProxyService : public CallbackGenericService {
+ public:
+  explicit CallbackGenericProxyService(
+      std::shared_ptr<grpc::ChannelInterface> channel)
+      : channel_(std::move(channel)) {}
+
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* ctx) override {
+    return SpliceGenericCall(ctx, channel_);
+  }
+
+ private:
+  const std::shared_ptr<grpc::ChannelInterface> channel_;
+};
+
+}  // namespace experimental
+
 }  // namespace grpc
 
 #endif  // GRPCPP_GENERIC_ASYNC_GENERIC_SERVICE_H
@@ -348,7 +348,7 @@ class CallOpSendMessage {
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::PRE_SEND_MESSAGE);
     interceptor_methods->SetSendMessage(&send_buf_, &msg_, &failed_send_,
-                                        serializer_);
+                                        &serializer_);
   }
 
   void SetFinishInterceptionHookPoint(
@@ -1023,7 +1023,16 @@ class CallOpSet : public CallOpSetInterface,
     this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    return interceptor_methods_.RunInterceptors();
+    if (interceptor_methods_.RunInterceptors()) {
+      if (!interceptor_methods_.InterceptorsListEmpty()) {
+        // None of the interceptors act on these hook points, so the batch
+        // completes without the extra round trip that would have matched
+        // RegisterAvalanching
+        call_.cq()->CompleteAvalanching();
+      }
+      return true;
+    }
+    return false;
   }
 
   void* core_cq_tag_;
@@ -19,7 +19,6 @@
 #ifndef GRPCPP_IMPL_INTERCEPTOR_COMMON_H
 #define GRPCPP_IMPL_INTERCEPTOR_COMMON_H
 
-#include <array>
 #include <functional>
 
 #include <grpc/impl/codegen/grpc_types.h>
@@ -35,20 +34,13 @@ namespace internal {
 class InterceptorBatchMethodsImpl
     : public experimental::InterceptorBatchMethods {
  public:
-  InterceptorBatchMethodsImpl() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
-    }
-  }
+  InterceptorBatchMethodsImpl() {}
 
   ~InterceptorBatchMethodsImpl() override {}
 
   bool QueryInterceptionHookPoint(
       experimental::InterceptionHookPoints type) override {
-    return hooks_[static_cast<size_t>(type)];
+    return (hooks_ & experimental::InterceptionHookPointBit(type)) != 0;
   }
 
   void Proceed() override {
@@ -75,13 +67,13 @@ class InterceptorBatchMethodsImpl
   }
 
   void AddInterceptionHookPoint(experimental::InterceptionHookPoints type) {
-    hooks_[static_cast<size_t>(type)] = true;
+    hooks_ |= experimental::InterceptionHookPointBit(type);
   }
 
   ByteBuffer* GetSerializedSendMessage() override {
     GPR_CODEGEN_ASSERT(orig_send_message_ != nullptr);
     if (*orig_send_message_ != nullptr) {
-      GPR_CODEGEN_ASSERT(serializer_(*orig_send_message_).ok());
+      GPR_CODEGEN_ASSERT((*serializer_)(*orig_send_message_).ok());
       *orig_send_message_ = nullptr;
     }
     return send_message_;
@@ -128,8 +120,8 @@ class InterceptorBatchMethodsImpl
   Status* GetRecvStatus() override { return recv_status_; }
 
   void FailHijackedSendMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE));
     *fail_send_message_ = true;
   }
 
@@ -140,7 +132,7 @@ class InterceptorBatchMethodsImpl
 
   void SetSendMessage(ByteBuffer* buf, const void** msg,
                       bool* fail_send_message,
-                      std::function<Status(const void*)> serializer) {
+                      const std::function<Status(const void*)>* serializer) {
     send_message_ = buf;
     orig_send_message_ = msg;
     fail_send_message_ = fail_send_message;
@@ -191,8 +183,8 @@ class InterceptorBatchMethodsImpl
   }
 
   void FailHijackedRecvMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE));
     *hijacked_recv_message_failed_ = true;
   }
 
@@ -233,25 +225,17 @@ class InterceptorBatchMethodsImpl
   // SetCallOpSetInterface should have been called before this. After all the
   // interceptors are done running, either ContinueFillOpsAfterInterception or
   // ContinueFinalizeOpsAfterInterception will be called. Note that neither of
-  // them is invoked if there were no interceptors registered.
+  // them is invoked if no registered interceptor acts on the hook points of
+  // this batch, in which case this returns true.
   bool RunInterceptors() {
     GPR_CODEGEN_ASSERT(ops_);
-    auto* client_rpc_info = call_->client_rpc_info();
-    if (client_rpc_info != nullptr) {
-      if (client_rpc_info->interceptors_.empty()) {
-        return true;
-      } else {
-        RunClientInterceptors();
-        return false;
-      }
+    if (call_->client_rpc_info() != nullptr) {
+      return !RunClientInterceptors();
     }
-
-    auto* server_rpc_info = call_->server_rpc_info();
-    if (server_rpc_info == nullptr || server_rpc_info->interceptors_.empty()) {
+    if (call_->server_rpc_info() == nullptr) {
       return true;
     }
-    RunServerInterceptors();
-    return false;
+    return !RunServerInterceptors();
   }
 
   // Returns true if no interceptors are run. Returns false otherwise if there
@@ -262,38 +246,74 @@ class InterceptorBatchMethodsImpl
     // This is used only by the server for initial call request
     GPR_CODEGEN_ASSERT(reverse_ == true);
     GPR_CODEGEN_ASSERT(call_->client_rpc_info() == nullptr);
-    auto* server_rpc_info = call_->server_rpc_info();
-    if (server_rpc_info == nullptr || server_rpc_info->interceptors_.empty()) {
+    if (call_->server_rpc_info() == nullptr) {
       return true;
     }
     callback_ = std::move(f);
-    RunServerInterceptors();
-    return false;
+    return !RunServerInterceptors();
   }
 
  private:
-  void RunClientInterceptors() {
+  // Returns the first interceptor at or after \a pos that acts on one of the
+  // hook points of this batch, or the number of interceptors if there is none.
+  template <typename RpcInfo>
+  size_t NextInterceptor(const RpcInfo* rpc_info, size_t pos) const {
+    while (pos < rpc_info->interceptors_.size() &&
+           (rpc_info->interceptor_hooks_[pos] & hooks_) == 0) {
+      pos++;
+    }
+    return pos;
+  }
+
+  // Returns one past the last interceptor before \a end that acts on one of
+  // the hook points of this batch, or 0 if there is none.
+  template <typename RpcInfo>
+  size_t PrevInterceptorEnd(const RpcInfo* rpc_info, size_t end) const {
+    while (end > 0 && (rpc_info->interceptor_hooks_[end - 1] & hooks_) == 0) {
+      end--;
+    }
+    return end;
+  }
+
+  // Returns false if no interceptor acts on this batch.
+  bool RunClientInterceptors() {
     auto* rpc_info = call_->client_rpc_info();
     if (!reverse_) {
-      current_interceptor_index_ = 0;
-    } else {
       if (rpc_info->hijacked_) {
-        current_interceptor_index_ = rpc_info->hijacked_interceptor_;
+        // The hijacking interceptor has to see every batch
+        current_interceptor_index_ = 0;
       } else {
-        current_interceptor_index_ = rpc_info->interceptors_.size() - 1;
+        current_interceptor_index_ = NextInterceptor(rpc_info, 0);
+        if (current_interceptor_index_ == rpc_info->interceptors_.size()) {
+          return false;
+        }
       }
+    } else {
+      size_t end = PrevInterceptorEnd(
+          rpc_info, rpc_info->hijacked_ ? rpc_info->hijacked_interceptor_ + 1
+                                        : rpc_info->interceptors_.size());
+      if (end == 0) return false;
+      current_interceptor_index_ = end - 1;
     }
     rpc_info->RunInterceptor(this, current_interceptor_index_);
+    return true;
   }
 
-  void RunServerInterceptors() {
+  // Returns false if no interceptor acts on this batch.
+  bool RunServerInterceptors() {
     auto* rpc_info = call_->server_rpc_info();
     if (!reverse_) {
-      current_interceptor_index_ = 0;
+      current_interceptor_index_ = NextInterceptor(rpc_info, 0);
+      if (current_interceptor_index_ == rpc_info->interceptors_.size()) {
+        return false;
+      }
     } else {
-      current_interceptor_index_ = rpc_info->interceptors_.size() - 1;
+      size_t end = PrevInterceptorEnd(rpc_info, rpc_info->interceptors_.size());
+      if (end == 0) return false;
+      current_interceptor_index_ = end - 1;
     }
     rpc_info->RunInterceptor(this, current_interceptor_index_);
+    return true;
   }
 
   void ProceedClient() {
@@ -309,7 +329,10 @@ class InterceptorBatchMethodsImpl
       return;
     }
     if (!reverse_) {
-      current_interceptor_index_++;
+      current_interceptor_index_ =
+          rpc_info->hijacked_
+              ? current_interceptor_index_ + 1
+              : NextInterceptor(rpc_info, current_interceptor_index_ + 1);
       // We are going down the stack of interceptors
       if (current_interceptor_index_ < rpc_info->interceptors_.size()) {
         if (rpc_info->hijacked_ &&
@@ -325,9 +348,10 @@ class InterceptorBatchMethodsImpl
       }
     } else {
       // We are going up the stack of interceptors
-      if (current_interceptor_index_ > 0) {
+      size_t end = PrevInterceptorEnd(rpc_info, current_interceptor_index_);
+      if (end > 0) {
         // Continue running interceptors
-        current_interceptor_index_--;
+        current_interceptor_index_ = end - 1;
         rpc_info->RunInterceptor(this, current_interceptor_index_);
       } else {
         // we are done running all the interceptors without any hijacking
@@ -339,7 +363,8 @@ class InterceptorBatchMethodsImpl
   void ProceedServer() {
     auto* rpc_info = call_->server_rpc_info();
     if (!reverse_) {
-      current_interceptor_index_++;
+      current_interceptor_index_ =
+          NextInterceptor(rpc_info, current_interceptor_index_ + 1);
       if (current_interceptor_index_ < rpc_info->interceptors_.size()) {
         return rpc_info->RunInterceptor(this, current_interceptor_index_);
       } else if (ops_) {
@@ -347,9 +372,10 @@ class InterceptorBatchMethodsImpl
       }
     } else {
       // We are going up the stack of interceptors
-      if (current_interceptor_index_ > 0) {
+      size_t end = PrevInterceptorEnd(rpc_info, current_interceptor_index_);
+      if (end > 0) {
         // Continue running interceptors
-        current_interceptor_index_--;
+        current_interceptor_index_ = end - 1;
         return rpc_info->RunInterceptor(this, current_interceptor_index_);
       } else if (ops_) {
         return ops_->ContinueFinalizeResultAfterInterception();
@@ -359,19 +385,14 @@ class InterceptorBatchMethodsImpl
     callback_();
   }
 
-  void ClearHookPoints() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
-    }
-  }
+  void ClearHookPoints() { hooks_ = 0; }
 
-  std::array<bool,
-             static_cast<size_t>(
-                 experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS)>
-      hooks_;
+  static_assert(
+      static_cast<size_t>(
+          experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS) < 32,
+      "hook points must fit in a uint32_t mask");
+  // The InterceptionHookPointBit of each hook point in this batch
+  uint32_t hooks_ = 0;
 
   size_t current_interceptor_index_ = 0;  // Current iterator
   bool reverse_ = false;
@@ -384,7 +405,7 @@ class InterceptorBatchMethodsImpl
   ByteBuffer* send_message_ = nullptr;
   bool* fail_send_message_ = nullptr;
   const void** orig_send_message_ = nullptr;
-  std::function<Status(const void*)> serializer_;
+  const std::function<Status(const void*)>* serializer_ = nullptr;
 
   std::multimap<std::string, std::string>* send_initial_metadata_;
 
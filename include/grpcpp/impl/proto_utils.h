@@ -19,6 +19,10 @@
 #ifndef GRPCPP_IMPL_PROTO_UTILS_H
 #define GRPCPP_IMPL_PROTO_UTILS_H
 
+#include <limits.h>
+#include <stddef.h>
+
+#include <new>
 #include <type_traits>
 
 #include <grpc/byte_buffer_reader.h>
@@ -28,11 +32,17 @@
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/serialization_traits.h>
 #include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/message_allocator.h>
 #include <grpcpp/support/proto_buffer_reader.h>
 #include <grpcpp/support/proto_buffer_writer.h>
 #include <grpcpp/support/slice.h>
 #include <grpcpp/support/status.h>
 
+// Only the open source protobuf has an arena the messages can be built on.
+#ifdef GRPC_OPEN_SOURCE_PROTO
+#include <google/protobuf/arena.h>
+#endif
+
 /// This header provides serialization and deserialization between gRPC
 /// messages serialized using protobuf and the C++ objects they represent.
 
@@ -40,6 +50,11 @@ namespace grpc {
 
 extern CoreCodegenInterface* g_core_codegen_interface;
 
+// Messages up to this size are serialized into a single slice of exactly
+// their size. Larger ones go through the ProtoBufferWriter in blocks of
+// kProtoBufferWriterMaxBufferLength, to bound the size of any one allocation.
+const int kProtoBufferSingleSliceMaxLength = 16 * 1024 * 1024;
+
 // ProtoBufferWriter must be a subclass of ::protobuf::io::ZeroCopyOutputStream.
 template <class ProtoBufferWriter, class T>
 Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
@@ -50,7 +65,9 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = static_cast<int>(msg.ByteSizeLong());
-  if (static_cast<size_t>(byte_size) <= GRPC_SLICE_INLINED_SIZE) {
+  if (static_cast<size_t>(byte_size) <=
+      static_cast<size_t>(kProtoBufferSingleSliceMaxLength)) {
+    // Inlined for small messages, otherwise one exactly sized allocation.
     Slice slice(byte_size);
     // We serialize directly into the allocated slices memory
     GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
@@ -66,6 +83,35 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
              : Status(StatusCode::INTERNAL, "Failed to serialize message");
 }
 
+namespace internal {
+
+// Parses messages received as a single uncompressed slice, the common case
+// for messages that fit in one transport frame, straight from the slice's
+// memory instead of through a ZeroCopyInputStream.
+class ContiguousProtoParser {
+ public:
+  // Returns false, leaving \a status untouched, if \a buffer is not a single
+  // uncompressed slice.
+  static bool TryParse(ByteBuffer* buffer, grpc::protobuf::MessageLite* msg,
+                       Status* status) {
+    grpc_byte_buffer* bb = buffer->c_buffer();
+    if (bb == nullptr || bb->type != GRPC_BB_RAW ||
+        bb->data.raw.compression != GRPC_COMPRESS_NONE ||
+        bb->data.raw.slice_buffer.count != 1) {
+      return false;
+    }
+    const grpc_slice& slice = bb->data.raw.slice_buffer.slices[0];
+    if (GRPC_SLICE_LENGTH(slice) > static_cast<size_t>(INT_MAX)) return false;
+    if (!msg->ParseFromArray(GRPC_SLICE_START_PTR(slice),
+                             static_cast<int>(GRPC_SLICE_LENGTH(slice)))) {
+      *status = Status(StatusCode::INTERNAL, msg->InitializationErrorString());
+    }
+    return true;
+  }
+};
+
+}  // namespace internal
+
 // BufferReader must be a subclass of ::protobuf::io::ZeroCopyInputStream.
 template <class ProtoBufferReader, class T>
 Status GenericDeserialize(ByteBuffer* buffer,
@@ -78,6 +124,10 @@ Status GenericDeserialize(ByteBuffer* buffer,
     return Status(StatusCode::INTERNAL, "No payload");
   }
   Status result = g_core_codegen_interface->ok();
+  if (internal::ContiguousProtoParser::TryParse(buffer, msg, &result)) {
+    buffer->Clear();
+    return result;
+  }
   {
     ProtoBufferReader reader(buffer);
     if (!reader.status().ok()) {
@@ -112,6 +162,47 @@ class SerializationTraits<
     return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
   }
 };
+
+namespace internal {
+
+using ProtobufArena = ::google::protobuf::Arena;
+
+// Places a ProtobufArena, and the first block of memory it allocates the
+// messages from, in the call arena. Both messages are created on the
+// protobuf arena, so parsing a deeply nested request does not go to the heap
+// for every submessage and the whole tree is freed at once when the call
+// ends.
+template <class RequestT, class ResponseT>
+class MessageArena<
+    RequestT, ResponseT,
+    typename std::enable_if<
+        ProtobufArena::is_arena_constructable<RequestT>::value &&
+        ProtobufArena::is_arena_constructable<ResponseT>::value>::type> {
+ private:
+  static constexpr size_t kInitialBlockSize = 1024;
+
+  class Holder : public MessageHolder<RequestT, ResponseT> {
+   public:
+    Holder()
+        : arena_(reinterpret_cast<char*>(this) + sizeof(Holder),
+                 kInitialBlockSize) {
+      this->set_request(ProtobufArena::CreateMessage<RequestT>(&arena_));
+      this->set_response(ProtobufArena::CreateMessage<ResponseT>(&arena_));
+    }
+    void Release() override { this->~Holder(); }
+
+   private:
+    ProtobufArena arena_;
+  };
+
+ public:
+  static constexpr size_t kSize = sizeof(Holder) + kInitialBlockSize;
+  static MessageHolder<RequestT, ResponseT>* AllocateMessages(void* memory) {
+    return new (memory) Holder();
+  }
+};
+
+}  // namespace internal
 #endif
 
 }  // namespace grpc
@@ -25,10 +25,12 @@
 #include <memory>
 #include <vector>
 
+#include <grpc/grpc.h>
 #include <grpc/support/log.h>
 #include <grpcpp/impl/rpc_method.h>
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/config.h>
+#include <grpcpp/support/message_allocator.h>
 #include <grpcpp/support/status.h>
 
 namespace grpc {
@@ -78,6 +80,35 @@ class MethodHandler {
     GPR_CODEGEN_ASSERT(req == nullptr);
     return nullptr;
   }
+
+  /// Whether requests and responses of this method should be allocated on a
+  /// per-call message arena (see MessageArena). Set by the server before it
+  /// starts, for methods enabled through ServerBuilder.
+  bool use_message_arena() const { return use_message_arena_; }
+  void set_use_message_arena(bool use) { use_message_arena_ = use; }
+
+  /// Reuse the requests and responses of this method through a
+  /// PooledMessageAllocator of the given capacity, unless the application
+  /// set its own MessageAllocator. Called by the server before it starts, for
+  /// all methods when enabled through ServerBuilder. Handlers that do not
+  /// support a message allocator, or whose message types cannot be pooled,
+  /// ignore it.
+  virtual void EnableMessagePool(size_t /*capacity*/) {}
+
+ protected:
+  /// Returns the messages for a call placed in its call arena, or nullptr if
+  /// the method does not use a message arena or the message types do not
+  /// support one. The caller must Release() the returned holder.
+  template <class RequestType, class ResponseType>
+  MessageHolder<RequestType, ResponseType>* MaybeAllocateArenaMessages(
+      grpc_call* call) const {
+    using ArenaT = MessageArena<RequestType, ResponseType>;
+    if (ArenaT::kSize == 0 || !use_message_arena_) return nullptr;
+    return ArenaT::AllocateMessages(grpc_call_arena_alloc(call, ArenaT::kSize));
+  }
+
+ private:
+  bool use_message_arena_ = false;
 };
 
 /// Server side rpc method class
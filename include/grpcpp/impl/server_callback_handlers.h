@@ -18,10 +18,14 @@
 #ifndef GRPCPP_IMPL_SERVER_CALLBACK_HANDLERS_H
 #define GRPCPP_IMPL_SERVER_CALLBACK_HANDLERS_H
 
+#include <memory>
+#include <type_traits>
+
 #include <grpc/grpc.h>
 #include <grpcpp/impl/rpc_service_method.h>
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/message_allocator.h>
+#include <grpcpp/support/pooled_message_allocator.h>
 #include <grpcpp/support/server_callback.h>
 #include <grpcpp/support/status.h>
 
@@ -42,6 +46,14 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
     allocator_ = allocator;
   }
 
+  void EnableMessagePool(size_t capacity) override {
+    EnableMessagePool(
+        capacity,
+        std::integral_constant<
+            bool, grpc::internal::IsPoolableMessage<RequestType>::value &&
+                      grpc::internal::IsPoolableMessage<ResponseType>::value>());
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a controller structure (that includes request/response)
     grpc_call_ref(param.call->call());
@@ -86,9 +98,13 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
     if (allocator_ != nullptr) {
       allocator_state = allocator_->AllocateMessages();
     } else {
-      allocator_state = new (grpc_call_arena_alloc(
-          call, sizeof(DefaultMessageHolder<RequestType, ResponseType>)))
-          DefaultMessageHolder<RequestType, ResponseType>();
+      allocator_state =
+          MaybeAllocateArenaMessages<RequestType, ResponseType>(call);
+      if (allocator_state == nullptr) {
+        allocator_state = new (grpc_call_arena_alloc(
+            call, sizeof(DefaultMessageHolder<RequestType, ResponseType>)))
+            DefaultMessageHolder<RequestType, ResponseType>();
+      }
     }
     *handler_data = allocator_state;
     request = allocator_state->request();
@@ -106,6 +122,18 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
                                     const RequestType*, ResponseType*)>
       get_reactor_;
   MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
+  std::unique_ptr<
+      grpc::experimental::PooledMessageAllocator<RequestType, ResponseType>>
+      message_pool_;
+
+  void EnableMessagePool(size_t capacity, std::true_type /*poolable*/) {
+    if (allocator_ != nullptr) return;
+    message_pool_ = std::make_unique<
+        grpc::experimental::PooledMessageAllocator<RequestType, ResponseType>>(
+        capacity);
+    allocator_ = message_pool_.get();
+  }
+  void EnableMessagePool(size_t /*capacity*/, std::false_type /*poolable*/) {}
 
   class ServerCallbackUnaryImpl : public ServerCallbackUnary {
    public:
@@ -814,7 +842,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
       write_tag_.Set(
           call_.call(),
           [this, reactor](bool ok) {
-            reactor->OnWriteDone(ok);
+            this->NotifyWriteDone(reactor, ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
           &write_ops_, /*can_inline=*/false);
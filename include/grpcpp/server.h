@@ -22,7 +22,10 @@
 #include <grpc/impl/codegen/port_platform.h>
 
 #include <list>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -231,6 +234,11 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
   /// interface)
   class SyncRequestThreadManager;
 
+  /// SyncServerExecutor runs the handlers of sync RPCs on a thread pool instead
+  /// of on the \a SyncRequestThreadManager threads, when enabled with
+  /// ServerBuilder::experimental().EnableSyncServerExecutor()
+  class SyncServerExecutor;
+
   /// Register a generic service. This call does not take ownership of the
   /// service. The service must exist for the lifetime of the Server instance.
   void RegisterAsyncGenericService(AsyncGenericService* service) override;
@@ -245,6 +253,17 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
     context_allocator_ = std::move(context_allocator);
   }
 
+  void SetProtobufArenaNames(std::set<std::string> names) {
+    protobuf_arena_names_ = std::move(names);
+  }
+
+  void SetMessagePoolCapacity(size_t capacity) {
+    message_pool_capacity_ = capacity;
+  }
+
+  void SetSyncServerExecutor(int max_concurrent_rpcs, int max_queued_rpcs,
+                             std::map<std::string, int> method_max_concurrency);
+
   void PerformOpsOnCall(internal::CallOpSetInterface* ops,
                         internal::Call* call) override;
 
@@ -289,6 +308,10 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
   /// the \a sync_server_cqs)
   std::vector<std::unique_ptr<SyncRequestThreadManager>> sync_req_mgrs_;
 
+  /// Runs the sync RPC handlers if set; otherwise they run on the threads of
+  /// \a sync_req_mgrs_
+  std::unique_ptr<SyncServerExecutor> sync_server_executor_;
+
   // Server status
   internal::Mutex mu_;
   bool started_;
@@ -315,6 +338,13 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
 
   std::unique_ptr<ContextAllocator> context_allocator_;
 
+  // Services and methods whose messages are allocated on a message arena.
+  std::set<std::string> protobuf_arena_names_;
+
+  // Capacity of the message pools of callback unary methods, or 0 if they do
+  // not pool their messages.
+  size_t message_pool_capacity_ = 0;
+
   std::unique_ptr<HealthCheckServiceInterface> health_check_service_;
   bool health_check_service_disabled_;
 
@@ -24,6 +24,8 @@
 #include <climits>
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -283,6 +285,51 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Allocate the request and response messages of the service or method
+    /// \a name (either "package.Service" or "/package.Service/Method") on a
+    /// protobuf arena placed in the call's memory, so that parsing a large
+    /// nested request does not do a heap allocation for every submessage.
+    /// Applies to unary and server-streaming requests and to unary and
+    /// client-streaming responses of sync methods, and to callback unary
+    /// methods without a custom MessageAllocator. The messages must not be
+    /// used after the handler (or, for callback methods, OnDone) returns.
+    void EnableProtobufArena(const std::string& name) {
+      builder_->protobuf_arena_names_.insert(name);
+    }
+
+    /// Reuse the request and response messages of callback unary methods
+    /// across RPCs instead of allocating them for every call, through a
+    /// PooledMessageAllocator per method that keeps up to \a capacity
+    /// Clear()ed messages per shard. Methods with a custom MessageAllocator
+    /// or with EnableProtobufArena keep using those.
+    void EnablePooledMessageAllocator(size_t capacity = 64) {
+      builder_->message_pool_capacity_ = capacity;
+    }
+
+    /// Run the handlers of sync methods on a thread pool shared by all the
+    /// sync server completion queues, instead of on the threads polling those
+    /// queues, so that a slow handler does not make the server start more
+    /// polling threads. At most \a max_concurrent_rpcs handlers run at once.
+    /// Further RPCs wait for a free slot, and once \a max_queued_rpcs RPCs are
+    /// waiting (no limit if negative), new ones fail with RESOURCE_EXHAUSTED.
+    void EnableSyncServerExecutor(int max_concurrent_rpcs,
+                                  int max_queued_rpcs) {
+      builder_->sync_server_settings_.use_executor = true;
+      builder_->sync_server_settings_.max_concurrent_rpcs = max_concurrent_rpcs;
+      builder_->sync_server_settings_.max_queued_rpcs = max_queued_rpcs;
+    }
+
+    /// Allow at most \a max_concurrent_rpcs handlers of the service or method
+    /// \a name (either "package.Service" or "/package.Service/Method") to run
+    /// at once on the sync server executor. A method limit takes precedence
+    /// over the limit of its service. Has no effect unless
+    /// EnableSyncServerExecutor() is also called.
+    void SetSyncMethodMaxConcurrency(const std::string& name,
+                                     int max_concurrent_rpcs) {
+      builder_->sync_server_settings_.method_max_concurrency[name] =
+          max_concurrent_rpcs;
+    }
+
    private:
     ServerBuilder* builder_;
   };
@@ -374,6 +421,18 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Whether sync handlers run on the sync server executor.
+    bool use_executor = false;
+
+    /// Maximum number of sync handlers running at once on the executor.
+    int max_concurrent_rpcs = INT_MAX;
+
+    /// Maximum number of RPCs waiting for the executor, or -1 for no limit.
+    int max_queued_rpcs = -1;
+
+    /// Per service or method limits on the number of running handlers.
+    std::map<std::string, int> method_max_concurrency;
   };
 
   int max_receive_message_size_;
@@ -392,6 +451,8 @@ class ServerBuilder {
   grpc_resource_quota* resource_quota_;
   grpc::AsyncGenericService* generic_service_{nullptr};
   std::unique_ptr<ContextAllocator> context_allocator_;
+  std::set<std::string> protobuf_arena_names_;
+  size_t message_pool_capacity_ = 0;
   grpc::CallbackGenericService* callback_generic_service_{nullptr};
 
   struct {
@@ -43,6 +43,8 @@ template <class RequestType, class ResponseType>
 class CallbackServerStreamingHandler;
 template <class RequestType>
 void* UnaryDeserializeHelper(grpc_byte_buffer*, grpc::Status*, RequestType*);
+template <class RequestType>
+void* ArenaDeserializeHelper(grpc_byte_buffer*, grpc::Status*, RequestType*);
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
 template <grpc::StatusCode code>
@@ -55,6 +57,7 @@ class ExternalConnectionAcceptorImpl;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
+class ContiguousProtoParser;
 
 }  // namespace internal
 /// A sequence of bytes.
@@ -169,6 +172,9 @@ class ByteBuffer final {
   template <class RequestType>
   friend void* internal::UnaryDeserializeHelper(grpc_byte_buffer*,
                                                 grpc::Status*, RequestType*);
+  template <class RequestType>
+  friend void* internal::ArenaDeserializeHelper(grpc_byte_buffer*,
+                                                grpc::Status*, RequestType*);
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ServerStreamingHandler;
   template <class RequestType, class ResponseType>
@@ -182,6 +188,7 @@ class ByteBuffer final {
   friend class ProtoBufferReader;
   friend class ProtoBufferWriter;
   friend class internal::GrpcByteBufferPeer;
+  friend class internal::ContiguousProtoParser;
   friend class internal::ExternalConnectionAcceptorImpl;
 
   grpc_byte_buffer* buffer_;
@@ -19,14 +19,17 @@
 #ifndef GRPCPP_SUPPORT_CALLBACK_COMMON_H
 #define GRPCPP_SUPPORT_CALLBACK_COMMON_H
 
+#include <deque>
 #include <functional>
 
 #include <grpc/grpc.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpcpp/impl/call.h>
+#include <grpcpp/impl/call_op_set.h>
 #include <grpcpp/impl/codegen/channel_interface.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/completion_queue_tag.h>
+#include <grpcpp/impl/sync.h>
 #include <grpcpp/support/config.h>
 #include <grpcpp/support/status.h>
 
@@ -215,6 +218,132 @@ class CallbackWithSuccessTag : public grpc_completion_queue_functor {
   }
 };
 
+// The size that a queued message counts for against the byte bound of a
+// CallbackWriteQueue: its serialized size, where the message type can tell it
+// without being serialized (as protobuf messages can), or else 0.
+template <class M>
+auto CallbackWriteQueueBytes(const M& msg, int)
+    -> decltype(static_cast<size_t>(msg.ByteSizeLong())) {
+  return static_cast<size_t>(msg.ByteSizeLong());
+}
+template <class M>
+size_t CallbackWriteQueueBytes(const M& /*msg*/, long) {
+  return 0;
+}
+
+/// The write queue of a callback streaming reactor (see
+/// ClientBidiReactor::EnableWriteQueue). Messages are copied as they are
+/// queued, so the application may reuse them right away. The reactor hands
+/// them to its stream one at a time, starting each from the completion of the
+/// previous one instead of from a reaction. A message that has more queued
+/// behind it is written with a buffer hint, so the transport gathers the
+/// queued messages and sends them together with the last one.
+template <class Message>
+class CallbackWriteQueue {
+ public:
+  CallbackWriteQueue(size_t max_messages, size_t max_bytes,
+                     size_t low_water_bytes)
+      : max_messages_(max_messages > 0 ? max_messages : 1),
+        max_bytes_(max_bytes),
+        low_water_bytes_(low_water_bytes) {}
+
+  CallbackWriteQueue(const CallbackWriteQueue&) = delete;
+  CallbackWriteQueue& operator=(const CallbackWriteQueue&) = delete;
+
+  /// Queue a copy of \a msg, unless the queue is full or a queued write has
+  /// failed. If no queued write was in flight, \a *start is set to the message
+  /// that the caller must now write with \a *start_options, else to nullptr.
+  bool Push(const Message& msg, grpc::WriteOptions options,
+            const Message** start, grpc::WriteOptions* start_options) {
+    *start = nullptr;
+    grpc::internal::MutexLock lock(&mu_);
+    if (failed_ || queue_.size() >= max_messages_ || bytes_ >= max_bytes_) {
+      blocked_ = true;
+      return false;
+    }
+    const size_t bytes = CallbackWriteQueueBytes(msg, 0);
+    queue_.push_back(Entry{msg, options, bytes});
+    bytes_ += bytes;
+    if (!write_in_flight_) {
+      write_in_flight_ = true;
+      *start = StartLocked(start_options);
+    }
+    return true;
+  }
+
+  /// Called on the completion of the queued write in flight. Returns the next
+  /// message that the caller must write with \a *options, if any. Sets
+  /// \a notify_low if the reactor has to be told that the queue has room
+  /// again (or that it failed, if not \a ok), and sets \a on_drained to
+  /// anything deferred by RunWhenDrained once there is nothing left to send.
+  const Message* WriteDone(bool ok, grpc::WriteOptions* options,
+                           bool* notify_low,
+                           std::function<void()>* on_drained) {
+    grpc::internal::MutexLock lock(&mu_);
+    bytes_ -= queue_.front().bytes;
+    queue_.pop_front();
+    if (!ok && !failed_) {
+      // Nothing more can be written on this stream.
+      failed_ = true;
+      blocked_ = true;
+      queue_.clear();
+      bytes_ = 0;
+    }
+    *notify_low = blocked_ && (failed_ || (bytes_ <= low_water_bytes_ &&
+                                           queue_.size() < max_messages_));
+    if (*notify_low) blocked_ = false;
+    if (!queue_.empty()) return StartLocked(options);
+    write_in_flight_ = false;
+    *on_drained = std::move(on_drained_);
+    on_drained_ = nullptr;
+    return nullptr;
+  }
+
+  /// Run \a f now if no queued write is in flight, or else once the queue
+  /// has drained. Used to defer the operations that must follow the last
+  /// queued write, like WritesDone or Finish.
+  void RunWhenDrained(std::function<void()> f) {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (write_in_flight_) {
+        on_drained_ = std::move(f);
+        return;
+      }
+    }
+    f();
+  }
+
+ private:
+  struct Entry {
+    Message message;
+    grpc::WriteOptions options;
+    size_t bytes;
+  };
+
+  // The message at the front of the queue is the one in flight. It stays
+  // queued, and so alive, until its write completes.
+  const Message* StartLocked(grpc::WriteOptions* options)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    Entry& entry = queue_.front();
+    *options = entry.options;
+    if (queue_.size() > 1) options->set_buffer_hint();
+    return &entry.message;
+  }
+
+  const size_t max_messages_;
+  const size_t max_bytes_;
+  const size_t low_water_bytes_;
+  grpc::internal::Mutex mu_;
+  // Includes the message in flight.
+  std::deque<Entry> queue_ ABSL_GUARDED_BY(mu_);
+  size_t bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  bool write_in_flight_ ABSL_GUARDED_BY(mu_) = false;
+  // A Push was refused since the last notification.
+  bool blocked_ ABSL_GUARDED_BY(mu_) = false;
+  bool failed_ ABSL_GUARDED_BY(mu_) = false;
+  std::function<void()> on_drained_ ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace internal
 }  // namespace grpc
 
@@ -171,6 +171,10 @@ class ClientCallbackReaderWriter {
   void BindReactor(ClientBidiReactor<Request, Response>* reactor) {
     reactor->BindStream(this);
   }
+  void NotifyWriteDone(ClientBidiReactor<Request, Response>* reactor,
+                       bool ok) {
+    reactor->InternalWriteDone(ok);
+  }
 };
 
 template <class Response>
@@ -285,8 +289,57 @@ class ClientBidiReactor : public internal::ClientReactor {
   /// issued once for a given RPC. This is not required or allowed if
   /// StartWriteLast is used since that already has the same implication.
   /// Note that calling this means that no more calls to StartWrite,
-  /// StartWriteLast, or StartWritesDone are allowed.
-  void StartWritesDone() { stream_->WritesDone(); }
+  /// StartWriteLast, or StartWritesDone are allowed. With a write queue, the
+  /// writes-done is sent after the last queued message.
+  void StartWritesDone() {
+    if (write_queue_ != nullptr) {
+      write_queue_->RunWhenDrained([this] { stream_->WritesDone(); });
+    } else {
+      stream_->WritesDone();
+    }
+  }
+
+  /// EXPERIMENTAL: Switch this RPC to write-queue mode, where the application
+  /// queues messages with StartQueuedWrite instead of waiting for OnWriteDone
+  /// after each StartWrite. Must be called before the first write; StartWrite
+  /// and StartWriteLast may not be used once it is.
+  ///
+  /// \param[in] max_messages How many messages may be queued, including the
+  ///                         one being sent
+  /// \param[in] max_bytes Once this many serialized bytes are queued, further
+  ///                      messages are refused
+  /// \param[in] low_water_bytes After a message has been refused,
+  ///                            OnWriteQueueLow is called once the queue is
+  ///                            back to this many bytes or fewer
+  void EnableWriteQueue(size_t max_messages, size_t max_bytes,
+                        size_t low_water_bytes) {
+    write_queue_.reset(new internal::CallbackWriteQueue<Request>(
+        max_messages, max_bytes, low_water_bytes));
+  }
+
+  /// Queue a message for writing (see EnableWriteQueue). The message is
+  /// copied, so the application may reuse or delete it as soon as this
+  /// returns. There is no OnWriteDone reaction for queued messages.
+  ///
+  /// \param[in] req The message to be written
+  /// \param[in] options The WriteOptions to use for writing this message. Set
+  ///                    last_message on the final message to also half-close
+  ///                    the stream.
+  /// \return false, without queuing the message, if the queue is full or a
+  ///         queued write has failed. OnWriteQueueLow is called when the
+  ///         application may queue messages again.
+  bool StartQueuedWrite(const Request* req) {
+    return StartQueuedWrite(req, grpc::WriteOptions());
+  }
+  bool StartQueuedWrite(const Request* req, grpc::WriteOptions options) {
+    const Request* start;
+    grpc::WriteOptions start_options;
+    if (!write_queue_->Push(*req, options, &start, &start_options)) {
+      return false;
+    }
+    if (start != nullptr) StartWrite(start, std::move(start_options));
+    return true;
+  }
 
   /// Holds are needed if (and only if) this stream has operations that take
   /// place on it after StartCall but from outside one of the reactions
@@ -358,12 +411,35 @@ class ClientBidiReactor : public internal::ClientReactor {
   ///               further Start* should be called.
   virtual void OnWritesDoneDone(bool /*ok*/) {}
 
+  /// Notifies the application that the write queue has drained to its
+  /// low-water mark after StartQueuedWrite refused a message, or that a
+  /// queued write failed.
+  ///
+  /// \param[in] ok Was it successful? If false, the remaining queued messages
+  ///               were dropped and no new write operation will succeed.
+  virtual void OnWriteQueueLow(bool /*ok*/) {}
+
  private:
   friend class ClientCallbackReaderWriter<Request, Response>;
   void BindStream(ClientCallbackReaderWriter<Request, Response>* stream) {
     stream_ = stream;
   }
+  void InternalWriteDone(bool ok) {
+    if (write_queue_ == nullptr) {
+      OnWriteDone(ok);
+      return;
+    }
+    grpc::WriteOptions options;
+    bool notify_low;
+    std::function<void()> on_drained;
+    const Request* next =
+        write_queue_->WriteDone(ok, &options, &notify_low, &on_drained);
+    if (next != nullptr) StartWrite(next, std::move(options));
+    if (notify_low) OnWriteQueueLow(ok);
+    if (on_drained) on_drained();
+  }
   ClientCallbackReaderWriter<Request, Response>* stream_;
+  std::unique_ptr<internal::CallbackWriteQueue<Request>> write_queue_;
 };
 
 /// \a ClientReadReactor is the interface for a server-streaming RPC.
@@ -611,7 +687,7 @@ class ClientCallbackReaderWriterImpl
     write_tag_.Set(
         call_.call(),
         [this](bool ok) {
-          reactor_->OnWriteDone(ok);
+          this->NotifyWriteDone(reactor_, ok);
           MaybeFinish(/*from_reaction=*/true);
         },
         &write_ops_, /*can_inline=*/false);
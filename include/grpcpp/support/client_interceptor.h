@@ -139,6 +139,14 @@ class ClientRpcInfo {
     interceptors_[pos]->Intercept(interceptor_methods);
   }
 
+  // Adds \a interceptor, if not null, to the end of the list.
+  void AddInterceptor(experimental::Interceptor* interceptor) {
+    if (interceptor == nullptr) return;
+    interceptors_.push_back(
+        std::unique_ptr<experimental::Interceptor>(interceptor));
+    interceptor_hooks_.push_back(interceptor->InterceptionHookPointsMask());
+  }
+
   void RegisterInterceptors(
       const std::vector<std::unique_ptr<
           experimental::ClientInterceptorFactoryInterface>>& creators,
@@ -151,16 +159,11 @@ class ClientRpcInfo {
     //       iterate over a portion of the creators vector.
     for (auto it = creators.begin() + interceptor_pos; it != creators.end();
          ++it) {
-      auto* interceptor = (*it)->CreateClientInterceptor(this);
-      if (interceptor != nullptr) {
-        interceptors_.push_back(
-            std::unique_ptr<experimental::Interceptor>(interceptor));
-      }
+      AddInterceptor((*it)->CreateClientInterceptor(this));
     }
     if (internal::g_global_client_interceptor_factory != nullptr) {
-      interceptors_.push_back(std::unique_ptr<experimental::Interceptor>(
-          internal::g_global_client_interceptor_factory
-              ->CreateClientInterceptor(this)));
+      AddInterceptor(internal::g_global_client_interceptor_factory
+                         ->CreateClientInterceptor(this));
     }
   }
 
@@ -171,6 +174,8 @@ class ClientRpcInfo {
   const char* suffix_for_stats_ = nullptr;
   grpc::ChannelInterface* channel_ = nullptr;
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The InterceptionHookPointsMask of each interceptor
+  std::vector<uint32_t> interceptor_hooks_;
   bool hijacked_ = false;
   size_t hijacked_interceptor_ = 0;
 
@@ -19,6 +19,8 @@
 #ifndef GRPCPP_SUPPORT_INTERCEPTOR_H
 #define GRPCPP_SUPPORT_INTERCEPTOR_H
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -75,12 +77,23 @@ enum class InterceptionHookPoints {
   /// TryCancel() is performed.
   ///  - No other hook points will be present along with this.
   ///  - It is illegal for an interceptor to block/delay this operation.
-  ///  - ALL interceptors see this hook point irrespective of whether the
-  ///    RPC was hijacked or not.
+  ///  - ALL interceptors that act on this hook point see it irrespective of
+  ///    whether the RPC was hijacked or not.
   PRE_SEND_CANCEL,
   NUM_INTERCEPTION_HOOKS
 };
 
+/// Returns the bit for \a point in a mask of hook points, as returned by
+/// Interceptor::InterceptionHookPointsMask.
+constexpr uint32_t InterceptionHookPointBit(InterceptionHookPoints point) {
+  return uint32_t{1} << static_cast<uint32_t>(point);
+}
+
+/// A mask with every hook point set.
+constexpr uint32_t kAllInterceptionHookPoints =
+    InterceptionHookPointBit(InterceptionHookPoints::NUM_INTERCEPTION_HOOKS) -
+    1;
+
 /// Class that is passed as an argument to the \a Intercept method
 /// of the application's \a Interceptor interface implementation. It has five
 /// purposes:
@@ -223,6 +236,17 @@ class Interceptor {
   /// The one public method of an Interceptor interface. Override this to
   /// trigger the desired actions at the hook points described above.
   virtual void Intercept(InterceptorBatchMethods* methods) = 0;
+
+  /// Override this to declare the hook points this interceptor acts on, as a
+  /// mask of InterceptionHookPointBit values. It is queried once, when the
+  /// interceptor is created. \a Intercept is only called for batches that
+  /// contain at least one of these hook points, and batches that no
+  /// interceptor of the RPC acts on bypass the interceptors entirely. A
+  /// hijacking interceptor must include PRE_SEND_INITIAL_METADATA; once an
+  /// RPC is hijacked, batches on their way down are no longer filtered.
+  virtual uint32_t InterceptionHookPointsMask() const {
+    return kAllInterceptionHookPoints;
+  }
 };
 
 }  // namespace experimental
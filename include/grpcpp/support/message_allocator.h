@@ -19,6 +19,8 @@
 #ifndef GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
 #define GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
 
+#include <stddef.h>
+
 namespace grpc {
 
 // NOTE: This is an API for advanced users who need custom allocators.
@@ -66,6 +68,28 @@ class MessageAllocator {
   virtual MessageHolder<RequestT, ResponseT>* AllocateMessages() = 0;
 };
 
+namespace internal {
+
+// Built-in allocation of a request/response pair on a message arena that is
+// itself placed in the call arena, used for methods that opted in through
+// ServerBuilder::experimental().EnableProtobufArena(). Serialization
+// libraries that support arenas specialize this; the default has size 0,
+// which disables the feature for the message types.
+template <typename RequestT, typename ResponseT, typename Enable = void>
+class MessageArena {
+ public:
+  // Number of bytes of call arena memory needed by AllocateMessages.
+  static constexpr size_t kSize = 0;
+  // Constructs the holder in \a memory (of kSize bytes). The holder's
+  // Release() destroys it in place without freeing \a memory.
+  static MessageHolder<RequestT, ResponseT>* AllocateMessages(
+      void* /*memory*/) {
+    return nullptr;
+  }
+};
+
+}  // namespace internal
+
 }  // namespace grpc
 
 #endif  // GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
@@ -92,6 +92,19 @@ void* UnaryDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
   return nullptr;
 }
 
+/// Like UnaryDeserializeHelper, but for a request owned by a message arena,
+/// which is freed with the arena rather than destroyed here on failure.
+
+template <class RequestType>
+void* ArenaDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
+                             RequestType* request) {
+  grpc::ByteBuffer buf;
+  buf.set_buffer(req);
+  *status = grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+  buf.Release();
+  return status->ok() ? request : nullptr;
+}
+
 /// A wrapper class of an application provided rpc method handler.
 template <class ServiceType, class RequestType, class ResponseType,
           class BaseRequestType = RequestType,
@@ -106,21 +119,29 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
       : func_(func), service_(service) {}
 
   void RunHandler(const HandlerParameter& param) final {
-    ResponseType rsp;
-    grpc::Status status = param.status;
-    if (status.ok()) {
-      status = CatchingFunctionHandler([this, &param, &rsp] {
-        return func_(service_,
-                     static_cast<grpc::ServerContext*>(param.server_context),
-                     static_cast<RequestType*>(param.request), &rsp);
-      });
-      static_cast<RequestType*>(param.request)->~RequestType();
+    auto* messages = static_cast<MessageHolder<RequestType, ResponseType>*>(
+        param.internal_data);
+    if (messages != nullptr) {
+      // The request and response live on the call's message arena.
+      RunHandlerWithResponse(param, messages->response());
+      messages->Release();
+      return;
     }
-    UnaryRunHandlerHelper(param, static_cast<BaseResponseType*>(&rsp), status);
+    ResponseType rsp;
+    RunHandlerWithResponse(param, &rsp);
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
+    if (handler_data != nullptr) {
+      auto* messages =
+          MaybeAllocateArenaMessages<RequestType, ResponseType>(call);
+      if (messages != nullptr) {
+        *handler_data = messages;
+        return ArenaDeserializeHelper(
+            req, status, static_cast<BaseRequestType*>(messages->request()));
+      }
+    }
     auto* request =
         new (grpc_call_arena_alloc(call, sizeof(RequestType))) RequestType;
     return UnaryDeserializeHelper(req, status,
@@ -128,6 +149,22 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
   }
 
  private:
+  void RunHandlerWithResponse(const HandlerParameter& param,
+                              ResponseType* rsp) {
+    grpc::Status status = param.status;
+    if (status.ok()) {
+      status = CatchingFunctionHandler([this, &param, rsp] {
+        return func_(service_,
+                     static_cast<grpc::ServerContext*>(param.server_context),
+                     static_cast<RequestType*>(param.request), rsp);
+      });
+      if (param.internal_data == nullptr) {
+        static_cast<RequestType*>(param.request)->~RequestType();
+      }
+    }
+    UnaryRunHandlerHelper(param, static_cast<BaseResponseType*>(rsp), status);
+  }
+
   /// Application provided rpc handler function.
   std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
                              const RequestType*, ResponseType*)>
@@ -150,12 +187,16 @@ class ClientStreamingHandler : public grpc::internal::MethodHandler {
   void RunHandler(const HandlerParameter& param) final {
     ServerReader<RequestType> reader(
         param.call, static_cast<grpc::ServerContext*>(param.server_context));
-    ResponseType rsp;
+    auto* messages = MaybeAllocateArenaMessages<RequestType, ResponseType>(
+        param.call->call());
+    ResponseType local_rsp;
+    ResponseType* rsp =
+        messages != nullptr ? messages->response() : &local_rsp;
     grpc::Status status =
-        CatchingFunctionHandler([this, &param, &reader, &rsp] {
+        CatchingFunctionHandler([this, &param, &reader, rsp] {
           return func_(service_,
                        static_cast<grpc::ServerContext*>(param.server_context),
-                       &reader, &rsp);
+                       &reader, rsp);
         });
 
     grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
@@ -170,11 +211,12 @@ class ClientStreamingHandler : public grpc::internal::MethodHandler {
       }
     }
     if (status.ok()) {
-      status = ops.SendMessagePtr(&rsp);
+      status = ops.SendMessagePtr(rsp);
     }
     ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
     param.call->PerformOps(&ops);
     param.call->cq()->Pluck(&ops);
+    if (messages != nullptr) messages->Release();
   }
 
  private:
@@ -205,7 +247,9 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
                      static_cast<grpc::ServerContext*>(param.server_context),
                      static_cast<RequestType*>(param.request), &writer);
       });
-      static_cast<RequestType*>(param.request)->~RequestType();
+      if (param.internal_data == nullptr) {
+        static_cast<RequestType*>(param.request)->~RequestType();
+      }
     }
 
     grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
@@ -224,10 +268,23 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
       param.call->cq()->Pluck(&param.server_context->pending_ops_);
     }
     param.call->cq()->Pluck(&ops);
+    if (param.internal_data != nullptr) {
+      static_cast<MessageHolder<RequestType, ResponseType>*>(
+          param.internal_data)
+          ->Release();
+    }
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
+    if (handler_data != nullptr) {
+      auto* messages =
+          MaybeAllocateArenaMessages<RequestType, ResponseType>(call);
+      if (messages != nullptr) {
+        *handler_data = messages;
+        return ArenaDeserializeHelper(req, status, messages->request());
+      }
+    }
     grpc::ByteBuffer buf;
     buf.set_buffer(req);
     auto* request =
@@ -0,0 +1,143 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_POOLED_MESSAGE_ALLOCATOR_H
+#define GRPCPP_SUPPORT_POOLED_MESSAGE_ALLOCATOR_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <grpcpp/impl/sync.h>
+#include <grpcpp/support/message_allocator.h>
+
+namespace grpc {
+namespace experimental {
+
+/// A MessageAllocator that reuses request/response pairs instead of creating
+/// new ones for every RPC. A released pair is Clear()ed, which keeps the
+/// memory of its strings and repeated fields for the next RPC, and is put
+/// back on the free list it was allocated from. The free lists are sharded
+/// by allocating thread, so that threads rarely contend for one; each shard
+/// keeps up to \a capacity pairs, and pairs beyond that are deleted. All the
+/// free pairs are deleted with the allocator.
+///
+/// RequestT and ResponseT must have a Clear() method. The allocator must
+/// outlive every pair it hands out.
+template <typename RequestT, typename ResponseT>
+class PooledMessageAllocator : public MessageAllocator<RequestT, ResponseT> {
+ public:
+  explicit PooledMessageAllocator(size_t capacity) : capacity_(capacity) {}
+
+  ~PooledMessageAllocator() override {
+    for (Shard& shard : shards_) {
+      for (Holder* holder : shard.free_list) delete holder;
+    }
+  }
+
+  MessageHolder<RequestT, ResponseT>* AllocateMessages() override {
+    Shard* shard =
+        &shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                 kNumShards];
+    {
+      grpc::internal::MutexLock lock(&shard->mu);
+      if (!shard->free_list.empty()) {
+        Holder* holder = shard->free_list.back();
+        shard->free_list.pop_back();
+        return holder;
+      }
+    }
+    messages_allocated_.fetch_add(1, std::memory_order_relaxed);
+    return new Holder(this, shard);
+  }
+
+  /// Number of request/response pairs this allocator had to create because
+  /// none could be reused.
+  size_t messages_allocated() const {
+    return messages_allocated_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr size_t kNumShards = 8;
+
+  class Holder;
+  struct Shard {
+    grpc::internal::Mutex mu;
+    std::vector<Holder*> free_list;
+  };
+
+  class Holder : public MessageHolder<RequestT, ResponseT> {
+   public:
+    Holder(PooledMessageAllocator* allocator, Shard* shard)
+        : allocator_(allocator), shard_(shard) {
+      this->set_request(&request_);
+      this->set_response(&response_);
+    }
+
+    void Release() override {
+      request_.Clear();
+      response_.Clear();
+      allocator_->Recycle(this, shard_);
+    }
+
+   private:
+    PooledMessageAllocator* const allocator_;
+    // The shard this pair was allocated from, which it goes back to even when
+    // another thread releases it.
+    Shard* const shard_;
+    RequestT request_;
+    ResponseT response_;
+  };
+
+  void Recycle(Holder* holder, Shard* shard) {
+    {
+      grpc::internal::MutexLock lock(&shard->mu);
+      if (shard->free_list.size() < capacity_) {
+        shard->free_list.push_back(holder);
+        return;
+      }
+    }
+    delete holder;
+  }
+
+  const size_t capacity_;
+  std::atomic<size_t> messages_allocated_{0};
+  Shard shards_[kNumShards];
+};
+
+}  // namespace experimental
+
+namespace internal {
+
+// Whether messages of type T can be pooled, which needs T::Clear().
+template <typename T, typename = void>
+struct IsPoolableMessage : std::false_type {};
+template <typename T>
+struct IsPoolableMessage<T, decltype(std::declval<T&>().Clear(), void())>
+    : std::true_type {};
+
+}  // namespace internal
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_POOLED_MESSAGE_ALLOCATOR_H
@@ -21,6 +21,7 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 #include <grpcpp/impl/call.h>
@@ -251,6 +252,10 @@ class ServerCallbackReaderWriter : public internal::ServerCallbackCall {
   void BindReactor(ServerBidiReactor<Request, Response>* reactor) {
     reactor->InternalBindStream(this);
   }
+  void NotifyWriteDone(ServerBidiReactor<Request, Response>* reactor,
+                       bool ok) {
+    reactor->InternalWriteDone(ok);
+  }
 };
 
 // The following classes are the reactor interfaces that are to be implemented
@@ -385,25 +390,60 @@ class ServerBidiReactor : public internal::ServerReactor {
     StartWrite(resp, options.set_last_message());
   }
 
+  /// EXPERIMENTAL: Switch this RPC to write-queue mode, where the application
+  /// queues messages with StartQueuedWrite instead of waiting for OnWriteDone
+  /// after each StartWrite. Must be called before the first write; StartWrite,
+  /// StartWriteLast and StartWriteAndFinish may not be used once it is.
+  ///
+  /// \param[in] max_messages How many messages may be queued, including the
+  ///                         one being sent
+  /// \param[in] max_bytes Once this many serialized bytes are queued, further
+  ///                      messages are refused
+  /// \param[in] low_water_bytes After a message has been refused,
+  ///                            OnWriteQueueLow is called once the queue is
+  ///                            back to this many bytes or fewer
+  void EnableWriteQueue(size_t max_messages, size_t max_bytes,
+                        size_t low_water_bytes) {
+    write_queue_.reset(new internal::CallbackWriteQueue<Response>(
+        max_messages, max_bytes, low_water_bytes));
+  }
+
+  /// Queue a message for writing (see EnableWriteQueue). The message is
+  /// copied, so the application may reuse or delete it as soon as this
+  /// returns. There is no OnWriteDone reaction for queued messages.
+  ///
+  /// \param[in] resp The message to be written
+  /// \param[in] options The WriteOptions to use for writing this message
+  /// \return false, without queuing the message, if the queue is full or a
+  ///         queued write has failed. OnWriteQueueLow is called when the
+  ///         application may queue messages again.
+  bool StartQueuedWrite(const Response* resp) {
+    return StartQueuedWrite(resp, grpc::WriteOptions());
+  }
+  bool StartQueuedWrite(const Response* resp, grpc::WriteOptions options) {
+    const Response* start;
+    grpc::WriteOptions start_options;
+    if (!write_queue_->Push(*resp, options, &start, &start_options)) {
+      return false;
+    }
+    if (start != nullptr) StartWrite(start, std::move(start_options));
+    return true;
+  }
+
   /// Indicate that the stream is to be finished and the trailing metadata and
   /// RPC status are to be sent. Every RPC MUST be finished using either Finish
   /// or StartWriteAndFinish (but not both), even if the RPC is already
-  /// cancelled.
+  /// cancelled. With a write queue, the status is sent after the last queued
+  /// message.
   ///
   /// \param[in] s The status outcome of this RPC
-  void Finish(grpc::Status s) ABSL_LOCKS_EXCLUDED(stream_mu_) {
-    ServerCallbackReaderWriter<Request, Response>* stream =
-        stream_.load(std::memory_order_acquire);
-    if (stream == nullptr) {
-      grpc::internal::MutexLock l(&stream_mu_);
-      stream = stream_.load(std::memory_order_relaxed);
-      if (stream == nullptr) {
-        backlog_.finish_wanted = true;
-        backlog_.status_wanted = std::move(s);
-        return;
-      }
+  void Finish(grpc::Status s) {
+    if (write_queue_ != nullptr) {
+      write_queue_->RunWhenDrained(
+          [this, s]() mutable { FinishStream(std::move(s)); });
+    } else {
+      FinishStream(std::move(s));
     }
-    stream->Finish(std::move(s));
   }
 
   /// Notifies the application that an explicit StartSendInitialMetadata
@@ -427,6 +467,15 @@ class ServerBidiReactor : public internal::ServerReactor {
   ///               will succeed.
   virtual void OnWriteDone(bool /*ok*/) {}
 
+  /// Notifies the application that the write queue has drained to its
+  /// low-water mark after StartQueuedWrite refused a message, or that a
+  /// queued write failed.
+  ///
+  /// \param[in] ok Was it successful? If false, the remaining queued messages
+  ///               were dropped and no further write-side operation will
+  ///               succeed.
+  virtual void OnWriteQueueLow(bool /*ok*/) {}
+
   /// Notifies the application that all operations associated with this RPC
   /// have completed. This is an override (from the internal base class) but
   /// still abstract, so derived classes MUST override it to be instantiated.
@@ -468,6 +517,36 @@ class ServerBidiReactor : public internal::ServerReactor {
     stream_.store(stream, std::memory_order_release);
   }
 
+  void InternalWriteDone(bool ok) {
+    if (write_queue_ == nullptr) {
+      OnWriteDone(ok);
+      return;
+    }
+    grpc::WriteOptions options;
+    bool notify_low;
+    std::function<void()> on_drained;
+    const Response* next =
+        write_queue_->WriteDone(ok, &options, &notify_low, &on_drained);
+    if (next != nullptr) StartWrite(next, std::move(options));
+    if (notify_low) OnWriteQueueLow(ok);
+    if (on_drained) on_drained();
+  }
+
+  void FinishStream(grpc::Status s) ABSL_LOCKS_EXCLUDED(stream_mu_) {
+    ServerCallbackReaderWriter<Request, Response>* stream =
+        stream_.load(std::memory_order_acquire);
+    if (stream == nullptr) {
+      grpc::internal::MutexLock l(&stream_mu_);
+      stream = stream_.load(std::memory_order_relaxed);
+      if (stream == nullptr) {
+        backlog_.finish_wanted = true;
+        backlog_.status_wanted = std::move(s);
+        return;
+      }
+    }
+    stream->Finish(std::move(s));
+  }
+
   grpc::internal::Mutex stream_mu_;
   // TODO(vjpai): Make stream_or_backlog_ into a std::variant or absl::variant
   //              once C++17 or ABSL is supported since stream and backlog are
@@ -484,6 +563,7 @@ class ServerBidiReactor : public internal::ServerReactor {
     grpc::Status status_wanted;
   };
   PreBindBacklog backlog_ ABSL_GUARDED_BY(stream_mu_);
+  std::unique_ptr<internal::CallbackWriteQueue<Response>> write_queue_;
 };
 
 /// \a ServerReadReactor is the interface for a client-streaming RPC.
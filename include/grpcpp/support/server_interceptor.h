@@ -103,16 +103,20 @@ class ServerRpcInfo {
     interceptors_[pos]->Intercept(interceptor_methods);
   }
 
+  // Adds \a interceptor, if not null, to the end of the list.
+  void AddInterceptor(experimental::Interceptor* interceptor) {
+    if (interceptor == nullptr) return;
+    interceptors_.push_back(
+        std::unique_ptr<experimental::Interceptor>(interceptor));
+    interceptor_hooks_.push_back(interceptor->InterceptionHookPointsMask());
+  }
+
   void RegisterInterceptors(
       const std::vector<
           std::unique_ptr<experimental::ServerInterceptorFactoryInterface>>&
           creators) {
     for (const auto& creator : creators) {
-      auto* interceptor = creator->CreateServerInterceptor(this);
-      if (interceptor != nullptr) {
-        interceptors_.push_back(
-            std::unique_ptr<experimental::Interceptor>(interceptor));
-      }
+      AddInterceptor(creator->CreateServerInterceptor(this));
     }
   }
 
@@ -128,6 +132,8 @@ class ServerRpcInfo {
   const Type type_;
   std::atomic<intptr_t> ref_{1};
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The InterceptionHookPointsMask of each interceptor
+  std::vector<uint32_t> interceptor_hooks_;
 
   friend class internal::InterceptorBatchMethodsImpl;
   friend class grpc::ServerContextBase;
@@ -339,6 +339,7 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    XdsRouting::RouteIndex route_index_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -512,6 +513,7 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       if (!status->ok()) return;
     }
   }
+  route_index_ = XdsRouting::RouteIndex(RouteListIterator(&route_table_));
   // Populate filter list.
   const auto& http_filter_registry =
       static_cast<const GrpcXdsBootstrap&>(resolver_->xds_client_->bootstrap())
@@ -656,7 +658,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 absl::StatusOr<ConfigSelector::CallConfig>
 XdsResolver::XdsConfigSelector::GetCallConfig(GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = route_index_.GetRouteForRequest(
       RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
       args.initial_metadata);
   if (!route_index.has_value()) {
@@ -18,20 +18,30 @@
 
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
 #include <new>
+#include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/types/optional.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/status.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -39,8 +49,175 @@
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_deadline_timer_granularity_ms, 1,
+    "Declares the granularity in ms of call deadlines. The deadline timers of "
+    "calls whose deadlines round up to the same multiple of it share a single "
+    "timer, and may fire up to that much after the deadline.");
+
 namespace grpc_core {
 
+//
+// CoalescedDeadlineTimer
+//
+
+struct DeadlineTimerShard {
+  Mutex mu;
+  // Buckets whose timer has not fired yet, by rounded up deadline.
+  absl::flat_hash_map<int64_t, DeadlineTimerBucket*> buckets
+      ABSL_GUARDED_BY(mu);
+  // The last bucket that ran out of timers, if it has not fired yet. It is
+  // kept for the next calls with the same deadline, which would otherwise
+  // start and cancel a grpc_timer each when they run one at a time.
+  DeadlineTimerBucket* idle ABSL_GUARDED_BY(mu) = nullptr;
+};
+
+namespace {
+
+struct DeadlineTimerShards {
+  DeadlineTimerShards()
+      : num_shards(Clamp(gpr_cpu_num_cores(), 1u, 32u)),
+        shards(new DeadlineTimerShard[num_shards]) {
+    int32_t ms = GPR_GLOBAL_CONFIG_GET(grpc_deadline_timer_granularity_ms);
+    if (ms < 1) {
+      gpr_log(GPR_ERROR,
+              "Invalid GRPC_DEADLINE_TIMER_GRANULARITY_MS: %d, default value 1 "
+              "will be used.",
+              ms);
+      ms = 1;
+    }
+    granularity_ms = ms;
+  }
+
+  int64_t granularity_ms;
+  const size_t num_shards;
+  const std::unique_ptr<DeadlineTimerShard[]> shards;
+};
+
+DeadlineTimerShards& Shards() {
+  static DeadlineTimerShards* shards = new DeadlineTimerShards();
+  return *shards;
+}
+
+}  // namespace
+
+// The pending timers of a shard with the same rounded up deadline, and the
+// grpc_timer they share. Deletes itself once the grpc_timer has run.
+class DeadlineTimerBucket {
+ public:
+  DeadlineTimerBucket(DeadlineTimerShard* shard, int64_t key)
+      : shard_(shard), key_(key) {
+    GRPC_CLOSURE_INIT(&on_timer_, OnTimer, this, nullptr);
+    grpc_timer_init(&timer_, Timestamp::FromMillisecondsAfterProcessEpoch(key),
+                    &on_timer_);
+  }
+
+  void Add(CoalescedDeadlineTimer* timer)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard_->mu) {
+    if (shard_->idle == this) shard_->idle = nullptr;
+    timer->bucket_ = this;
+    timer->prev_ = nullptr;
+    timer->next_ = timers_;
+    if (timers_ != nullptr) timers_->prev_ = timer;
+    timers_ = timer;
+  }
+
+  void Remove(CoalescedDeadlineTimer* timer)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard_->mu) {
+    timer->bucket_ = nullptr;
+    if (timer->prev_ != nullptr) {
+      timer->prev_->next_ = timer->next_;
+    } else {
+      timers_ = timer->next_;
+    }
+    if (timer->next_ != nullptr) timer->next_->prev_ = timer->prev_;
+    // Nobody is waiting on the bucket anymore: it becomes the idle bucket of
+    // the shard, and the previous one stops its timer.
+    if (timers_ == nullptr) {
+      if (shard_->idle != nullptr) shard_->idle->Retire();
+      shard_->idle = this;
+    }
+  }
+
+ private:
+  // Stops the timer of an idle bucket. A later timer with the same deadline
+  // gets a new bucket.
+  void Retire() ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard_->mu) {
+    shard_->buckets.erase(key_);
+    registered_ = false;
+    grpc_timer_cancel(&timer_);
+  }
+
+  static void OnTimer(void* arg, grpc_error_handle error) {
+    DeadlineTimerBucket* self = static_cast<DeadlineTimerBucket*>(arg);
+    CoalescedDeadlineTimer* timers;
+    {
+      MutexLock lock(&self->shard_->mu);
+      if (self->registered_) self->shard_->buckets.erase(self->key_);
+      if (self->shard_->idle == self) self->shard_->idle = nullptr;
+      timers = std::exchange(self->timers_, nullptr);
+      for (auto* timer = timers; timer != nullptr; timer = timer->next_) {
+        timer->bucket_ = nullptr;
+      }
+    }
+    delete self;
+    // Cancelling these timers is a no-op now, and they are not reused before
+    // their closure runs, so the list can be walked without the lock.
+    while (timers != nullptr) {
+      CoalescedDeadlineTimer* next = timers->next_;
+      ExecCtx::Run(DEBUG_LOCATION, timers->closure_, error);
+      timers = next;
+    }
+  }
+
+  DeadlineTimerShard* const shard_;
+  const int64_t key_;
+  // Whether shard_->buckets still maps key_ to this bucket.
+  bool registered_ ABSL_GUARDED_BY(shard_->mu) = true;
+  CoalescedDeadlineTimer* timers_ ABSL_GUARDED_BY(shard_->mu) = nullptr;
+  grpc_timer timer_;
+  grpc_closure on_timer_;
+};
+
+void CoalescedDeadlineTimer::Init(Timestamp deadline, grpc_closure* closure) {
+  DeadlineTimerShards& shards = Shards();
+  closure_ = closure;
+  int64_t key = deadline.milliseconds_after_process_epoch();
+  const int64_t granularity = shards.granularity_ms;
+  if (key > 0 && key <= std::numeric_limits<int64_t>::max() - granularity) {
+    key = (key + granularity - 1) / granularity * granularity;
+  }
+  shard_ = &shards.shards[ExecCtx::Get()->starting_cpu() % shards.num_shards];
+  MutexLock lock(&shard_->mu);
+  DeadlineTimerBucket*& bucket = shard_->buckets[key];
+  if (bucket == nullptr) bucket = new DeadlineTimerBucket(shard_, key);
+  bucket->Add(this);
+}
+
+void CoalescedDeadlineTimer::Cancel() {
+  if (shard_ == nullptr) return;
+  {
+    MutexLock lock(&shard_->mu);
+    if (bucket_ == nullptr) return;
+    bucket_->Remove(this);
+  }
+  ExecCtx::Run(DEBUG_LOCATION, closure_, absl::CancelledError());
+}
+
+size_t CoalescedDeadlineTimer::TestOnlyNumPendingBuckets() {
+  DeadlineTimerShards& shards = Shards();
+  size_t num_buckets = 0;
+  for (size_t i = 0; i < shards.num_shards; i++) {
+    MutexLock lock(&shards.shards[i].mu);
+    num_buckets += shards.shards[i].buckets.size();
+  }
+  return num_buckets;
+}
+
+//
+// TimerState
+//
+
 // A fire-and-forget class representing a pending deadline timer.
 // Allocated on the call arena.
 class TimerState {
@@ -50,10 +227,10 @@ class TimerState {
         static_cast<grpc_deadline_state*>(elem_->call_data);
     GRPC_CALL_STACK_REF(deadline_state->call_stack, "DeadlineTimerState");
     GRPC_CLOSURE_INIT(&closure_, TimerCallback, this, nullptr);
-    grpc_timer_init(&timer_, deadline, &closure_);
+    timer_.Init(deadline, &closure_);
   }
 
-  void Cancel() { grpc_timer_cancel(&timer_); }
+  void Cancel() { timer_.Cancel(); }
 
  private:
   // The on_complete callback used when sending a cancel_error batch down the
@@ -106,7 +283,7 @@ class TimerState {
   // finishes and (b) the filter sees the call completion and attempts
   // to cancel the timer.
   grpc_call_element* elem_;
-  grpc_timer timer_;
+  CoalescedDeadlineTimer timer_;
   grpc_closure closure_;
 };
 
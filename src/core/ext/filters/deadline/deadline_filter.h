@@ -19,17 +19,56 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/transport/transport.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_deadline_timer_granularity_ms);
+
 namespace grpc_core {
+
 class TimerState;
+class DeadlineTimerBucket;
+struct DeadlineTimerShard;
+
+// A call deadline timer, with the same contract as a grpc_timer. Timers
+// started on the same CPU whose deadlines round up to the same multiple of
+// GRPC_DEADLINE_TIMER_GRANULARITY_MS share a single grpc_timer, so that
+// starting and cancelling one only links it into and out of a list.
+class CoalescedDeadlineTimer {
+ public:
+  // Runs closure once the rounded up deadline has passed, or with
+  // absl::CancelledError() if the timer is cancelled first. The closure is
+  // always run exactly once, and the timer must not be reused before that.
+  // Requires an ExecCtx.
+  void Init(Timestamp deadline, grpc_closure* closure);
+  // Cancels the timer if it has not fired yet. Safe to call several times.
+  void Cancel();
+
+  // The number of buckets, over all shards, whose grpc_timer is still
+  // pending, including the idle ones kept for reuse.
+  static size_t TestOnlyNumPendingBuckets();
+
+ private:
+  friend class DeadlineTimerBucket;
+
+  grpc_closure* closure_ = nullptr;
+  DeadlineTimerShard* shard_ = nullptr;
+  // The bucket, and the links in its list of timers, are guarded by the
+  // lock of shard_. bucket_ is null once the timer fired or was cancelled.
+  DeadlineTimerBucket* bucket_ = nullptr;
+  CoalescedDeadlineTimer* prev_ = nullptr;
+  CoalescedDeadlineTimer* next_ = nullptr;
+};
+
 }  // namespace grpc_core
 
 // State used for filters that enforce call deadlines.
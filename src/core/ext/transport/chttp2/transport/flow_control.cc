@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -181,18 +182,27 @@ FlowControlAction TransportFlowControl::UpdateAction(FlowControlAction action) {
 }
 
 // Take in a target and modifies it based on the memory pressure of the system
-static double AdjustForMemoryPressure(double memory_pressure, double target) {
+double AdjustForMemoryPressure(
+    const BasicMemoryQuota::PressureInfo& pressure_info, double target) {
   // do not increase window under heavy memory pressure.
   static const double kLowMemPressure = 0.1;
   static const double kZeroTarget = 22;
   static const double kHighMemPressure = 0.8;
   static const double kMaxMemPressure = 0.9;
+  // With pressure_aware_buffer_sizing the window starts shrinking earlier,
+  // along with the TCP read buffers, and still reaches zero at
+  // kMaxMemPressure.
+  static const double kPressureAwareMemPressure = 0.7;
+  const double memory_pressure = pressure_info.pressure_control_value;
+  const double shrink_from = IsPressureAwareBufferSizingEnabled()
+                                 ? kPressureAwareMemPressure
+                                 : kHighMemPressure;
   if (memory_pressure < kLowMemPressure && target < kZeroTarget) {
     target = (target - kZeroTarget) * memory_pressure / kLowMemPressure +
              kZeroTarget;
-  } else if (memory_pressure > kHighMemPressure) {
-    target *= 1 - std::min(1.0, (memory_pressure - kHighMemPressure) /
-                                    (kMaxMemPressure - kHighMemPressure));
+  } else if (memory_pressure > shrink_from) {
+    target *= 1 - std::min(1.0, (memory_pressure - shrink_from) /
+                                    (kMaxMemPressure - shrink_from));
   }
   return target;
 }
@@ -200,8 +210,9 @@ static double AdjustForMemoryPressure(double memory_pressure, double target) {
 double TransportFlowControl::TargetLogBdp() {
   return AdjustForMemoryPressure(
       memory_owner_->is_valid()
-          ? memory_owner_->GetPressureInfo().pressure_control_value
-          : 0.0,
+          ? memory_owner_->GetPressureInfo()
+          : BasicMemoryQuota::PressureInfo{
+                0.0, 0.0, std::numeric_limits<size_t>::max()},
       1 + log2(bdp_estimator_.EstimateBdp()));
 }
 
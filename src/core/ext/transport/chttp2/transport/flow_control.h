@@ -395,6 +395,11 @@ class StreamFlowControl final {
   int64_t DesiredAnnounceSize() const;
 };
 
+// Adjusts target, the log2 of a BDP based window size, for the memory
+// pressure in pressure_info.
+double AdjustForMemoryPressure(
+    const BasicMemoryQuota::PressureInfo& pressure_info, double target);
+
 class TestOnlyTransportTargetWindowEstimatesMocker {
  public:
   virtual ~TestOnlyTransportTargetWindowEstimatesMocker() {}
@@ -47,6 +47,9 @@ class XdsBootstrap {
 
     virtual const std::string& server_uri() const = 0;
     virtual bool IgnoreResourceDeletion() const = 0;
+    // If true, the ADS stream uses the incremental (delta) xDS protocol
+    // instead of state-of-the-world.
+    virtual bool UseDeltaProtocol() const = 0;
 
     virtual bool Equals(const XdsServer& other) const = 0;
 
@@ -95,6 +95,7 @@ namespace {
 
 constexpr absl::string_view kServerFeatureIgnoreResourceDeletion =
     "ignore_resource_deletion";
+constexpr absl::string_view kServerFeatureDeltaProtocol = "delta_protocol";
 
 }  // namespace
 
@@ -103,6 +104,11 @@ bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
              kServerFeatureIgnoreResourceDeletion)) != server_features_.end();
 }
 
+bool GrpcXdsBootstrap::GrpcXdsServer::UseDeltaProtocol() const {
+  return server_features_.find(std::string(kServerFeatureDeltaProtocol)) !=
+         server_features_.end();
+}
+
 bool GrpcXdsBootstrap::GrpcXdsServer::Equals(const XdsServer& other) const {
   const auto& o = static_cast<const GrpcXdsServer&>(other);
   return (server_uri_ == o.server_uri_ &&
@@ -161,7 +167,8 @@ void GrpcXdsBootstrap::GrpcXdsServer::JsonPostLoad(const Json& json,
         for (const Json& feature_json : array) {
           if (feature_json.type() == Json::Type::STRING &&
               (feature_json.string_value() ==
-               kServerFeatureIgnoreResourceDeletion)) {
+                   kServerFeatureIgnoreResourceDeletion ||
+               feature_json.string_value() == kServerFeatureDeltaProtocol)) {
             server_features_.insert(feature_json.string_value());
           }
         }
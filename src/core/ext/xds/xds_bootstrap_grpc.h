@@ -78,6 +78,7 @@ class GrpcXdsBootstrap : public XdsBootstrap {
     const std::string& server_uri() const override { return server_uri_; }
 
     bool IgnoreResourceDeletion() const override;
+    bool UseDeltaProtocol() const override;
 
     bool Equals(const XdsServer& other) const override;
 
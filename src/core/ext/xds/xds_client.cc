@@ -22,6 +22,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -29,10 +32,13 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "upb/arena.h"
+#include "upb/upb.hpp"
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_api.h"
@@ -127,6 +133,13 @@ class XdsClient::ChannelState::AdsCallState
   bool HasSubscribedResources() const;
 
  private:
+  // Parses an ADS response in three phases, so that the potentially
+  // expensive decoding of resources does not hold XdsClient::mu_:
+  // - XdsApi parses the response, calling ParseResource() for each
+  //   resource, which just records it.
+  // - DecodeResources() decodes the recorded resources, in parallel on
+  //   the EventEngine if there are enough of them.
+  // - ApplyResourcesLocked() updates the cache and notifies watchers.
   class AdsResponseParser : public XdsApi::AdsResponseParserInterface {
    public:
     struct Result {
@@ -144,22 +157,89 @@ class XdsClient::ChannelState::AdsCallState
         : ads_call_state_(ads_call_state) {}
 
     absl::Status ProcessAdsResponseFields(AdsResponseFields fields) override
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::symtab_mu_);
 
     void ParseResource(upb_Arena* arena, size_t idx, absl::string_view type_url,
                        absl::string_view resource_name,
-                       absl::string_view serialized_resource) override
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+                       absl::string_view resource_version,
+                       absl::string_view serialized_resource) override;
 
     void ResourceWrapperParsingFailed(size_t idx) override;
 
+    void ResourceRemoved(absl::string_view resource_name) override;
+
+    // Delta protocol only: marks the resources whose version matches the
+    // cached resource, so that they are not decoded.
+    void SkipUnchangedResourcesLocked()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Decodes the resources recorded by ParseResource().
+    void DecodeResources() ABSL_LOCKS_EXCLUDED(&XdsClient::mu_);
+
+    // Updates the resource cache from the decoded resources and notifies
+    // watchers of any changes.
+    void ApplyResourcesLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     Result TakeResult() { return std::move(result_); }
 
    private:
+    // A resource from the response, recorded by ParseResource().
+    struct PendingResource {
+      size_t idx;
+      // Name and version from the Resource wrapper, if any.
+      std::string name;
+      std::string version;
+      std::string serialized;
+      // If non-empty, the resource could not be parsed far enough to be
+      // decoded, and this is the error to include in the NACK.
+      std::string error;
+      // Set by SkipUnchangedResourcesLocked().
+      bool unchanged = false;
+      // Set by DecodeResources().
+      XdsResourceType::DecodeResult decode_result;
+    };
+
+    // Shared between DecodeResources() and the EventEngine closures that
+    // help it, which may run after DecodeResources() has returned.
+    struct DecodeState {
+      XdsClient* xds_client;
+      const XdsBootstrap::XdsServer* server;
+      const XdsResourceType* type;
+      upb_DefPool* symtab;
+      std::vector<PendingResource*> resources;
+      // Index of the next resource to decode.
+      std::atomic<size_t> next_resource{0};
+      Mutex mu;
+      CondVar cv;
+      size_t num_decoded ABSL_GUARDED_BY(mu) = 0;
+      absl::Duration decode_time ABSL_GUARDED_BY(mu);
+    };
+
+    // Decodes resources from state until there are none left to claim.
+    static void DecodeResourcesFrom(DecodeState* state);
+
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    void ApplyResourceLocked(PendingResource* resource)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Cancels the resource-does-not-exist timer for the resource, if any.
+    void MarkResourceSeen(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Returns the cached state for the resource, or null if we don't have
+    // a subscription for it.
+    ResourceState* FindResourceState(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = Timestamp::Now();
+    upb_DefPool* symtab_ = nullptr;
+    std::vector<PendingResource> resources_;
+    std::vector<std::string> removed_resources_;
+    // Parse stats for this response, added to the XdsClient's stats for
+    // the type by ApplyResourcesLocked().
+    XdsClient::ResourceTypeParseStats stats_;
     Result result_;
   };
 
@@ -304,11 +384,23 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // Delta protocol only: the resource names subscribed to by the
+    // requests sent so far on this stream, and whether any request has
+    // been sent for this type yet.
+    std::set<std::string> delta_resource_names;
+    bool sent_delta_request = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+  // Creates a delta ADS request containing the subscription changes since
+  // the last request for this type on the stream.
+  std::string CreateDeltaAdsRequestLocked(const XdsResourceType* type,
+                                          ResourceTypeState* state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   void OnRequestSent(bool ok);
   void OnRecvMessage(absl::string_view payload);
   void OnStatusReceived(absl::Status status);
@@ -323,6 +415,9 @@ class XdsClient::ChannelState::AdsCallState
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
+  // True if the stream uses the incremental (delta) xDS protocol.
+  const bool delta_;
+
   OrphanablePtr<XdsTransportFactory::XdsTransport::StreamingCall> call_;
 
   bool sent_initial_message_ = false;
@@ -701,9 +796,11 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
     return absl::InvalidArgumentError(
         absl::StrCat("unknown resource type ", fields.type_url));
   }
+  symtab_ = xds_client()->symtab_.ptr();
   result_.type_url = std::move(fields.type_url);
   result_.version = std::move(fields.version);
   result_.nonce = std::move(fields.nonce);
+  resources_.reserve(fields.num_resources);
   return absl::OkStatus();
 }
 
@@ -733,35 +830,270 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 }  // namespace
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MarkResourceSeen(const XdsResourceName& name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it != ads_call_state_->state_map_.end()) {
+    auto it = timer_it->second.subscribed_resources.find(name.authority);
+    if (it != timer_it->second.subscribed_resources.end()) {
+      auto res_it = it->second.find(name.key);
+      if (res_it != it->second.end()) {
+        res_it->second->MarkSeen();
+      }
+    }
+  }
+}
+
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::AdsResponseParser::FindResourceState(
+    const XdsResourceName& name) {
+  // Lookup the authority in the cache.
+  auto authority_it = xds_client()->authority_state_map_.find(name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) {
+    return nullptr;
+  }
+  // Found authority, so look up type.
+  AuthorityState& authority_state = authority_it->second;
+  auto type_it = authority_state.resource_map.find(result_.type);
+  if (type_it == authority_state.resource_map.end()) return nullptr;
+  auto& type_map = type_it->second;
+  // Found type, so look up resource key.
+  auto it = type_map.find(name.key);
+  if (it == type_map.end()) return nullptr;
+  return &it->second;
+}
+
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
-    upb_Arena* arena, size_t idx, absl::string_view type_url,
-    absl::string_view resource_name, absl::string_view serialized_resource) {
-  std::string error_prefix = absl::StrCat(
-      "resource index ", idx, ": ",
-      resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
+    upb_Arena* /*arena*/, size_t idx, absl::string_view type_url,
+    absl::string_view resource_name, absl::string_view resource_version,
+    absl::string_view serialized_resource) {
+  PendingResource resource;
+  resource.idx = idx;
+  resource.name = std::string(resource_name);
+  resource.version = std::string(resource_version);
   // Check the type_url of the resource.
   if (result_.type_url != type_url) {
-    result_.errors.emplace_back(
-        absl::StrCat(error_prefix, "incorrect resource type ", type_url,
-                     " (should be ", result_.type_url, ")"));
+    resource.error = absl::StrCat(
+        "resource index ", idx, ": ",
+        resource_name.empty() ? "" : absl::StrCat(resource_name, ": "),
+        "incorrect resource type ", type_url, " (should be ",
+        result_.type_url, ")");
+  } else {
+    resource.serialized = std::string(serialized_resource);
+  }
+  resources_.push_back(std::move(resource));
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ResourceWrapperParsingFailed(size_t idx) {
+  PendingResource resource;
+  resource.idx = idx;
+  resource.error = absl::StrCat("resource index ", idx,
+                                ": Can't decode Resource proto wrapper");
+  resources_.push_back(std::move(resource));
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ResourceRemoved(
+    absl::string_view resource_name) {
+  removed_resources_.emplace_back(resource_name);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    SkipUnchangedResourcesLocked() {
+  for (PendingResource& resource : resources_) {
+    if (resource.version.empty() || !resource.error.empty()) continue;
+    auto parsed_resource_name =
+        xds_client()->ParseXdsResourceName(resource.name, result_.type);
+    if (!parsed_resource_name.ok()) continue;
+    ResourceState* resource_state = FindResourceState(*parsed_resource_name);
+    resource.unchanged =
+        resource_state != nullptr && resource_state->resource != nullptr &&
+        !resource_state->ignored_deletion &&
+        resource_state->meta.version == resource.version;
+  }
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    DecodeResourcesFrom(DecodeState* state) {
+  const size_t num_resources = state->resources.size();
+  size_t num_decoded = 0;
+  absl::Duration decode_time;
+  upb::Arena arena;
+  for (size_t i = state->next_resource.fetch_add(1, std::memory_order_relaxed);
+       i < num_resources;
+       i = state->next_resource.fetch_add(1, std::memory_order_relaxed)) {
+    PendingResource* resource = state->resources[i];
+    XdsResourceType::DecodeContext context = {
+        state->xds_client, *state->server, &grpc_xds_client_trace,
+        state->symtab, arena.ptr()};
+    const absl::Time start = absl::Now();
+    resource->decode_result =
+        state->type->Decode(context, resource->serialized);
+    decode_time += absl::Now() - start;
+    ++num_decoded;
+  }
+  if (num_decoded == 0) return;
+  MutexLock lock(&state->mu);
+  state->num_decoded += num_decoded;
+  state->decode_time += decode_time;
+  if (state->num_decoded == num_resources) state->cv.Signal();
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    DecodeResources() {
+  // Minimum number of resources to decode in each EventEngine closure.
+  constexpr size_t kMinResourcesPerTask = 8;
+  auto state = std::make_shared<DecodeState>();
+  for (PendingResource& resource : resources_) {
+    if (resource.error.empty() && !resource.unchanged) {
+      state->resources.push_back(&resource);
+    }
+  }
+  if (state->resources.empty()) return;
+  state->xds_client = xds_client();
+  state->server = &ads_call_state_->chand()->server_;
+  state->type = result_.type;
+  state->symtab = symtab_;
+  const size_t num_helpers = std::min<size_t>(
+      gpr_cpu_num_cores() - 1,
+      (state->resources.size() - 1) / kMinResourcesPerTask);
+  const absl::Time start = absl::Now();
+  // Count this decode as a symtab reader, so that new resource types cannot
+  // be added to the symtab while it is being used. symtab_mu_ itself is not
+  // held while decoding or waiting for the helpers, so other decodes (and
+  // anything else taking symtab_mu_) proceed meanwhile.
+  {
+    MutexLock lock(&xds_client()->symtab_mu_);
+    ++xds_client()->symtab_readers_;
+  }
+  // The helpers claim resources from the same index as this thread, so
+  // that a helper that starts late finds no work left rather than being
+  // waited for.
+  for (size_t i = 0; i < num_helpers; ++i) {
+    xds_client()->engine()->Run([state]() {
+      ApplicationCallbackExecCtx callback_exec_ctx;
+      ExecCtx exec_ctx;
+      DecodeResourcesFrom(state.get());
+    });
+  }
+  DecodeResourcesFrom(state.get());
+  {
+    MutexLock lock(&state->mu);
+    while (state->num_decoded < state->resources.size()) {
+      state->cv.Wait(&state->mu);
+    }
+  }
+  {
+    MutexLock lock(&xds_client()->symtab_mu_);
+    if (--xds_client()->symtab_readers_ == 0) {
+      xds_client()->symtab_cv_.SignalAll();
+    }
+  }
+  stats_.resources_decoded += state->resources.size();
+  stats_.decode_time += state->decode_time;
+  stats_.decode_elapsed_time += absl::Now() - start;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] xds server %s: decoded %" PRIuPTR
+            " %s resources in %s using %" PRIuPTR " helper tasks",
+            xds_client(),
+            ads_call_state_->chand()->server_.server_uri().c_str(),
+            state->resources.size(), result_.type_url.c_str(),
+            absl::FormatDuration(stats_.decode_elapsed_time).c_str(),
+            num_helpers);
+  }
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ApplyResourcesLocked() {
+  for (PendingResource& resource : resources_) {
+    ApplyResourceLocked(&resource);
+  }
+  for (const std::string& resource_name : removed_resources_) {
+    auto parsed_resource_name =
+        xds_client()->ParseXdsResourceName(resource_name, result_.type);
+    if (!parsed_resource_name.ok()) {
+      result_.errors.emplace_back(
+          absl::StrCat("removed resource ", resource_name,
+                       ": Cannot parse xDS resource name"));
+      continue;
+    }
+    // The server has told us that the resource does not exist, so there's
+    // no need to wait for the timer.
+    MarkResourceSeen(*parsed_resource_name);
+    ResourceState* resource_state = FindResourceState(*parsed_resource_name);
+    if (resource_state == nullptr) continue;
+    if (resource_state->resource != nullptr &&
+        ads_call_state_->chand()->server_.IgnoreResourceDeletion()) {
+      if (!resource_state->ignored_deletion) {
+        gpr_log(GPR_ERROR,
+                "[xds_client %p] xds server %s: ignoring deletion for "
+                "resource type %s name %s",
+                xds_client(),
+                ads_call_state_->chand()->server_.server_uri().c_str(),
+                result_.type_url.c_str(), resource_name.c_str());
+        resource_state->ignored_deletion = true;
+      }
+      continue;
+    }
+    resource_state->resource.reset();
+    resource_state->meta.client_status =
+        XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+    xds_client()->NotifyWatchersOnResourceDoesNotExist(
+        resource_state->watchers);
+  }
+  // Record parse stats.
+  XdsClient::ResourceTypeParseStats& stats =
+      xds_client()->parse_stats_[result_.type];
+  ++stats.responses;
+  stats.resources_decoded += stats_.resources_decoded;
+  stats.resources_invalid += stats_.resources_invalid;
+  stats.resources_unchanged += stats_.resources_unchanged;
+  stats.decode_time += stats_.decode_time;
+  stats.decode_elapsed_time += stats_.decode_elapsed_time;
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ApplyResourceLocked(PendingResource* resource) {
+  if (!resource->error.empty()) {
+    result_.errors.push_back(std::move(resource->error));
     return;
   }
-  // Parse the resource.
-  XdsResourceType::DecodeContext context = {
-      xds_client(), ads_call_state_->chand()->server_, &grpc_xds_client_trace,
-      xds_client()->symtab_.ptr(), arena};
-  XdsResourceType::DecodeResult decode_result =
-      result_.type->Decode(context, serialized_resource);
+  absl::string_view resource_name = resource->name;
+  // In a delta response, a resource whose version matches the one we
+  // already have is unchanged, so it was not decoded.
+  if (resource->unchanged) {
+    auto parsed_resource_name =
+        xds_client()->ParseXdsResourceName(resource_name, result_.type);
+    if (parsed_resource_name.ok()) MarkResourceSeen(*parsed_resource_name);
+    result_.have_valid_resources = true;
+    ++stats_.resources_unchanged;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+      gpr_log(GPR_INFO,
+              "[xds_client %p] %s resource %s version %s unchanged, "
+              "skipping.",
+              xds_client(), result_.type_url.c_str(),
+              resource->name.c_str(), resource->version.c_str());
+    }
+    return;
+  }
+  const std::string& version =
+      resource->version.empty() ? result_.version : resource->version;
+  std::string error_prefix = absl::StrCat(
+      "resource index ", resource->idx, ": ",
+      resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
+  XdsResourceType::DecodeResult& decode_result = resource->decode_result;
   // If we didn't already have the resource name from the Resource
   // wrapper, try to get it from the decoding result.
   if (resource_name.empty()) {
     if (decode_result.name.has_value()) {
       resource_name = *decode_result.name;
-      error_prefix =
-          absl::StrCat("resource index ", idx, ": ", resource_name, ": ");
+      error_prefix = absl::StrCat("resource index ", resource->idx, ": ",
+                                  resource_name, ": ");
     } else {
       // We don't have any way of determining the resource name, so
       // there's nothing more we can do here.
+      ++stats_.resources_invalid;
       result_.errors.emplace_back(absl::StrCat(
           error_prefix, decode_result.resource.status().ToString()));
       return;
@@ -770,6 +1102,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
   // If decoding failed, make sure we include the error in the NACK.
   const absl::Status& decode_status = decode_result.resource.status();
   if (!decode_status.ok()) {
+    ++stats_.resources_invalid;
     result_.errors.emplace_back(
         absl::StrCat(error_prefix, decode_status.ToString()));
   }
@@ -782,36 +1115,12 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it = timer_it->second.subscribed_resources.find(
-        parsed_resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(parsed_resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MarkSeen();
-      }
-    }
-  }
-  // Lookup the authority in the cache.
-  auto authority_it =
-      xds_client()->authority_state_map_.find(parsed_resource_name->authority);
-  if (authority_it == xds_client()->authority_state_map_.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  // Found authority, so look up type.
-  AuthorityState& authority_state = authority_it->second;
-  auto type_it = authority_state.resource_map.find(result_.type);
-  if (type_it == authority_state.resource_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  auto& type_map = type_it->second;
-  // Found type, so look up resource key.
-  auto it = type_map.find(parsed_resource_name->key);
-  if (it == type_map.end()) {
+  MarkResourceSeen(*parsed_resource_name);
+  ResourceState* resource_state_ptr = FindResourceState(*parsed_resource_name);
+  if (resource_state_ptr == nullptr) {
     return;  // Skip resource -- we don't have a subscription for it.
   }
-  ResourceState& resource_state = it->second;
+  ResourceState& resource_state = *resource_state_ptr;
   // If needed, record that we've seen this resource.
   if (result_.type->AllResourcesRequiredInSotW()) {
     result_.resources_seen[parsed_resource_name->authority].insert(
@@ -826,7 +1135,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
             "name %s",
             xds_client(),
             ads_call_state_->chand()->server_.server_uri().c_str(),
-            std::string(type_url).c_str(), std::string(resource_name).c_str());
+            result_.type_url.c_str(), std::string(resource_name).c_str());
     resource_state.ignored_deletion = false;
   }
   // Update resource state based on whether the resource is valid.
@@ -835,7 +1144,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(
             absl::StrCat("invalid resource: ", decode_status.ToString())));
-    UpdateResourceMetadataNacked(result_.version, decode_status.ToString(),
+    UpdateResourceMetadataNacked(version, decode_status.ToString(),
                                  update_time_, &resource_state.meta);
     return;
   }
@@ -845,18 +1154,22 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
   if (resource_state.resource != nullptr &&
       result_.type->ResourcesEqual(resource_state.resource.get(),
                                    decode_result.resource->get())) {
+    ++stats_.resources_unchanged;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
       gpr_log(GPR_INFO,
               "[xds_client %p] %s resource %s identical to current, ignoring.",
               xds_client(), result_.type_url.c_str(),
               std::string(resource_name).c_str());
     }
+    // Record the new version, so that we can skip the resource the next
+    // time the server sends this version in a delta response.
+    if (!resource->version.empty()) resource_state.meta.version = version;
     return;
   }
   // Update the resource state.
   resource_state.resource = std::move(*decode_result.resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::move(resource->serialized), version, update_time_);
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
   auto* value =
@@ -872,12 +1185,6 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
       DEBUG_LOCATION);
 }
 
-void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
-    ResourceWrapperParsingFailed(size_t idx) {
-  result_.errors.emplace_back(absl::StrCat(
-      "resource index ", idx, ": Can't decode Resource proto wrapper"));
-}
-
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -888,12 +1195,15 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
           GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_refcount_trace)
               ? "AdsCallState"
               : nullptr),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      delta_(chand()->server_.UseDeltaProtocol()) {
   GPR_ASSERT(xds_client() != nullptr);
   // Init the ADS call.
   const char* method =
-      "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
-      "StreamAggregatedResources";
+      delta_ ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+               "DeltaAggregatedResources"
+             : "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+               "StreamAggregatedResources";
   call_ = chand()->transport_->CreateStreamingCall(
       method, std::make_unique<StreamEventHandler>(
                   // Passing the initial ref here.  This ref will go away when
@@ -945,9 +1255,12 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
     return;
   }
   auto& state = state_map_[type];
-  std::string serialized_message = xds_client()->api_.CreateAdsRequest(
-      type->type_url(), chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), state.status, !sent_initial_message_);
+  std::string serialized_message =
+      delta_ ? CreateDeltaAdsRequestLocked(type, &state)
+             : xds_client()->api_.CreateAdsRequest(
+                   type->type_url(), chand()->resource_type_version_map_[type],
+                   state.nonce, ResourceNamesForRequest(type), state.status,
+                   !sent_initial_message_);
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -959,10 +1272,61 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
             state.nonce.c_str(), state.status.ToString().c_str());
   }
   state.status = absl::OkStatus();
+  // In the delta protocol, the nonce is sent only to ACK or NACK the
+  // response that carried it.
+  if (delta_) state.nonce.clear();
   call_->SendMessage(std::move(serialized_message));
   send_message_pending_ = type;
 }
 
+std::string XdsClient::ChannelState::AdsCallState::CreateDeltaAdsRequestLocked(
+    const XdsResourceType* type, ResourceTypeState* state) {
+  std::vector<std::string> names = ResourceNamesForRequest(type);
+  std::set<std::string> resource_names(std::make_move_iterator(names.begin()),
+                                       std::make_move_iterator(names.end()));
+  std::vector<std::string> resource_names_subscribe;
+  std::set_difference(resource_names.begin(), resource_names.end(),
+                      state->delta_resource_names.begin(),
+                      state->delta_resource_names.end(),
+                      std::back_inserter(resource_names_subscribe));
+  std::vector<std::string> resource_names_unsubscribe;
+  std::set_difference(state->delta_resource_names.begin(),
+                      state->delta_resource_names.end(),
+                      resource_names.begin(), resource_names.end(),
+                      std::back_inserter(resource_names_unsubscribe));
+  // On the first request for this type on the stream, tell the server
+  // which versions we already have cached, so that it doesn't need to
+  // resend unchanged resources after a reconnect.
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->sent_delta_request) {
+    for (const auto& a : state->subscribed_resources) {
+      const std::string& authority = a.first;
+      auto authority_it = xds_client()->authority_state_map_.find(authority);
+      if (authority_it == xds_client()->authority_state_map_.end()) continue;
+      auto type_it = authority_it->second.resource_map.find(type);
+      if (type_it == authority_it->second.resource_map.end()) continue;
+      for (const auto& p : a.second) {
+        const XdsResourceKey& resource_key = p.first;
+        auto it = type_it->second.find(resource_key);
+        if (it == type_it->second.end() || it->second.resource == nullptr ||
+            it->second.meta.version.empty()) {
+          continue;
+        }
+        initial_resource_versions.emplace(
+            XdsClient::ConstructFullXdsResourceName(
+                authority, type->type_url(), resource_key),
+            it->second.meta.version);
+      }
+    }
+    state->sent_delta_request = true;
+  }
+  state->delta_resource_names = std::move(resource_names);
+  return xds_client()->api_.CreateDeltaAdsRequest(
+      type->type_url(), state->nonce, resource_names_subscribe,
+      resource_names_unsubscribe, initial_resource_versions, state->status,
+      !sent_initial_message_);
+}
+
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
   auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
@@ -1028,9 +1392,27 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
   {
     MutexLock lock(&xds_client()->mu_);
     if (!IsCurrentCallOnChannel()) return;
-    // Parse and validate the response.
-    AdsResponseParser parser(this);
-    absl::Status status = xds_client()->api_.ParseAdsResponse(payload, &parser);
+  }
+  // Parse the response and decode the resources without holding the
+  // lock, so that a large response does not block other xDS activity.
+  AdsResponseParser parser(this);
+  absl::Status status;
+  {
+    MutexLock lock(&xds_client()->symtab_mu_);
+    status =
+        delta_ ? xds_client()->api_.ParseDeltaAdsResponse(payload, &parser)
+               : xds_client()->api_.ParseAdsResponse(payload, &parser);
+  }
+  if (status.ok()) {
+    if (delta_) {
+      MutexLock lock(&xds_client()->mu_);
+      parser.SkipUnchangedResourcesLocked();
+    }
+    parser.DecodeResources();
+  }
+  {
+    MutexLock lock(&xds_client()->mu_);
+    if (!IsCurrentCallOnChannel()) return;
     if (!status.ok()) {
       // Ignore unparsable response.
       gpr_log(GPR_ERROR,
@@ -1041,6 +1423,8 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
     } else {
       seen_response_ = true;
       chand()->status_ = absl::OkStatus();
+      // Validate the decoded resources and update the cache.
+      parser.ApplyResourcesLocked();
       AdsResponseParser::Result result = parser.TakeResult();
       // Update nonce.
       auto& state = state_map_[result.type];
@@ -1058,8 +1442,9 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
                 result.type_url.c_str(), result.version.c_str(),
                 state.nonce.c_str(), state.status.ToString().c_str());
       }
-      // Delete resources not seen in update if needed.
-      if (result.type->AllResourcesRequiredInSotW()) {
+      // Delete resources not seen in update if needed.  In the delta
+      // protocol, deletions are reported explicitly instead.
+      if (!delta_ && result.type->AllResourcesRequiredInSotW()) {
         for (auto& a : xds_client()->authority_state_map_) {
           const std::string& authority = a.first;
           AuthorityState& authority_state = a.second;
@@ -1689,6 +2074,10 @@ void XdsClient::MaybeRegisterResourceTypeLocked(
     GPR_ASSERT(it->second == resource_type);
     return;
   }
+  MutexLock lock(&symtab_mu_);
+  // Decodes in progress read the symtab without holding symtab_mu_. They
+  // never take mu_, so waiting for them here cannot deadlock.
+  while (symtab_readers_ > 0) symtab_cv_.Wait(&symtab_mu_);
   resource_types_.emplace(resource_type->type_url(), resource_type);
   resource_type->InitUpbSymtab(this, symtab_.ptr());
 }
@@ -1892,6 +2281,16 @@ void XdsClient::ResetBackoff() {
   }
 }
 
+std::map<std::string, XdsClient::ResourceTypeParseStats>
+XdsClient::GetResourceTypeParseStats() {
+  MutexLock lock(&mu_);
+  std::map<std::string, ResourceTypeParseStats> stats;
+  for (const auto& p : parse_stats_) {
+    stats.emplace(std::string(p.first->type_url()), p.second);
+  }
+  return stats;
+}
+
 void XdsClient::NotifyWatchersOnErrorLocked(
     const std::map<ResourceWatcherInterface*,
                    RefCountedPtr<ResourceWatcherInterface>>& watchers,
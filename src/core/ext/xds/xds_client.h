@@ -19,6 +19,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <set>
@@ -30,6 +32,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "upb/def.hpp"
 
 #include <grpc/event_engine/event_engine.h>
@@ -138,6 +141,27 @@ class XdsClient : public DualRefCounted<XdsClient> {
   // Resets connection backoff state.
   void ResetBackoff();
 
+  // Statistics about decoding ADS responses for one resource type.
+  struct ResourceTypeParseStats {
+    // Number of ADS responses received for the type.
+    uint64_t responses = 0;
+    // Number of resources decoded, and how many of those were invalid.
+    uint64_t resources_decoded = 0;
+    uint64_t resources_invalid = 0;
+    // Number of resources that were unchanged from the cached resource,
+    // either because they decoded to an equal value or because their
+    // delta version matched, for which watchers were not notified.
+    uint64_t resources_unchanged = 0;
+    // Sum of the time spent decoding each resource.
+    absl::Duration decode_time;
+    // Sum of the elapsed time spent in the decode phase of each response.
+    // Less than decode_time when resources are decoded in parallel.
+    absl::Duration decode_elapsed_time;
+  };
+
+  // Returns the parse statistics for each resource type, keyed by type URL.
+  std::map<std::string, ResourceTypeParseStats> GetResourceTypeParseStats();
+
   // Dumps the active xDS config in JSON format.
   // Individual xDS resource is encoded as envoy.admin.v3.*ConfigDump. Returns
   // envoy.service.status.v3.ClientConfig which also includes the config
@@ -286,8 +310,9 @@ class XdsClient : public DualRefCounted<XdsClient> {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // Gets the type for resource_type, or null if the type is unknown.
-  const XdsResourceType* GetResourceTypeLocked(absl::string_view resource_type)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Caller must hold either mu_ or symtab_mu_.
+  const XdsResourceType* GetResourceTypeLocked(
+      absl::string_view resource_type);
 
   absl::StatusOr<XdsResourceName> ParseXdsResourceName(
       absl::string_view name, const XdsResourceType* type);
@@ -313,10 +338,23 @@ class XdsClient : public DualRefCounted<XdsClient> {
 
   Mutex mu_;
 
+  // Allows ADS responses to be parsed and decoded without holding mu_.
+  // resource_types_ and symtab_ are modified only while holding both mu_
+  // and symtab_mu_, so they may be read while holding either one.
+  // Decoding reads symtab_ without holding either lock, from several
+  // threads: it counts itself in symtab_readers_ instead, and writers wait
+  // on symtab_cv_ for the count to drop to zero.
+  Mutex symtab_mu_ ABSL_ACQUIRED_AFTER(mu_);
+  CondVar symtab_cv_;
+  size_t symtab_readers_ ABSL_GUARDED_BY(symtab_mu_) = 0;
+
   // Stores resource type objects seen by type URL.
   std::map<absl::string_view /*resource_type*/, const XdsResourceType*>
-      resource_types_ ABSL_GUARDED_BY(mu_);
-  upb::SymbolTable symtab_ ABSL_GUARDED_BY(mu_);
+      resource_types_;
+  upb::SymbolTable symtab_;
+
+  std::map<const XdsResourceType*, ResourceTypeParseStats> parse_stats_
+      ABSL_GUARDED_BY(mu_);
 
   // Map of existing xDS server channels.
   // Key is owned by the bootstrap config.
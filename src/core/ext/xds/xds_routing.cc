@@ -29,8 +29,10 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "re2/re2.h"
 
 #include <grpc/support/log.h>
 
@@ -137,6 +139,66 @@ absl::optional<size_t> XdsRouting::FindVirtualHostForDomain(
   return target_index;
 }
 
+//
+// XdsRouting::VirtualHostIndex
+//
+
+XdsRouting::VirtualHostIndex::VirtualHostIndex(
+    const VirtualHostListIterator& vhost_iterator) {
+  for (size_t i = 0; i < vhost_iterator.Size(); ++i) {
+    for (const std::string& domain_pattern :
+         vhost_iterator.GetDomainsForVirtualHost(i)) {
+      const MatchType match_type = DomainPatternMatchType(domain_pattern);
+      // This should be caught by RouteConfigParse().
+      GPR_ASSERT(match_type != INVALID_MATCH);
+      std::string pattern = absl::AsciiStrToLower(domain_pattern);
+      switch (match_type) {
+        case EXACT_MATCH:
+          exact_.emplace(std::move(pattern), i);
+          break;
+        case SUFFIX_MATCH:
+          pattern.erase(0, 1);
+          max_suffix_size_ = std::max(max_suffix_size_, pattern.size());
+          suffixes_.emplace(std::move(pattern), i);
+          break;
+        case PREFIX_MATCH:
+          pattern.pop_back();
+          max_prefix_size_ = std::max(max_prefix_size_, pattern.size());
+          prefixes_.emplace(std::move(pattern), i);
+          break;
+        case UNIVERSE_MATCH:
+          if (!universe_.has_value()) universe_ = i;
+          break;
+        case INVALID_MATCH:
+          break;
+      }
+    }
+  }
+}
+
+absl::optional<size_t> XdsRouting::VirtualHostIndex::Find(
+    absl::string_view domain) const {
+  // Same search order as FindVirtualHostForDomain(): exact, then longest
+  // suffix, then longest prefix, then universe.  The asterisk must match at
+  // least one char, so a pattern can cover at most domain.size() - 1 chars.
+  const std::string host = absl::AsciiStrToLower(domain);
+  auto it = exact_.find(host);
+  if (it != exact_.end()) return it->second;
+  if (host.empty()) return universe_;
+  absl::string_view host_view = host;
+  for (size_t size = std::min(max_suffix_size_, host.size() - 1); size > 0;
+       --size) {
+    it = suffixes_.find(host_view.substr(host.size() - size));
+    if (it != suffixes_.end()) return it->second;
+  }
+  for (size_t size = std::min(max_prefix_size_, host.size() - 1); size > 0;
+       --size) {
+    it = prefixes_.find(host_view.substr(0, size));
+    if (it != prefixes_.end()) return it->second;
+  }
+  return universe_;
+}
+
 namespace {
 
 bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
@@ -175,6 +237,138 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+//
+// XdsRouting::RouteIndex
+//
+
+XdsRouting::RouteIndex::RouteIndex(
+    const RouteListIterator& route_list_iterator) {
+  std::vector<size_t> regex_routes;
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+        if (path_matcher.case_sensitive()) {
+          exact_[path_matcher.string_matcher()].push_back(i);
+        } else {
+          exact_ignore_case_[absl::AsciiStrToLower(
+                                 path_matcher.string_matcher())]
+              .push_back(i);
+          has_ignore_case_ = true;
+        }
+        break;
+      case StringMatcher::Type::kPrefix:
+        if (path_matcher.case_sensitive()) {
+          AddPrefix(&prefixes_, path_matcher.string_matcher(), i);
+        } else {
+          AddPrefix(&prefixes_ignore_case_,
+                    absl::AsciiStrToLower(path_matcher.string_matcher()), i);
+          has_ignore_case_ = true;
+        }
+        break;
+      case StringMatcher::Type::kSafeRegex:
+        regex_routes.push_back(i);
+        break;
+      default:
+        unindexed_.push_back(i);
+        break;
+    }
+  }
+  if (regex_routes.empty()) return;
+  // Route matchers use full matches with the default options.
+  regexes_ = std::make_unique<RE2::Set>(RE2::DefaultOptions, RE2::ANCHOR_BOTH);
+  for (size_t route : regex_routes) {
+    const RE2* regex =
+        route_list_iterator.GetMatchersForRoute(route).path_matcher
+            .regex_matcher();
+    if (regexes_->Add(regex->pattern(), nullptr) < 0) {
+      unindexed_.push_back(route);
+    } else {
+      regex_routes_.push_back(route);
+    }
+  }
+  if (regex_routes_.empty() || !regexes_->Compile()) {
+    unindexed_.insert(unindexed_.end(), regex_routes_.begin(),
+                      regex_routes_.end());
+    regexes_.reset();
+    regex_routes_.clear();
+  }
+}
+
+void XdsRouting::RouteIndex::AddPrefix(PrefixTrieNode* root,
+                                       absl::string_view prefix,
+                                       size_t route) {
+  PrefixTrieNode* node = root;
+  for (char c : prefix) {
+    auto& child = node->children[c];
+    if (child == nullptr) child = std::make_unique<PrefixTrieNode>();
+    node = child.get();
+  }
+  node->routes.push_back(route);
+}
+
+void XdsRouting::RouteIndex::LookupPrefixes(
+    const PrefixTrieNode& root, absl::string_view path,
+    std::vector<std::pair<size_t, bool>>* routes) {
+  const PrefixTrieNode* node = &root;
+  for (size_t i = 0;; ++i) {
+    for (size_t route : node->routes) routes->emplace_back(route, true);
+    if (i == path.size()) break;
+    auto child = node->children.find(path[i]);
+    if (child == node->children.end()) break;
+    node = child->second.get();
+  }
+}
+
+absl::optional<size_t> XdsRouting::RouteIndex::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  // Routes that may match, each with whether its path matcher is already
+  // known to match.
+  std::vector<std::pair<size_t, bool>> candidates;
+  auto add_exact = [&](const absl::flat_hash_map<std::string,
+                                                 std::vector<size_t>>& exact,
+                       absl::string_view key) {
+    auto it = exact.find(key);
+    if (it == exact.end()) return;
+    for (size_t route : it->second) candidates.emplace_back(route, true);
+  };
+  add_exact(exact_, path);
+  LookupPrefixes(prefixes_, path, &candidates);
+  if (has_ignore_case_) {
+    const std::string lower_path = absl::AsciiStrToLower(path);
+    add_exact(exact_ignore_case_, lower_path);
+    LookupPrefixes(prefixes_ignore_case_, lower_path, &candidates);
+  }
+  if (regexes_ != nullptr) {
+    std::vector<int> matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regexes_->Match(re2::StringPiece(path.data(), path.size()), &matches,
+                        &error_info)) {
+      for (int match : matches) {
+        candidates.emplace_back(regex_routes_[match], true);
+      }
+    } else if (error_info.kind != RE2::Set::kNoError) {
+      // The DFA ran out of memory; match the regexes one by one instead.
+      for (size_t route : regex_routes_) candidates.emplace_back(route, false);
+    }
+  }
+  for (size_t route : unindexed_) candidates.emplace_back(route, false);
+  std::sort(candidates.begin(), candidates.end());
+  for (const auto& candidate : candidates) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(candidate.first);
+    if ((candidate.second || matchers.path_matcher.Match(path)) &&
+        HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return candidate.first;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
@@ -24,12 +24,16 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "re2/set.h"
 
 #include "src/core/ext/xds/xds_http_filters.h"
 #include "src/core/ext/xds/xds_listener.h"
@@ -71,6 +75,75 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // Domain lookup table for a list of virtual hosts.  Building it once per
+  // RouteConfiguration update makes each lookup a handful of hash table
+  // probes instead of a match against every domain pattern.
+  class VirtualHostIndex {
+   public:
+    VirtualHostIndex() = default;
+    explicit VirtualHostIndex(const VirtualHostListIterator& vhost_iterator);
+
+    // Returns the same result as FindVirtualHostForDomain() would for the
+    // list this index was built from.
+    absl::optional<size_t> Find(absl::string_view domain) const;
+
+   private:
+    // Keys are lower-cased patterns, without the asterisk for suffix and
+    // prefix patterns.  Values are the first virtual host with the pattern.
+    absl::flat_hash_map<std::string, size_t> exact_;
+    absl::flat_hash_map<std::string, size_t> suffixes_;
+    absl::flat_hash_map<std::string, size_t> prefixes_;
+    size_t max_suffix_size_ = 0;
+    size_t max_prefix_size_ = 0;
+    absl::optional<size_t> universe_;
+  };
+
+  // Precompiled form of a route list.  Building it once per update lets
+  // GetRouteForRequest() skip the routes whose path matcher cannot match:
+  // exact paths are looked up in a hash table, path prefixes in a trie and
+  // regexes are all evaluated in a single pass of an RE2::Set.  Header
+  // matchers and runtime fractions are then only evaluated for the remaining
+  // routes, in route order.
+  class RouteIndex {
+   public:
+    RouteIndex() = default;
+    explicit RouteIndex(const RouteListIterator& route_list_iterator);
+
+    // Returns the same result as the static GetRouteForRequest() would for
+    // \a route_list_iterator, which must iterate over the same routes that
+    // this index was built from.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    struct PrefixTrieNode {
+      // Routes with a prefix ending at this node.
+      std::vector<size_t> routes;
+      std::map<char, std::unique_ptr<PrefixTrieNode>> children;
+    };
+
+    static void AddPrefix(PrefixTrieNode* root, absl::string_view prefix,
+                          size_t route);
+    // Appends the routes with a prefix of path to \a routes.
+    static void LookupPrefixes(const PrefixTrieNode& root,
+                               absl::string_view path,
+                               std::vector<std::pair<size_t, bool>>* routes);
+
+    // Case-sensitive and case-insensitive (lower-cased) exact paths.
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_;
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_ignore_case_;
+    PrefixTrieNode prefixes_;
+    PrefixTrieNode prefixes_ignore_case_;
+    bool has_ignore_case_ = false;
+    // Maps the indices of regexes_ to routes.
+    std::unique_ptr<RE2::Set> regexes_;
+    std::vector<size_t> regex_routes_;
+    // Routes whose path matcher could not be indexed; their path matcher is
+    // evaluated for every request.
+    std::vector<size_t> unindexed_;
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
@@ -349,6 +349,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    XdsRouting::RouteIndex route_index;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -369,6 +370,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   };
 
   std::vector<VirtualHost> virtual_hosts_;
+  XdsRouting::VirtualHostIndex virtual_host_index_;
 };
 
 // An XdsServerConfigSelectorProvider implementation for when the
@@ -1185,7 +1187,11 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
             ServiceConfigImpl::Create(result->args, json.c_str()).value();
       }
     }
+    virtual_host.route_index = XdsRouting::RouteIndex(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
+  config_selector->virtual_host_index_ = XdsRouting::VirtualHostIndex(
+      VirtualHostListIterator(&config_selector->virtual_hosts_));
   return config_selector;
 }
 
@@ -1203,15 +1209,14 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   }
   absl::string_view authority =
       metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&virtual_hosts_), authority);
+  auto vhost_index = virtual_host_index_.Find(authority);
   if (!vhost_index.has_value()) {
     return absl::UnavailableError(
         absl::StrCat("could not find VirtualHost for ", authority,
                      " in RouteConfiguration"));
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = virtual_host.route_index.GetRouteForRequest(
       VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
@@ -28,8 +28,54 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 
+#include <grpc/support/time.h>
+
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gpr/time_precise.h"
+
 namespace grpc_core {
 
+namespace {
+constexpr uint32_t kQueueTimeSamplePeriod = 64;
+thread_local uint32_t g_items_until_queue_time_sample = 0;
+thread_local uint32_t g_items_until_queue_depth_sample = 0;
+}  // namespace
+
+bool SampleQueueDepth() {
+  if (!IsQueueTimeSamplingEnabled()) return false;
+  if (g_items_until_queue_depth_sample > 0) {
+    --g_items_until_queue_depth_sample;
+    return false;
+  }
+  g_items_until_queue_depth_sample = kQueueTimeSamplePeriod - 1;
+  return true;
+}
+
+void QueueTimeSampler::OnQueued(const void* item) {
+  if (!IsQueueTimeSamplingEnabled()) return;
+  if (g_items_until_queue_time_sample > 0) {
+    --g_items_until_queue_time_sample;
+    return;
+  }
+  if (timed_item_.load(std::memory_order_acquire) != nullptr) return;
+  g_items_until_queue_time_sample = kQueueTimeSamplePeriod - 1;
+  const gpr_cycle_counter now = gpr_get_cycle_counter();
+  const void* expected = nullptr;
+  if (timed_item_.compare_exchange_strong(expected, item,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+    queued_at_ = static_cast<int64_t>(now);
+  }
+}
+
+bool QueueTimeSampler::OnDequeued(const void* item, int* micros) {
+  if (item != timed_item_.load(std::memory_order_relaxed)) return false;
+  *micros = static_cast<int>(gpr_timespec_to_micros(gpr_cycle_counter_sub(
+      gpr_get_cycle_counter(), static_cast<gpr_cycle_counter>(queued_at_))));
+  timed_item_.store(nullptr, std::memory_order_release);
+  return true;
+}
+
 namespace stats_detail {
 
 namespace {
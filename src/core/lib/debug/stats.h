@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,30 @@ inline GlobalStatsCollector& global_stats() {
   return *NoDestructSingleton<GlobalStatsCollector>::Get();
 }
 
+// Whether the item being queued now should count in a *_queue_depth
+// histogram: with the queue_time_sampling experiment, one in 64 of the items
+// queued by a thread does, so that queueing stays cheap.
+bool SampleQueueDepth();
+
+// Measures how long the items of a queue wait before they run, for a
+// *_time_in_queue histogram, with the queue_time_sampling experiment. Reading
+// the clock costs about as much as queueing an item, so only one in 64 of the
+// items queued by a thread is timed, and one at a time per queue.
+class QueueTimeSampler {
+ public:
+  // Called just before item is queued: starts timing it if it is sampled.
+  void OnQueued(const void* item);
+  // Called once item is dequeued to run: if it was timed, sets *micros to the
+  // microseconds it spent queued and returns true.
+  bool OnDequeued(const void* item, int* micros);
+
+ private:
+  // The item being timed, and when it was queued. The queue orders the
+  // write of queued_at_ before its read.
+  std::atomic<const void*> timed_item_{nullptr};
+  int64_t queued_at_;
+};
+
 namespace stats_detail {
 std::string StatsAsJson(absl::Span<const uint64_t> counters,
                         absl::Span<const absl::string_view> counter_name,
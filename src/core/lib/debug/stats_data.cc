@@ -82,6 +82,9 @@ const absl::string_view
         "syscall_read",
         "tcp_read_alloc_8k",
         "tcp_read_alloc_64k",
+        "slice_pool_allocs",
+        "slice_pool_mallocs",
+        "combiner_locks_offloaded",
         "http2_settings_writes",
         "http2_pings_sent",
         "http2_writes_begun",
@@ -103,6 +106,10 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of 8k allocations by the TCP subsystem for reading",
     "Number of 64k allocations by the TCP subsystem for reading",
+    "Number of slices allocated from the slice pool",
+    "Number of slices allocated from the slice pool that the pool had no free "
+    "block for, and allocated from the system allocator",
+    "Number of times a combiner handed its queued closures to the executor",
     "Number of settings frames sent",
     "Number of HTTP2 pings sent by process",
     "Number of HTTP2 writes initiated",
@@ -119,8 +126,17 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
 };
 const absl::string_view
     GlobalStats::histogram_name[static_cast<int>(Histogram::COUNT)] = {
-        "call_initial_size",       "tcp_write_size", "tcp_write_iov_size",
-        "tcp_read_size",           "tcp_read_offer", "tcp_read_offer_iov_size",
+        "call_initial_size",
+        "tcp_write_size",
+        "tcp_write_iov_size",
+        "tcp_read_size",
+        "tcp_read_offer",
+        "tcp_read_offer_iov_size",
+        "combiner_queue_depth",
+        "combiner_time_in_queue",
+        "combiner_batch_size",
+        "work_serializer_queue_depth",
+        "work_serializer_time_in_queue",
         "http2_send_message_size",
 };
 const absl::string_view
@@ -131,6 +147,19 @@ const absl::string_view
         "Number of bytes received by each syscall_read",
         "Number of bytes offered to each syscall_read",
         "Number of byte segments offered to each syscall_read",
+        "Number of closures already queued on a combiner when a closure is "
+        "queued, sampled for one in 64 closures queued by a thread",
+        "Microseconds between queueing and running a combiner closure, "
+        "sampled for one in 64 closures queued by a thread, and one in flight "
+        "per combiner",
+        "Number of closures a combiner ran in one turn on an exec_ctx, before "
+        "running out of work or offloading it",
+        "Number of callbacks already queued on a WorkSerializer when a "
+        "callback is run or scheduled on it, sampled for one in 64 callbacks "
+        "queued by a thread",
+        "Microseconds between queueing and running a WorkSerializer callback "
+        "that could not run inline, sampled for one in 64 callbacks queued by "
+        "a thread",
         "Size of messages received by HTTP2 transport",
 };
 namespace {
@@ -221,6 +250,9 @@ GlobalStats::GlobalStats()
       syscall_read{0},
       tcp_read_alloc_8k{0},
       tcp_read_alloc_64k{0},
+      slice_pool_allocs{0},
+      slice_pool_mallocs{0},
+      combiner_locks_offloaded{0},
       http2_settings_writes{0},
       http2_pings_sent{0},
       http2_writes_begun{0},
@@ -251,6 +283,21 @@ HistogramView GlobalStats::histogram(Histogram which) const {
     case Histogram::kTcpReadOfferIovSize:
       return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
                            tcp_read_offer_iov_size.buckets()};
+    case Histogram::kCombinerQueueDepth:
+      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
+                           combiner_queue_depth.buckets()};
+    case Histogram::kCombinerTimeInQueue:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           combiner_time_in_queue.buckets()};
+    case Histogram::kCombinerBatchSize:
+      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
+                           combiner_batch_size.buckets()};
+    case Histogram::kWorkSerializerQueueDepth:
+      return HistogramView{&Histogram_80_10::BucketFor, kStatsTable4, 10,
+                           work_serializer_queue_depth.buckets()};
+    case Histogram::kWorkSerializerTimeInQueue:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           work_serializer_time_in_queue.buckets()};
     case Histogram::kHttp2SendMessageSize:
       return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
                            http2_send_message_size.buckets()};
@@ -275,6 +322,12 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.tcp_read_alloc_8k.load(std::memory_order_relaxed);
     result->tcp_read_alloc_64k +=
         data.tcp_read_alloc_64k.load(std::memory_order_relaxed);
+    result->slice_pool_allocs +=
+        data.slice_pool_allocs.load(std::memory_order_relaxed);
+    result->slice_pool_mallocs +=
+        data.slice_pool_mallocs.load(std::memory_order_relaxed);
+    result->combiner_locks_offloaded +=
+        data.combiner_locks_offloaded.load(std::memory_order_relaxed);
     result->http2_settings_writes +=
         data.http2_settings_writes.load(std::memory_order_relaxed);
     result->http2_pings_sent +=
@@ -297,6 +350,13 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
     data.tcp_read_size.Collect(&result->tcp_read_size);
     data.tcp_read_offer.Collect(&result->tcp_read_offer);
     data.tcp_read_offer_iov_size.Collect(&result->tcp_read_offer_iov_size);
+    data.combiner_queue_depth.Collect(&result->combiner_queue_depth);
+    data.combiner_time_in_queue.Collect(&result->combiner_time_in_queue);
+    data.combiner_batch_size.Collect(&result->combiner_batch_size);
+    data.work_serializer_queue_depth.Collect(
+        &result->work_serializer_queue_depth);
+    data.work_serializer_time_in_queue.Collect(
+        &result->work_serializer_time_in_queue);
     data.http2_send_message_size.Collect(&result->http2_send_message_size);
   }
   return result;
@@ -317,6 +377,10 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->syscall_read = syscall_read - other.syscall_read;
   result->tcp_read_alloc_8k = tcp_read_alloc_8k - other.tcp_read_alloc_8k;
   result->tcp_read_alloc_64k = tcp_read_alloc_64k - other.tcp_read_alloc_64k;
+  result->slice_pool_allocs = slice_pool_allocs - other.slice_pool_allocs;
+  result->slice_pool_mallocs = slice_pool_mallocs - other.slice_pool_mallocs;
+  result->combiner_locks_offloaded =
+      combiner_locks_offloaded - other.combiner_locks_offloaded;
   result->http2_settings_writes =
       http2_settings_writes - other.http2_settings_writes;
   result->http2_pings_sent = http2_pings_sent - other.http2_pings_sent;
@@ -334,6 +398,15 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->tcp_read_offer = tcp_read_offer - other.tcp_read_offer;
   result->tcp_read_offer_iov_size =
       tcp_read_offer_iov_size - other.tcp_read_offer_iov_size;
+  result->combiner_queue_depth =
+      combiner_queue_depth - other.combiner_queue_depth;
+  result->combiner_time_in_queue =
+      combiner_time_in_queue - other.combiner_time_in_queue;
+  result->combiner_batch_size = combiner_batch_size - other.combiner_batch_size;
+  result->work_serializer_queue_depth =
+      work_serializer_queue_depth - other.work_serializer_queue_depth;
+  result->work_serializer_time_in_queue =
+      work_serializer_time_in_queue - other.work_serializer_time_in_queue;
   result->http2_send_message_size =
       http2_send_message_size - other.http2_send_message_size;
   return result;
@@ -114,6 +114,9 @@ struct GlobalStats {
     kSyscallRead,
     kTcpReadAlloc8k,
     kTcpReadAlloc64k,
+    kSlicePoolAllocs,
+    kSlicePoolMallocs,
+    kCombinerLocksOffloaded,
     kHttp2SettingsWrites,
     kHttp2PingsSent,
     kHttp2WritesBegun,
@@ -131,6 +134,11 @@ struct GlobalStats {
     kTcpReadSize,
     kTcpReadOffer,
     kTcpReadOfferIovSize,
+    kCombinerQueueDepth,
+    kCombinerTimeInQueue,
+    kCombinerBatchSize,
+    kWorkSerializerQueueDepth,
+    kWorkSerializerTimeInQueue,
     kHttp2SendMessageSize,
     COUNT
   };
@@ -152,6 +160,9 @@ struct GlobalStats {
       uint64_t syscall_read;
       uint64_t tcp_read_alloc_8k;
       uint64_t tcp_read_alloc_64k;
+      uint64_t slice_pool_allocs;
+      uint64_t slice_pool_mallocs;
+      uint64_t combiner_locks_offloaded;
       uint64_t http2_settings_writes;
       uint64_t http2_pings_sent;
       uint64_t http2_writes_begun;
@@ -169,6 +180,11 @@ struct GlobalStats {
   Histogram_16777216_20 tcp_read_size;
   Histogram_16777216_20 tcp_read_offer;
   Histogram_80_10 tcp_read_offer_iov_size;
+  Histogram_80_10 combiner_queue_depth;
+  Histogram_16777216_20 combiner_time_in_queue;
+  Histogram_80_10 combiner_batch_size;
+  Histogram_80_10 work_serializer_queue_depth;
+  Histogram_16777216_20 work_serializer_time_in_queue;
   Histogram_16777216_20 http2_send_message_size;
   HistogramView histogram(Histogram which) const;
   std::unique_ptr<GlobalStats> Diff(const GlobalStats& other) const;
@@ -208,6 +224,17 @@ class GlobalStatsCollector {
   void IncrementTcpReadAlloc64k() {
     data_.this_cpu().tcp_read_alloc_64k.fetch_add(1, std::memory_order_relaxed);
   }
+  void IncrementSlicePoolAllocs() {
+    data_.this_cpu().slice_pool_allocs.fetch_add(1, std::memory_order_relaxed);
+  }
+  void IncrementSlicePoolMallocs() {
+    data_.this_cpu().slice_pool_mallocs.fetch_add(1,
+                                                  std::memory_order_relaxed);
+  }
+  void IncrementCombinerLocksOffloaded() {
+    data_.this_cpu().combiner_locks_offloaded.fetch_add(
+        1, std::memory_order_relaxed);
+  }
   void IncrementHttp2SettingsWrites() {
     data_.this_cpu().http2_settings_writes.fetch_add(1,
                                                      std::memory_order_relaxed);
@@ -254,6 +281,21 @@ class GlobalStatsCollector {
   void IncrementTcpReadOfferIovSize(int value) {
     data_.this_cpu().tcp_read_offer_iov_size.Increment(value);
   }
+  void IncrementCombinerQueueDepth(int value) {
+    data_.this_cpu().combiner_queue_depth.Increment(value);
+  }
+  void IncrementCombinerTimeInQueue(int value) {
+    data_.this_cpu().combiner_time_in_queue.Increment(value);
+  }
+  void IncrementCombinerBatchSize(int value) {
+    data_.this_cpu().combiner_batch_size.Increment(value);
+  }
+  void IncrementWorkSerializerQueueDepth(int value) {
+    data_.this_cpu().work_serializer_queue_depth.Increment(value);
+  }
+  void IncrementWorkSerializerTimeInQueue(int value) {
+    data_.this_cpu().work_serializer_time_in_queue.Increment(value);
+  }
   void IncrementHttp2SendMessageSize(int value) {
     data_.this_cpu().http2_send_message_size.Increment(value);
   }
@@ -269,6 +311,9 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> syscall_read{0};
     std::atomic<uint64_t> tcp_read_alloc_8k{0};
     std::atomic<uint64_t> tcp_read_alloc_64k{0};
+    std::atomic<uint64_t> slice_pool_allocs{0};
+    std::atomic<uint64_t> slice_pool_mallocs{0};
+    std::atomic<uint64_t> combiner_locks_offloaded{0};
     std::atomic<uint64_t> http2_settings_writes{0};
     std::atomic<uint64_t> http2_pings_sent{0};
     std::atomic<uint64_t> http2_writes_begun{0};
@@ -283,6 +328,11 @@ class GlobalStatsCollector {
     HistogramCollector_16777216_20 tcp_read_size;
     HistogramCollector_16777216_20 tcp_read_offer;
     HistogramCollector_80_10 tcp_read_offer_iov_size;
+    HistogramCollector_80_10 combiner_queue_depth;
+    HistogramCollector_16777216_20 combiner_time_in_queue;
+    HistogramCollector_80_10 combiner_batch_size;
+    HistogramCollector_80_10 work_serializer_queue_depth;
+    HistogramCollector_16777216_20 work_serializer_time_in_queue;
     HistogramCollector_16777216_20 http2_send_message_size;
   };
   PerCpu<Data> data_;
@@ -25,6 +25,8 @@
 #include <grpc/event_engine/memory_request.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/slice/slice_pool.h"
 #include "src/core/lib/slice/slice_refcount.h"
 
 namespace grpc_event_engine {
@@ -37,10 +39,11 @@ namespace {
 class SliceRefCount : public grpc_slice_refcount {
  public:
   SliceRefCount(std::shared_ptr<internal::MemoryAllocatorImpl> allocator,
-                size_t size)
+                size_t size, bool pooled)
       : grpc_slice_refcount(Destroy),
         allocator_(std::move(allocator)),
-        size_(size) {
+        size_(size),
+        pooled_(pooled) {
     // Nothing to do here.
   }
   ~SliceRefCount() { allocator_->Release(size_); }
@@ -48,20 +51,47 @@ class SliceRefCount : public grpc_slice_refcount {
  private:
   static void Destroy(grpc_slice_refcount* p) {
     auto* rc = static_cast<SliceRefCount*>(p);
+    const size_t size = rc->size_;
+    const bool pooled = rc->pooled_;
     rc->~SliceRefCount();
-    free(rc);
+    if (pooled) {
+      grpc_core::SlicePool::Free(rc, size);
+    } else {
+      free(rc);
+    }
   }
 
   std::shared_ptr<internal::MemoryAllocatorImpl> allocator_;
   size_t size_;
+  bool pooled_;
 };
 
+static_assert(sizeof(SliceRefCount) <= grpc_core::SlicePool::kHeaderSlop,
+              "slice pool size classes leave too little room for the refcount");
+
 }  // namespace
 
 grpc_slice MemoryAllocator::MakeSlice(MemoryRequest request) {
-  auto size = Reserve(request.Increase(sizeof(SliceRefCount)));
-  void* p = malloc(size);
-  new (p) SliceRefCount(allocator_, size);
+  request = request.Increase(sizeof(SliceRefCount));
+  const bool pooled = grpc_core::IsSlicePoolEnabled();
+  if (pooled) {
+    // The quota accounts for the whole block, including the bytes that round
+    // the slice up to its size class. Rounding the request up front makes the
+    // reservation land on a block size, unless memory pressure shrinks it.
+    request = MemoryRequest(grpc_core::SlicePool::BlockSize(request.min()),
+                            grpc_core::SlicePool::BlockSize(request.max()));
+  }
+  auto size = Reserve(request);
+  void* p;
+  size_t block_size = size;
+  if (pooled) {
+    block_size = grpc_core::SlicePool::BlockSize(size);
+    if (block_size > size) Reserve(block_size - size);
+    p = grpc_core::SlicePool::Alloc(size);
+  } else {
+    p = malloc(size);
+  }
+  new (p) SliceRefCount(allocator_, block_size, pooled);
   grpc_slice slice;
   slice.refcount = static_cast<SliceRefCount*>(p);
   slice.data.refcounted.bytes =
@@ -43,7 +43,8 @@ namespace posix_engine {
 
 struct Timer {
   int64_t deadline;
-  // kInvalidHeapIndex if not in heap.
+  // kInvalidHeapIndex if not in heap. TimerWheel keeps the wheel and slot
+  // that hold the timer here instead.
   size_t heap_index;
   bool pending;
   struct Timer* next;
@@ -70,7 +71,20 @@ class TimerListHost {
   ~TimerListHost() = default;
 };
 
-class TimerList {
+// The timer collection that TimerManager runs. TimerList and TimerWheel
+// implement it, and their methods document the contract.
+class TimerListInterface {
+ public:
+  virtual ~TimerListInterface() = default;
+
+  virtual void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                         experimental::EventEngine::Closure* closure) = 0;
+  virtual bool TimerCancel(Timer* timer) GRPC_MUST_USE_RESULT = 0;
+  virtual absl::optional<std::vector<experimental::EventEngine::Closure*>>
+  TimerCheck(grpc_core::Timestamp* next) = 0;
+};
+
+class TimerList : public TimerListInterface {
  public:
   explicit TimerList(TimerListHost* host);
 
@@ -85,7 +99,7 @@ class TimerList {
    about when to free up any user-level state. Behavior is undefined for a
    deadline of grpc_core::Timestamp::InfFuture(). */
   void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
-                 experimental::EventEngine::Closure* closure);
+                 experimental::EventEngine::Closure* closure) override;
 
   /* Note that there is no timer destroy function. This is because the
      timer is a one-time occurrence with a guarantee that the callback will
@@ -114,7 +128,7 @@ class TimerList {
      callbacks run inline matches this aim.
 
      Requires: cancel() must happen after init() on a given timer */
-  bool TimerCancel(Timer* timer) GRPC_MUST_USE_RESULT;
+  bool TimerCancel(Timer* timer) override GRPC_MUST_USE_RESULT;
 
   /* iomgr internal api for dealing with timers */
 
@@ -128,7 +142,7 @@ class TimerList {
      with high probability at least one thread in the system will see an update
      at any time slice. */
   absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
-      grpc_core::Timestamp* next);
+      grpc_core::Timestamp* next) override;
 
  private:
   /* A "timer shard". Contains a 'heap' and a 'list' of timers. All timers with
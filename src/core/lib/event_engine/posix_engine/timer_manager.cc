@@ -31,6 +31,8 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/thd.h"
 
 static thread_local bool g_timer_thread;
@@ -100,7 +102,11 @@ void TimerManager::StartMainLoopThread() {
 TimerManager::TimerManager(
     std::shared_ptr<grpc_event_engine::experimental::ThreadPool> thread_pool)
     : host_(this), thread_pool_(std::move(thread_pool)) {
-  timer_list_ = std::make_unique<TimerList>(&host_);
+  if (grpc_core::IsTimerWheelEnabled()) {
+    timer_list_ = std::make_unique<TimerWheel>(&host_);
+  } else {
+    timer_list_ = std::make_unique<TimerList>(&host_);
+  }
   main_loop_exit_signal_.emplace();
   StartMainLoopThread();
 }
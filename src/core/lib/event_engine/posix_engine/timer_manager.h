@@ -101,8 +101,9 @@ class TimerManager final : public grpc_event_engine::experimental::Forkable {
   bool kicked_ ABSL_GUARDED_BY(mu_) = false;
   // number of timer wakeups
   uint64_t wakeups_ ABSL_GUARDED_BY(mu_) = false;
-  // actual timer implementation
-  std::unique_ptr<TimerList> timer_list_;
+  // actual timer implementation: a TimerWheel if the timer_wheel experiment
+  // is enabled, a TimerList otherwise
+  std::unique_ptr<TimerListInterface> timer_list_;
   grpc_core::Thread main_thread_;
   std::shared_ptr<grpc_event_engine::experimental::ThreadPool> thread_pool_;
   absl::optional<grpc_core::Notification> main_loop_exit_signal_;
@@ -0,0 +1,289 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+namespace {
+
+// Index of the lowest set bit of bits, which must not be 0.
+int LowestSetBit(uint64_t bits) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int i = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++i;
+  }
+  return i;
+#endif
+}
+
+// Distance from slot first to the first occupied slot at or after it, going
+// around the wheel. occupied must not be 0.
+int64_t SlotsToNextOccupied(uint64_t occupied, uint64_t first) {
+  const int shift = static_cast<int>(first & 63);
+  const uint64_t rotated =
+      shift == 0 ? occupied : (occupied >> shift) | (occupied << (64 - shift));
+  return LowestSetBit(rotated);
+}
+
+void ListPush(Timer** head, Timer* timer) {
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+}
+
+void ListRemove(Timer** head, Timer* timer) {
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    *head = timer->next;
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+}
+
+}  // namespace
+
+constexpr size_t TimerWheel::kSlots;
+constexpr size_t TimerWheel::kOverflowPosition;
+constexpr size_t TimerWheel::kDuePosition;
+constexpr size_t TimerWheel::kPositions;
+
+void TimerWheel::Shard::Place(Timer* timer) {
+  size_t position = kDuePosition;
+  if (timer->deadline >= current) {
+    position = kOverflowPosition;
+    const int64_t delta = timer->deadline - current;
+    for (int level = 0; level < kLevels; ++level) {
+      if (delta < (int64_t{1} << (kBitsPerLevel * (level + 1)))) {
+        const uint64_t slot = (static_cast<uint64_t>(timer->deadline) >>
+                               (kBitsPerLevel * level)) &
+                              (kSlots - 1);
+        occupied[level] |= uint64_t{1} << slot;
+        position = level * kSlots + slot;
+        break;
+      }
+    }
+  }
+  timer->heap_index = index * kPositions + position;
+  ListPush(&slots[position], timer);
+}
+
+void TimerWheel::Shard::Unlink(Timer* timer) {
+  const size_t position = timer->heap_index % kPositions;
+  ListRemove(&slots[position], timer);
+  if (position < kOverflowPosition && slots[position] == nullptr) {
+    occupied[position / kSlots] &= ~(uint64_t{1} << (position % kSlots));
+  }
+}
+
+int64_t TimerWheel::Shard::NextEventTime() const {
+  if (num_timers == 0) return INT64_MAX;
+  // Due timers run at the next check, whenever it is.
+  if (slots[kDuePosition] != nullptr) return current - 1;
+  int64_t next = INT64_MAX;
+  // Level 0 slots hold the timers due in the next kSlots milliseconds.
+  if (occupied[0] != 0) {
+    next = current + SlotsToNextOccupied(occupied[0], current);
+  }
+  // Higher level slots are due when the wheel reaches the start of their
+  // span, the first one of which is the next span starting at or after
+  // current.
+  for (int level = 1; level < kLevels; ++level) {
+    if (occupied[level] == 0) continue;
+    const int shift = kBitsPerLevel * level;
+    const int64_t span = (current + (int64_t{1} << shift) - 1) >> shift;
+    next = std::min(
+        next, (span + SlotsToNextOccupied(occupied[level], span)) << shift);
+  }
+  if (slots[kOverflowPosition] != nullptr) {
+    const int shift = kBitsPerLevel * kLevels;
+    next = std::min(next, ((current + (int64_t{1} << shift) - 1) >> shift)
+                              << shift);
+  }
+  return next;
+}
+
+void TimerWheel::Shard::Cascade(int level) {
+  size_t position = kOverflowPosition;
+  if (level < kLevels) {
+    const uint64_t slot =
+        (static_cast<uint64_t>(current) >> (kBitsPerLevel * level)) &
+        (kSlots - 1);
+    if ((occupied[level] & (uint64_t{1} << slot)) == 0) return;
+    occupied[level] &= ~(uint64_t{1} << slot);
+    position = level * kSlots + slot;
+  }
+  Timer* timer = std::exchange(slots[position], nullptr);
+  while (timer != nullptr) {
+    Timer* next = timer->next;
+    Place(timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::Shard::Advance(
+    int64_t now, std::vector<experimental::EventEngine::Closure*>* out) {
+  auto run_list = [this, out](Timer* timer) {
+    while (timer != nullptr) {
+      timer->pending = false;
+      out->push_back(timer->closure);
+      --num_timers;
+      timer = timer->next;
+    }
+  };
+  run_list(std::exchange(slots[kDuePosition], nullptr));
+  for (;;) {
+    const int64_t next = NextEventTime();
+    if (next > now) break;
+    // Nothing is due before next, so the wheel can skip straight to it.
+    current = next;
+    // Cascade the higher levels first: their timers may land in the lower
+    // level slots that are due now.
+    for (int level = kLevels; level > 0; --level) {
+      if ((current & ((int64_t{1} << (kBitsPerLevel * level)) - 1)) == 0) {
+        Cascade(level);
+      }
+    }
+    const uint64_t slot = static_cast<uint64_t>(current) & (kSlots - 1);
+    if ((occupied[0] & (uint64_t{1} << slot)) != 0) {
+      occupied[0] &= ~(uint64_t{1} << slot);
+      run_list(std::exchange(slots[slot], nullptr));
+    }
+    ++current;
+  }
+  current = std::max(current, now + 1);
+}
+
+TimerWheel::TimerWheel(TimerListHost* host)
+    : host_(host),
+      num_shards_(grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u)),
+      shards_(new Shard[num_shards_]),
+      min_timer_(INT64_MAX) {
+  const int64_t now = host_->Now().milliseconds_after_process_epoch();
+  for (size_t i = 0; i < num_shards_; i++) {
+    grpc_core::MutexLock lock(&shards_[i].mu);
+    shards_[i].index = i;
+    shards_[i].current = now;
+  }
+}
+
+TimerWheel::Shard* TimerWheel::ShardForThisThread() {
+  static std::atomic<size_t> next_thread_index{0};
+  static thread_local size_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return &shards_[thread_index % num_shards_];
+}
+
+void TimerWheel::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                           experimental::EventEngine::Closure* closure) {
+  Shard* shard = ShardForThisThread();
+  timer->closure = closure;
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+  int64_t event_time;
+  {
+    grpc_core::MutexLock lock(&shard->mu);
+    const int64_t now = host_->Now().milliseconds_after_process_epoch();
+    // An empty wheel may have stopped being advanced long ago. Catch it up so
+    // that the timer goes straight to its final level.
+    if (shard->num_timers == 0) shard->current = std::max(shard->current, now);
+    timer->deadline = deadline.milliseconds_after_process_epoch();
+    timer->pending = true;
+    shard->Place(timer);
+    ++shard->num_timers;
+    event_time = shard->NextEventTime();
+    if (event_time >= shard->next_event.load(std::memory_order_relaxed)) {
+      return;
+    }
+    shard->next_event.store(event_time, std::memory_order_relaxed);
+  }
+  // The shard has something to do earlier than before. TimerCheck recomputes
+  // min_timer_ under mu_ too, so one of the two sees the new next_event.
+  grpc_core::MutexLock lock(&mu_);
+  if (event_time < min_timer_.load(std::memory_order_relaxed)) {
+    min_timer_.store(event_time, std::memory_order_relaxed);
+    host_->Kick();
+  }
+}
+
+bool TimerWheel::TimerCancel(Timer* timer) {
+  Shard* shard = &shards_[timer->heap_index / kPositions];
+  grpc_core::MutexLock lock(&shard->mu);
+  if (!timer->pending) return false;
+  timer->pending = false;
+  shard->Unlink(timer);
+  --shard->num_timers;
+  // next_event is left as is: it may now be early, which only costs the
+  // checker a look at this shard.
+  return true;
+}
+
+absl::optional<std::vector<experimental::EventEngine::Closure*>>
+TimerWheel::TimerCheck(grpc_core::Timestamp* next) {
+  const grpc_core::Timestamp now_ts = host_->Now();
+  const int64_t now = now_ts.milliseconds_after_process_epoch();
+  int64_t min_timer = min_timer_.load(std::memory_order_relaxed);
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next,
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+    }
+    return std::vector<experimental::EventEngine::Closure*>();
+  }
+  if (!checker_mu_.TryLock()) return absl::nullopt;
+  std::vector<experimental::EventEngine::Closure*> done;
+  for (size_t i = 0; i < num_shards_; i++) {
+    Shard& shard = shards_[i];
+    if (shard.next_event.load(std::memory_order_relaxed) > now) continue;
+    grpc_core::MutexLock lock(&shard.mu);
+    shard.Advance(now, &done);
+    shard.next_event.store(shard.NextEventTime(), std::memory_order_relaxed);
+  }
+  {
+    grpc_core::MutexLock lock(&mu_);
+    min_timer = INT64_MAX;
+    for (size_t i = 0; i < num_shards_; i++) {
+      min_timer = std::min(
+          min_timer, shards_[i].next_event.load(std::memory_order_relaxed));
+    }
+    min_timer_.store(min_timer, std::memory_order_relaxed);
+  }
+  checker_mu_.Unlock();
+  if (next != nullptr && min_timer != INT64_MAX) {
+    *next = std::min(
+        *next,
+        grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+  }
+  return std::move(done);
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
@@ -0,0 +1,122 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// A TimerListInterface built from hierarchical timing wheels, so that adding
+// and cancelling a timer are O(1) whatever the number of pending timers.
+//
+// Each wheel has kLevels levels of kSlots slots. A slot of level L holds the
+// timers due in one span of kSlots^L milliseconds, and is moved down to the
+// lower levels when the wheel reaches that span. Timers further away than the
+// top level covers wait in an overflow list that is looked at once per turn
+// of the top level.
+//
+// There is one wheel per shard, each with its own lock, and a thread always
+// adds its timers to the same wheel, so threads rarely contend on a lock to
+// add and cancel timers. TimerCheck only locks the wheels that have a timer
+// or a cascade due, and collects all of their expired timers at once.
+class TimerWheel : public TimerListInterface {
+ public:
+  explicit TimerWheel(TimerListHost* host);
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Same contracts as the TimerList methods. Timers are run at a granularity
+  // of one millisecond.
+  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                 experimental::EventEngine::Closure* closure) override;
+  bool TimerCancel(Timer* timer) override GRPC_MUST_USE_RESULT;
+  absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
+      grpc_core::Timestamp* next) override;
+
+ private:
+  static constexpr int kBitsPerLevel = 6;
+  static constexpr size_t kSlots = size_t{1} << kBitsPerLevel;
+  static constexpr int kLevels = 4;
+  // Positions of the timers in the overflow list, and in the list of timers
+  // added with a deadline the wheel already went past.
+  static constexpr size_t kOverflowPosition = kLevels * kSlots;
+  static constexpr size_t kDuePosition = kOverflowPosition + 1;
+  static constexpr size_t kPositions = kDuePosition + 1;
+
+  struct Shard {
+    // Adds a pending timer, relative to the current time of the wheel.
+    void Place(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    void Unlink(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // The time at which the wheel next has to fire or cascade a slot, or
+    // INT64_MAX if it holds no timer.
+    int64_t NextEventTime() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Moves the timers of the slot of level \a level due now to lower levels.
+    void Cascade(int level) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Runs the wheel up to \a now, appending the closures of the expired
+    // timers to \a out.
+    void Advance(int64_t now,
+                 std::vector<experimental::EventEngine::Closure*>* out)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+
+    grpc_core::Mutex mu;
+    size_t index = 0;
+    // The next millisecond to run. All pending timers but those of the due
+    // list are due at or after it.
+    int64_t current ABSL_GUARDED_BY(mu) = 0;
+    size_t num_timers ABSL_GUARDED_BY(mu) = 0;
+    // Heads of the doubly linked lists of timers of each slot, and of the
+    // overflow and due lists.
+    Timer* slots[kPositions] ABSL_GUARDED_BY(mu) = {};
+    // Bit s of occupied[L] is set if slots[L * kSlots + s] is not empty.
+    uint64_t occupied[kLevels] ABSL_GUARDED_BY(mu) = {};
+    // NextEventTime(), readable without the lock.
+    std::atomic<int64_t> next_event{INT64_MAX};
+  };
+
+  Shard* ShardForThisThread();
+
+  TimerListHost* const host_;
+  const size_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
+  // A lower bound of the next_event of all shards. Only lowered under mu_.
+  std::atomic<int64_t> min_timer_;
+  grpc_core::Mutex mu_;
+  // Allow only one TimerCheck at once.
+  grpc_core::Mutex checker_mu_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
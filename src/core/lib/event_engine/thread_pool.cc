@@ -141,7 +141,8 @@ bool ThreadPool::Queue::Step() {
   return true;
 }
 
-ThreadPool::ThreadPool() {
+ThreadPool::ThreadPool(unsigned reserve_threads)
+    : reserve_threads_(reserve_threads) {
   for (unsigned i = 0; i < reserve_threads_; i++) {
     StartThread(state_, StartThreadReason::kInitialPool);
   }
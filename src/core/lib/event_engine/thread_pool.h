@@ -43,7 +43,10 @@ namespace experimental {
 
 class ThreadPool final : public Forkable, public Executor {
  public:
-  ThreadPool();
+  ThreadPool() : ThreadPool(grpc_core::Clamp(gpr_cpu_num_cores(), 2u, 32u)) {}
+  // Keeps reserve_threads threads around instead of one per core, for callers
+  // whose callbacks block.
+  explicit ThreadPool(unsigned reserve_threads);
   // Asserts Quiesce was called.
   ~ThreadPool() override;
 
@@ -125,8 +128,7 @@ class ThreadPool final : public Forkable, public Executor {
   static void StartThread(StatePtr state, StartThreadReason reason);
   void Postfork();
 
-  const unsigned reserve_threads_ =
-      grpc_core::Clamp(gpr_cpu_num_cores(), 2u, 32u);
+  const unsigned reserve_threads_;
   const StatePtr state_ = std::make_shared<State>(reserve_threads_);
   std::atomic<bool> quiesced_{false};
 };
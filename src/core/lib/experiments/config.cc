@@ -91,6 +91,12 @@ GPR_ATTRIBUTE_NOINLINE Experiments LoadExperimentsFromConfigVariable() {
               std::string(experiment).c_str());
     }
   }
+  // Experiments forced by ForceEnableExperiment win over the config.
+  for (size_t i = 0; i < kNumExperiments; i++) {
+    if (g_forced_experiments[i].forced) {
+      experiments.enabled[i] = g_forced_experiments[i].value;
+    }
+  }
   return experiments;
 }
 }  // namespace
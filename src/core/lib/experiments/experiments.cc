@@ -51,6 +51,35 @@ const char* const description_promise_based_client_call =
     "(ie when all filters in a stack are promise based)";
 const char* const description_posix_event_engine_enable_polling =
     "If set, enables polling on the default posix event engine.";
+const char* const description_sharded_completion_queue =
+    "If set, completion queues of type GRPC_CQ_NEXT keep completed events in "
+    "per-thread shards, so that threads polling the same queue do not contend "
+    "on a single consumer lock.";
+const char* const description_timer_wheel =
+    "If set, the posix event engine keeps its timers in per-thread "
+    "hierarchical timing wheels instead of sharded heaps, making timer "
+    "creation and cancellation O(1).";
+const char* const description_per_cpu_memory_quota =
+    "If set, memory quotas keep per-CPU slabs of free memory that allocators "
+    "take from and return to in bulk, instead of all allocators updating a "
+    "single shared counter.";
+const char* const description_pressure_aware_buffer_sizing =
+    "If set, TCP read buffers and HTTP/2 BDP-based flow control windows start "
+    "shrinking gradually at 70% memory pressure, and are never larger than "
+    "without the experiment. Secure endpoint staging buffers shrink with "
+    "memory pressure like memory allocator reservations.";
+const char* const description_slice_pool =
+    "If set, slices allocated by memory allocators (such as TCP read buffers) "
+    "come from per-CPU caches of blocks in size classes, and go back to them "
+    "when unreferenced, instead of the system allocator.";
+const char* const description_pass_through_exec_ctx =
+    "If set, an ExecCtx created while another one is active on the thread (and "
+    "not flushing) passes through to it, queueing its closures there and "
+    "sharing its cached time, instead of installing and flushing its own.";
+const char* const description_queue_time_sampling =
+    "If set, combiners and work serializers sample the closures queued on "
+    "them for the combiner_queue_depth, combiner_time_in_queue, "
+    "work_serializer_queue_depth and work_serializer_time_in_queue stats.";
 #ifdef NDEBUG
 const bool kDefaultForDebugOnly = false;
 #else
@@ -78,6 +107,14 @@ const ExperimentMetadata g_experiment_metadata[] = {
     {"promise_based_client_call", description_promise_based_client_call, false},
     {"posix_event_engine_enable_polling",
      description_posix_event_engine_enable_polling, kDefaultForDebugOnly},
+    {"sharded_completion_queue", description_sharded_completion_queue, false},
+    {"timer_wheel", description_timer_wheel, false},
+    {"per_cpu_memory_quota", description_per_cpu_memory_quota, false},
+    {"pressure_aware_buffer_sizing", description_pressure_aware_buffer_sizing,
+     false},
+    {"slice_pool", description_slice_pool, false},
+    {"pass_through_exec_ctx", description_pass_through_exec_ctx, false},
+    {"queue_time_sampling", description_queue_time_sampling, false},
 };
 
 }  // namespace grpc_core
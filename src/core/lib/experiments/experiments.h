@@ -45,6 +45,17 @@ inline bool IsPromiseBasedClientCallEnabled() {
 inline bool IsPosixEventEngineEnablePollingEnabled() {
   return IsExperimentEnabled(11);
 }
+inline bool IsShardedCompletionQueueEnabled() {
+  return IsExperimentEnabled(12);
+}
+inline bool IsTimerWheelEnabled() { return IsExperimentEnabled(13); }
+inline bool IsPerCpuMemoryQuotaEnabled() { return IsExperimentEnabled(14); }
+inline bool IsPressureAwareBufferSizingEnabled() {
+  return IsExperimentEnabled(15);
+}
+inline bool IsSlicePoolEnabled() { return IsExperimentEnabled(16); }
+inline bool IsPassThroughExecCtxEnabled() { return IsExperimentEnabled(17); }
+inline bool IsQueueTimeSamplingEnabled() { return IsExperimentEnabled(18); }
 
 struct ExperimentMetadata {
   const char* name;
@@ -52,7 +63,7 @@ struct ExperimentMetadata {
   bool default_value;
 };
 
-constexpr const size_t kNumExperiments = 12;
+constexpr const size_t kNumExperiments = 19;
 extern const ExperimentMetadata g_experiment_metadata[kNumExperiments];
 
 }  // namespace grpc_core
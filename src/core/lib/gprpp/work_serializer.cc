@@ -21,16 +21,19 @@
 #include <stdint.h>
 
 #include <atomic>
-#include <functional>
 #include <memory>
+#include <new>
 #include <utility>
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
 
@@ -42,21 +45,12 @@ DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
-  void Run(std::function<void()> callback, const DebugLocation& location);
-  void Schedule(std::function<void()> callback, const DebugLocation& location);
+  bool TryAcquire(const DebugLocation& location);
+  void PushReserved(CallbackNode* node);
+  void ReserveAndPush(CallbackNode* node);
   void DrainQueue();
   void Orphan() override;
 
- private:
-  struct CallbackWrapper {
-    CallbackWrapper(std::function<void()> cb, const DebugLocation& loc)
-        : callback(std::move(cb)), location(loc) {}
-
-    MultiProducerSingleConsumerQueue::Node mpscq_node;
-    const std::function<void()> callback;
-    const DebugLocation location;
-  };
-
   // Callers of DrainQueueOwned should make sure to grab the lock on the
   // workserializer with
   //
@@ -69,6 +63,39 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // the lock to the work serializer.
   void DrainQueueOwned();
 
+ private:
+  // Links a callback into queue_, from its CallbackNode::queue_link.
+  struct QueueNode : public MultiProducerSingleConsumerQueue::Node {
+    explicit QueueNode(CallbackNode* callback) : callback(callback) {}
+    CallbackNode* const callback;
+  };
+  static_assert(sizeof(QueueNode) <= sizeof(CallbackNode::queue_link),
+                "QueueNode does not fit in CallbackNode::queue_link");
+  static_assert(alignof(QueueNode) <= alignof(void*),
+                "QueueNode is not aligned by CallbackNode::queue_link");
+
+  void Push(CallbackNode* node) {
+    queue_.Push(new (node->queue_link) QueueNode(node));
+  }
+
+  // Stats are per-CPU, and need an ExecCtx to tell which CPU: callers
+  // without one are not counted.
+  static void RecordQueueDepth(uint64_t prev_ref_pair) {
+    const uint64_t size = GetSize(prev_ref_pair);
+    if (size == 0 || ExecCtx::Get() == nullptr || !SampleQueueDepth()) return;
+    // Do not count the ref that tracks orphaning.
+    global_stats().IncrementWorkSerializerQueueDepth(
+        static_cast<int>(size - 1));
+  }
+  void RecordTimeInQueue(const CallbackNode* node) {
+    int time_in_queue;
+    if (!queue_time_sampler_.OnDequeued(node, &time_in_queue) ||
+        ExecCtx::Get() == nullptr) {
+      return;
+    }
+    global_stats().IncrementWorkSerializerTimeInQueue(time_in_queue);
+  }
+
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
   static uint64_t MakeRefPair(uint16_t owners, uint64_t size) {
@@ -86,10 +113,12 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  // Times callbacks for the work_serializer_time_in_queue histogram.
+  QueueTimeSampler queue_time_sampler_;
 };
 
-void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
-                                             const DebugLocation& location) {
+bool WorkSerializer::WorkSerializerImpl::TryAcquire(
+    const DebugLocation& location) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::Run() %p Scheduling callback [%s:%d]",
             this, location.file(), location.line());
@@ -100,37 +129,39 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
       refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
   // The work serializer should not have been orphaned.
   GPR_DEBUG_ASSERT(GetSize(prev_ref_pair) > 0);
+  RecordQueueDepth(prev_ref_pair);
   if (GetOwners(prev_ref_pair) == 0) {
-    // We took ownership of the WorkSerializer. Invoke callback and drain queue.
+    // We took ownership of the WorkSerializer: the caller invokes the callback
+    // and drains the queue.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
-    callback();
-    DrainQueueOwned();
-  } else {
-    // Another thread is holding the WorkSerializer, so decrement the ownership
-    // count we just added and queue the callback.
-    refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
-    CallbackWrapper* cb_wrapper =
-        new CallbackWrapper(std::move(callback), location);
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
-      gpr_log(GPR_INFO, "  Scheduling on queue : item %p", cb_wrapper);
-    }
-    queue_.Push(&cb_wrapper->mpscq_node);
+    return true;
+  }
+  // Another thread is holding the WorkSerializer, so decrement the ownership
+  // count we just added: the caller queues the callback.
+  refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
+  return false;
+}
+
+void WorkSerializer::WorkSerializerImpl::PushReserved(CallbackNode* node) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO, "  Scheduling on queue : item %p", node);
   }
+  queue_time_sampler_.OnQueued(node);
+  Push(node);
 }
 
-void WorkSerializer::WorkSerializerImpl::Schedule(
-    std::function<void()> callback, const DebugLocation& location) {
-  CallbackWrapper* cb_wrapper =
-      new CallbackWrapper(std::move(callback), location);
+void WorkSerializer::WorkSerializerImpl::ReserveAndPush(CallbackNode* node) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO,
             "WorkSerializer::Schedule() %p Scheduling callback %p [%s:%d]",
-            this, cb_wrapper, location.file(), location.line());
+            this, node, node->location.file(), node->location.line());
   }
-  refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
-  queue_.Push(&cb_wrapper->mpscq_node);
+  queue_time_sampler_.OnQueued(node);
+  RecordQueueDepth(
+      refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel));
+  Push(node);
 }
 
 void WorkSerializer::WorkSerializerImpl::Orphan() {
@@ -164,8 +195,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
-    CallbackWrapper* cb_wrapper = new CallbackWrapper([]() {}, DEBUG_LOCATION);
-    queue_.Push(&cb_wrapper->mpscq_node);
+    PushReserved(new CallbackNodeImpl<void (*)()>([]() {}, DEBUG_LOCATION));
   }
 }
 
@@ -174,6 +204,15 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
   while (true) {
+    // Fast path: nothing was queued while the last callback ran, and the work
+    // serializer is still alive. Give up ownership, dropping that callback's
+    // place in the queue, in a single step.
+    uint64_t idle = MakeRefPair(1, 2);
+    if (refs_.load(std::memory_order_relaxed) == idle &&
+        refs_.compare_exchange_strong(idle, MakeRefPair(0, 1),
+                                      std::memory_order_acq_rel)) {
+      return;
+    }
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
     // up orphaning the work serializer. In that case, delete the object.
@@ -203,9 +242,9 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     }
     // There is at least one callback on the queue. Pop the callback from the
     // queue and execute it.
-    CallbackWrapper* cb_wrapper = nullptr;
+    QueueNode* queue_node = nullptr;
     bool empty_unused;
-    while ((cb_wrapper = reinterpret_cast<CallbackWrapper*>(
+    while ((queue_node = static_cast<QueueNode*>(
                 queue_.PopAndCheckEnd(&empty_unused))) == nullptr) {
       // This can happen due to a race condition within the mpscq
       // implementation or because of a race with Run()/Schedule().
@@ -213,13 +252,13 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
         gpr_log(GPR_INFO, "  Queue returned nullptr, trying again");
       }
     }
+    CallbackNode* node = queue_node->callback;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Running item %p : callback scheduled at [%s:%d]",
-              cb_wrapper, cb_wrapper->location.file(),
-              cb_wrapper->location.line());
+              node, node->location.file(), node->location.line());
     }
-    cb_wrapper->callback();
-    delete cb_wrapper;
+    RecordTimeInQueue(node);
+    node->RunAndDelete();
   }
 }
 
@@ -232,16 +271,25 @@ WorkSerializer::WorkSerializer()
 
 WorkSerializer::~WorkSerializer() {}
 
-void WorkSerializer::Run(std::function<void()> callback,
-                         const DebugLocation& location) {
-  impl_->Run(std::move(callback), location);
+void WorkSerializer::DrainQueue() { impl_->DrainQueue(); }
+
+bool WorkSerializer::TryAcquire(WorkSerializerImpl* impl,
+                                const DebugLocation& location) {
+  return impl->TryAcquire(location);
 }
 
-void WorkSerializer::Schedule(std::function<void()> callback,
-                              const DebugLocation& location) {
-  impl_->Schedule(std::move(callback), location);
+void WorkSerializer::DrainQueueOwned(WorkSerializerImpl* impl) {
+  impl->DrainQueueOwned();
 }
 
-void WorkSerializer::DrainQueue() { impl_->DrainQueue(); }
+void WorkSerializer::PushReserved(WorkSerializerImpl* impl,
+                                  CallbackNode* node) {
+  impl->PushReserved(node);
+}
+
+void WorkSerializer::ReserveAndPush(WorkSerializerImpl* impl,
+                                    CallbackNode* node) {
+  impl->ReserveAndPush(node);
+}
 
 }  // namespace grpc_core
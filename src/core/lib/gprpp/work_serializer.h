@@ -19,7 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <functional>
+#include <utility>
 
 #include "absl/base/thread_annotations.h"
 
@@ -52,6 +52,9 @@ class ABSL_LOCKABLE WorkSerializer {
   // currently executing the WorkSerializer, the callback is run immediately. In
   // this case, the current thread is also borrowed for draining the queue for
   // any callbacks that get added in the meantime.
+  // A callback run immediately is called directly: nothing is allocated for
+  // it. A callback that has to be queued is moved into a single allocation
+  // that is also its queue node.
   //
   // If you want to use clang thread annotation to make sure that callback is
   // called by WorkSerializer only, you need to add the annotation to both the
@@ -67,20 +70,88 @@ class ABSL_LOCKABLE WorkSerializer {
   //
   // TODO(yashkt): Replace DebugLocation with absl::SourceLocation
   // once we can start using it directly.
-  void Run(std::function<void()> callback, const DebugLocation& location);
+  //
+  // Callbacks annotated as above are called from within Run(), which thread
+  // safety analysis cannot see holds the work serializer.
+  template <typename F>
+  void Run(F callback, const DebugLocation& location)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS;
 
   // Schedule \a callback to be run later when the queue of callbacks is
   // drained.
-  void Schedule(std::function<void()> callback, const DebugLocation& location);
+  template <typename F>
+  void Schedule(F callback, const DebugLocation& location);
   // Drains the queue of callbacks.
   void DrainQueue();
 
  private:
   class WorkSerializerImpl;
 
+  // A queued callback, with room for the node that links it into the queue,
+  // so that it is queued without another allocation.
+  class CallbackNode {
+   public:
+    explicit CallbackNode(const DebugLocation& loc) : location(loc) {}
+    virtual ~CallbackNode() = default;
+
+    // Runs the callback, then deletes the node.
+    virtual void RunAndDelete() = 0;
+
+    const DebugLocation location;
+    // Holds the queue node, which only work_serializer.cc knows the type of.
+    alignas(void*) char queue_link[2 * sizeof(void*)];
+  };
+
+  template <typename F>
+  class CallbackNodeImpl final : public CallbackNode {
+   public:
+    CallbackNodeImpl(F callback, const DebugLocation& location)
+        : CallbackNode(location), callback_(std::move(callback)) {}
+
+    void RunAndDelete() override ABSL_NO_THREAD_SAFETY_ANALYSIS {
+      callback_();
+      delete this;
+    }
+
+   private:
+    F callback_;
+  };
+
+  // These take the implementation rather than using impl_: a callback may
+  // destroy the WorkSerializer, but the implementation lives on until it is
+  // no longer owned.
+  // Takes a place in the queue for a callback run at location, and tries to
+  // take ownership of the work serializer. On success, the caller must run
+  // the callback and then call DrainQueueOwned(); otherwise it must pass the
+  // callback to PushReserved().
+  static bool TryAcquire(WorkSerializerImpl* impl,
+                         const DebugLocation& location);
+  static void DrainQueueOwned(WorkSerializerImpl* impl);
+  // Queues a callback whose place in the queue was taken by TryAcquire().
+  static void PushReserved(WorkSerializerImpl* impl, CallbackNode* node);
+  // Takes a place in the queue for a callback, and queues it.
+  static void ReserveAndPush(WorkSerializerImpl* impl, CallbackNode* node);
+
   OrphanablePtr<WorkSerializerImpl> impl_;
 };
 
+template <typename F>
+void WorkSerializer::Run(F callback, const DebugLocation& location) {
+  WorkSerializerImpl* impl = impl_.get();
+  if (TryAcquire(impl, location)) {
+    callback();
+    DrainQueueOwned(impl);
+  } else {
+    PushReserved(impl, new CallbackNodeImpl<F>(std::move(callback), location));
+  }
+}
+
+template <typename F>
+void WorkSerializer::Schedule(F callback, const DebugLocation& location) {
+  ReserveAndPush(impl_.get(),
+                 new CallbackNodeImpl<F>(std::move(callback), location));
+}
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_GPRPP_WORK_SERIALIZER_H
@@ -27,10 +27,20 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_batch_quota, 0,
+    "Maximum number of closures a combiner runs in one turn on a thread "
+    "before handing the rest to the executor. 0 leaves it to the combiner, "
+    "which hands them over when it is contended and the thread has other "
+    "work to finish.");
+
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
 #define GRPC_COMBINER_TRACE(fn)          \
@@ -51,8 +61,27 @@ static void combiner_finally_exec(grpc_core::Combiner* lock,
 
 static void offload(void* arg, grpc_error_handle error);
 
+static size_t default_batch_quota() {
+  static const size_t batch_quota = []() {
+    int32_t quota = GPR_GLOBAL_CONFIG_GET(grpc_combiner_batch_quota);
+    if (quota < 0) {
+      gpr_log(GPR_ERROR,
+              "Invalid GRPC_COMBINER_BATCH_QUOTA: %d, default value 0 will be "
+              "used.",
+              quota);
+      quota = 0;
+    }
+    return static_cast<size_t>(quota);
+  }();
+  return batch_quota;
+}
+
 grpc_core::Combiner* grpc_combiner_create(void) {
-  grpc_core::Combiner* lock = new grpc_core::Combiner();
+  return grpc_combiner_create(default_batch_quota());
+}
+
+grpc_core::Combiner* grpc_combiner_create(size_t batch_quota) {
+  grpc_core::Combiner* lock = new grpc_core::Combiner(batch_quota);
   gpr_ref_init(&lock->refs, 1);
   gpr_atm_no_barrier_store(&lock->state, STATE_UNORPHANED);
   grpc_closure_list_init(&lock->final_list);
@@ -103,6 +132,8 @@ grpc_core::Combiner* grpc_combiner_ref(
 }
 
 static void push_last_on_exec_ctx(grpc_core::Combiner* lock) {
+  // A new turn on this exec_ctx.
+  lock->closures_this_turn = 0;
   lock->next_combiner_on_this_exec_ctx = nullptr;
   if (grpc_core::ExecCtx::Get()->combiner_data()->active_combiner == nullptr) {
     grpc_core::ExecCtx::Get()->combiner_data()->active_combiner =
@@ -149,6 +180,11 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
   }
   GPR_ASSERT(last & STATE_UNORPHANED);  // ensure lock has not been destroyed
   assert(cl->cb);
+  if (grpc_core::SampleQueueDepth()) {
+    grpc_core::global_stats().IncrementCombinerQueueDepth(
+        static_cast<int>(last / STATE_ELEM_COUNT_LOW_BIT));
+  }
+  lock->queue_time_sampler.OnQueued(cl);
   cl->error_data.error = grpc_core::internal::StatusAllocHeapPtr(error);
   lock->queue.Push(cl->next_data.mpscq_node.get());
 }
@@ -168,8 +204,17 @@ static void offload(void* arg, grpc_error_handle /*error*/) {
   push_last_on_exec_ctx(lock);
 }
 
+// The combiner is done with this exec_ctx, having run closures_this_turn
+// closures: either it ran out of work, or it hands the rest to the executor.
+static void end_turn(size_t closures_this_turn) {
+  grpc_core::global_stats().IncrementCombinerBatchSize(
+      static_cast<int>(closures_this_turn));
+}
+
 static void queue_offload(grpc_core::Combiner* lock) {
   move_next();
+  end_turn(lock->closures_this_turn);
+  grpc_core::global_stats().IncrementCombinerLocksOffloaded();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   grpc_core::Executor::Run(&lock->offload, absl::OkStatus());
 }
@@ -188,18 +233,25 @@ bool grpc_combiner_continue_exec_ctx() {
                               "C:%p grpc_combiner_continue_exec_ctx "
                               "contended=%d "
                               "exec_ctx_ready_to_finish=%d "
-                              "time_to_execute_final_list=%d",
+                              "time_to_execute_final_list=%d "
+                              "closures_this_turn=%" PRIuPTR,
                               lock, contended,
                               grpc_core::ExecCtx::Get()->IsReadyToFinish(),
-                              lock->time_to_execute_final_list));
+                              lock->time_to_execute_final_list,
+                              lock->closures_this_turn));
 
   // offload only if all the following conditions are true:
-  // 1. the combiner is contended and has more than one closure to execute
-  // 2. the current execution context needs to finish as soon as possible
-  // 3. the current thread is not a worker for any background poller
-  // 4. the DEFAULT executor is threaded
-  if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
-      !grpc_iomgr_platform_is_any_background_poller_thread() &&
+  // 1. either the combiner has used up its batch quota for this turn, or, if
+  //    it has none, the combiner is contended and has more than one closure
+  //    to execute, and the current execution context needs to finish as soon
+  //    as possible
+  // 2. the current thread is not a worker for any background poller
+  // 3. the DEFAULT executor is threaded
+  const bool turn_over =
+      lock->batch_quota > 0
+          ? lock->closures_this_turn >= lock->batch_quota
+          : contended && grpc_core::ExecCtx::Get()->IsReadyToFinish();
+  if (turn_over && !grpc_iomgr_platform_is_any_background_poller_thread() &&
       grpc_core::Executor::IsThreadedDefault()) {
     // this execution context wants to move on: schedule remaining work to be
     // picked up on the executor
@@ -221,6 +273,11 @@ bool grpc_combiner_continue_exec_ctx() {
       return true;
     }
     grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
+    int time_in_queue;
+    if (lock->queue_time_sampler.OnDequeued(cl, &time_in_queue)) {
+      grpc_core::global_stats().IncrementCombinerTimeInQueue(time_in_queue);
+    }
+    ++lock->closures_this_turn;
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
@@ -237,6 +294,7 @@ bool grpc_combiner_continue_exec_ctx() {
       GRPC_COMBINER_TRACE(
           gpr_log(GPR_INFO, "C:%p execute_final[%d] c=%p", lock, loops, c));
       grpc_closure* next = c->next_data.next;
+      ++lock->closures_this_turn;
 #ifndef NDEBUG
       c->scheduled = false;
 #endif
@@ -250,6 +308,8 @@ bool grpc_combiner_continue_exec_ctx() {
 
   move_next();
   lock->time_to_execute_final_list = false;
+  // Once unlocked, the combiner may start a turn on another thread.
+  const size_t closures_this_turn = lock->closures_this_turn;
   gpr_atm old_state =
       gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(
@@ -273,9 +333,11 @@ bool grpc_combiner_continue_exec_ctx() {
       break;
     case OLD_STATE_WAS(false, 1):
       // had one count, one unorphaned --> unlocked unorphaned
+      end_turn(closures_this_turn);
       return true;
     case OLD_STATE_WAS(true, 1):
       // and one count, one orphaned --> unlocked and orphaned
+      end_turn(closures_this_turn);
       really_destroy(lock);
       return true;
     case OLD_STATE_WAS(false, 0):
@@ -25,6 +25,7 @@
 
 #include <grpc/support/atm.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
@@ -33,6 +34,8 @@ namespace grpc_core {
 // use ExecCtx
 class Combiner {
  public:
+  explicit Combiner(size_t batch_quota) : batch_quota(batch_quota) {}
+
   void Run(grpc_closure* closure, grpc_error_handle error);
   // TODO(yashkt) : Remove this method
   void FinallyRun(grpc_closure* closure, grpc_error_handle error);
@@ -51,6 +54,14 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // If non-zero, the combiner runs at most this many closures per turn on an
+  // exec_ctx, and then hands the rest to the executor. If zero, it hands them
+  // over when it is contended and the exec_ctx is ready to finish.
+  const size_t batch_quota;
+  // Closures run in the current turn.
+  size_t closures_this_turn = 0;
+  // Times closures for the combiner_time_in_queue histogram.
+  QueueTimeSampler queue_time_sampler;
 };
 }  // namespace grpc_core
 
@@ -60,8 +71,10 @@ class Combiner {
 // ever be one at a time).
 
 // Initialize the lock, with an optional workqueue to shift load to when
-// necessary
+// necessary. Its batch quota comes from GRPC_COMBINER_BATCH_QUOTA.
 grpc_core::Combiner* grpc_combiner_create(void);
+// Same, with the given batch quota (see Combiner::batch_quota).
+grpc_core::Combiner* grpc_combiner_create(size_t batch_quota);
 
 #ifndef NDEBUG
 #define GRPC_COMBINER_DEBUG_ARGS \
@@ -58,7 +58,10 @@ thread_local ApplicationCallbackExecCtx*
     ApplicationCallbackExecCtx::callback_exec_ctx_;
 
 bool ExecCtx::Flush() {
+  if (PassesThrough()) return Get()->Flush();
   bool did_something = false;
+  const bool was_flushing = flushing_;
+  flushing_ = true;
   for (;;) {
     if (!grpc_closure_list_empty(closure_list_)) {
       grpc_closure* c = closure_list_.head;
@@ -73,6 +76,7 @@ bool ExecCtx::Flush() {
       break;
     }
   }
+  flushing_ = was_flushing;
   GPR_ASSERT(combiner_data_.active_combiner == nullptr);
   return did_something;
 }
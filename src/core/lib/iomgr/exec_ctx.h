@@ -23,12 +23,15 @@
 
 #include <limits>
 
+#include "absl/types/optional.h"
+
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/fork.h"
@@ -85,6 +88,19 @@ class Combiner;
  *          ExecCtx on a thread's stack at the same time. The TODO below
  *          discusses this plan in more detail.
  *
+ *  With the pass_through_exec_ctx experiment, an ExecCtx made by the default
+ *  constructor while another one is active on the thread, and not flushing,
+ *  passes through to it (stage 1 below): closures go to the active ExecCtx,
+ *  which also runs them, and time read in the nested scope is cached by the
+ *  active ExecCtx. Nested entries into core, such as a C++ API call that
+ *  calls a core API, then cost next to nothing. An ExecCtx created while the
+ *  active one is flushing (from within a closure) is a full ExecCtx as before,
+ *  so that flushes never re-enter each other.
+ *  A pass-through ExecCtx does not flush when it goes out of scope: closures
+ *  scheduled in its scope run when the active ExecCtx flushes, which may be
+ *  well after the nested scope ends. Code that needs them run by the end of
+ *  the scope must call Flush() itself.
+ *
  * TODO(yashykt): Only allow one "active" ExecCtx on a thread at the same time.
  *                Stage 1: If a new one is created on the stack, it should just
  *                pass-through to the underlying ExecCtx deeper in the thread's
@@ -98,22 +114,29 @@ class ExecCtx {
   /** Default Constructor */
 
   ExecCtx() : flags_(GRPC_EXEC_CTX_FLAG_IS_FINISHED) {
+    if (last_exec_ctx_ != nullptr && !last_exec_ctx_->flushing_ &&
+        IsPassThroughExecCtxEnabled()) {
+      return;
+    }
+    time_cache_.emplace();
     Fork::IncExecCtxCount();
     Set(this);
   }
 
   /** Parameterised Constructor */
   explicit ExecCtx(uintptr_t fl) : flags_(fl) {
+    time_cache_.emplace();
     if (!(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD & flags_)) {
       Fork::IncExecCtxCount();
     }
     Set(this);
   }
 
-  /** Destructor */
+  /** Destructor: flushes, unless this ExecCtx passes through (see above) */
   virtual ~ExecCtx() {
+    if (PassesThrough()) return;
     flags_ |= GRPC_EXEC_CTX_FLAG_IS_FINISHED;
-    Flush();
+    if (HasWork()) Flush();
     Set(last_exec_ctx_);
     if (!(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD & flags_)) {
       Fork::DecExecCtxCount();
@@ -176,13 +199,20 @@ class ExecCtx {
   }
 
   Timestamp Now() { return Timestamp::Now(); }
-  void InvalidateNow() { time_cache_.InvalidateCache(); }
+  void InvalidateNow() {
+    if (PassesThrough()) return Get()->InvalidateNow();
+    time_cache_->InvalidateCache();
+  }
   void SetNowIomgrShutdown() {
+    if (PassesThrough()) return Get()->SetNowIomgrShutdown();
     // We get to do a test only set now on this path just because iomgr
     // is getting removed and no point adding more interfaces for it.
-    time_cache_.TestOnlySetNow(Timestamp::InfFuture());
+    time_cache_->TestOnlySetNow(Timestamp::InfFuture());
+  }
+  void TestOnlySetNow(Timestamp now) {
+    if (PassesThrough()) return Get()->TestOnlySetNow(now);
+    time_cache_->TestOnlySetNow(now);
   }
-  void TestOnlySetNow(Timestamp now) { time_cache_.TestOnlySetNow(now); }
 
   /** Gets pointer to current exec_ctx. */
   static ExecCtx* Get() { return exec_ctx_; }
@@ -203,13 +233,19 @@ class ExecCtx {
   /** Set exec_ctx_ to exec_ctx. */
   static void Set(ExecCtx* exec_ctx) { exec_ctx_ = exec_ctx; }
 
+  /** Whether this ExecCtx passes through to the active one (see above): it
+      is never made active itself, and has no time cache of its own. */
+  bool PassesThrough() const { return !time_cache_.has_value(); }
+
   grpc_closure_list closure_list_ = GRPC_CLOSURE_LIST_INIT;
   CombinerData combiner_data_ = {nullptr, nullptr};
   uintptr_t flags_;
+  /* Set while Flush() runs closures: nested ExecCtxs do not pass through */
+  bool flushing_ = false;
 
   unsigned starting_cpu_ = std::numeric_limits<unsigned>::max();
 
-  ScopedTimeCache time_cache_;
+  absl::optional<ScopedTimeCache> time_cache_;
   static thread_local ExecCtx* exec_ctx_;
   ExecCtx* last_exec_ctx_ = Get();
 };
@@ -1051,11 +1051,20 @@ static void maybe_make_read_slices(grpc_tcp* tcp)
       size_t allocate_length = tcp->min_progress_size;
       const size_t target_length = static_cast<size_t>(tcp->target_length);
       // If memory pressure is low and we think there will be more than
-      // min_progress_size bytes to read, allocate a bit more.
-      const bool low_memory_pressure =
-          tcp->memory_owner.GetPressureInfo().pressure_control_value < 0.8;
-      if (low_memory_pressure && target_length > allocate_length) {
-        allocate_length = target_length;
+      // min_progress_size bytes to read, allocate a bit more. With
+      // pressure_aware_buffer_sizing, that extra shrinks linearly from 70%
+      // pressure instead, and is gone at 80% all the same.
+      const double memory_pressure =
+          tcp->memory_owner.GetPressureInfo().pressure_control_value;
+      const bool low_memory_pressure = memory_pressure < 0.8;
+      if (target_length > allocate_length) {
+        if (grpc_core::IsPressureAwareBufferSizingEnabled()) {
+          allocate_length += static_cast<size_t>(
+              (target_length - allocate_length) *
+              grpc_core::Clamp((0.8 - memory_pressure) / 0.1, 0.0, 1.0));
+        } else if (low_memory_pressure) {
+          allocate_length = target_length;
+        }
       }
       int extra_wanted =
           allocate_length - static_cast<int>(tcp->incoming_buffer->length);
@@ -123,7 +123,8 @@ bool StringMatcher::Match(absl::string_view value) const {
                  : absl::StrContains(absl::AsciiStrToLower(value),
                                      absl::AsciiStrToLower(string_matcher_));
     case StringMatcher::Type::kSafeRegex:
-      return RE2::FullMatch(std::string(value), *regex_matcher_);
+      return RE2::FullMatch(re2::StringPiece(value.data(), value.size()),
+                            *regex_matcher_);
     default:
       return false;
   }
@@ -0,0 +1,240 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/promise/party.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/numeric/bits.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/atomic_utils.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+///////////////////////////////////////////////////////////////////////////////
+// PARTY HANDLE
+
+// Weak reference to a party, for non-owning wakers: wakes every participant of
+// the party, if the party still exists.
+class Party::Handle final : public Wakeable {
+ public:
+  explicit Handle(Party* party) : party_(party) {}
+
+  // Ref the Handle (not the party).
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Party is going away... drop its reference and sever the connection back.
+  void DropParty() ABSL_LOCKS_EXCLUDED(mu_) {
+    mu_.Lock();
+    GPR_ASSERT(party_ != nullptr);
+    party_ = nullptr;
+    mu_.Unlock();
+    Unref();
+  }
+
+  void Wakeup() override ABSL_LOCKS_EXCLUDED(mu_) {
+    mu_.Lock();
+    // The party refcount can drop to zero before DropParty is called, so only
+    // take a ref if it is non-zero.
+    if (party_ != nullptr && party_->RefIfNonzero()) {
+      Party* party = party_;
+      mu_.Unlock();
+      party->WakeupWithRef(kWakeupMask);
+    } else {
+      mu_.Unlock();
+    }
+    Unref();
+  }
+
+  void Drop() override { Unref(); }
+
+  std::string ActivityDebugTag() const override {
+    MutexLock lock(&mu_);
+    return party_ == nullptr ? "<unknown>" : party_->DebugTag();
+  }
+
+ private:
+  // Unref the Handle (not the party).
+  void Unref() {
+    if (1 == refs_.fetch_sub(1, std::memory_order_acq_rel)) {
+      delete this;
+    }
+  }
+
+  // Two initial refs: one for the waiter that caused instantiation, one for the
+  // party.
+  std::atomic<size_t> refs_{2};
+  mutable Mutex mu_;
+  Party* party_ ABSL_GUARDED_BY(mu_);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// PARTICIPANT WAKER
+
+void Party::ParticipantWaker::Wakeup() { party_->WakeupWithRef(mask_); }
+
+void Party::ParticipantWaker::Drop() { party_->Unref(); }
+
+std::string Party::ParticipantWaker::ActivityDebugTag() const {
+  return party_->DebugTag();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PARTY
+
+Party::Party() {
+  for (size_t i = 0; i < kMaxParticipants; i++) {
+    wakers_[i].party_ = this;
+    wakers_[i].mask_ = 1u << i;
+  }
+}
+
+Party::~Party() { DestroyParticipants(); }
+
+bool Party::RefIfNonzero() { return IncrementIfNonzero(&refs_); }
+
+void Party::PartyIsOver() {
+  if (handle_ != nullptr) handle_->DropParty();
+  PartyOver();
+}
+
+std::string Party::DebugTag() const {
+  return absl::StrFormat("PARTY[%p]", this);
+}
+
+void Party::Orphan() {
+  const uint64_t prev_state =
+      state_.fetch_or(kOrphaned | kLocked, std::memory_order_acq_rel);
+  // The owner's ref goes to the run that destroys the participants, or is
+  // dropped if the party is running already: that run will see kOrphaned.
+  if ((prev_state & kLocked) == 0) {
+    ScheduleWakeup();
+  } else {
+    Unref();
+  }
+}
+
+void Party::ForceImmediateRepoll() {
+  GPR_DEBUG_ASSERT(currently_polling_ != kNotPolling);
+  wake_after_poll_ |= uint64_t{1} << currently_polling_;
+}
+
+Waker Party::MakeOwningWaker() {
+  GPR_DEBUG_ASSERT(currently_polling_ != kNotPolling);
+  Ref();
+  return Waker(&wakers_[currently_polling_]);
+}
+
+Waker Party::MakeNonOwningWaker() {
+  if (handle_ == nullptr) {
+    handle_ = new Handle(this);
+  } else {
+    handle_->Ref();
+  }
+  return Waker(handle_);
+}
+
+void Party::WakeupWithRef(uint64_t mask) {
+  const uint64_t prev_state =
+      state_.fetch_or(mask | kLocked, std::memory_order_acq_rel);
+  if ((prev_state & kLocked) == 0) {
+    // We took the lock: the ref goes to the run.
+    ScheduleWakeup();
+  } else {
+    // The party is running, and will see the wakeup before it finishes.
+    Unref();
+  }
+}
+
+uint64_t Party::AddParticipant(Participant* participant) {
+  uint32_t allocated = allocated_.load(std::memory_order_acquire);
+  size_t slot;
+  do {
+    slot = absl::countr_zero(~allocated);
+    GPR_ASSERT(slot < kMaxParticipants);
+  } while (!allocated_.compare_exchange_weak(allocated, allocated | (1u << slot),
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+  // The caller's wakeup of the slot publishes the participant to the run.
+  participants_[slot].store(participant, std::memory_order_release);
+  return uint64_t{1} << slot;
+}
+
+Party::BulkSpawner::~BulkSpawner() {
+  if (wakeups_ == 0) return;
+  party_->Ref();
+  party_->WakeupWithRef(wakeups_);
+}
+
+void Party::DestroyParticipants() {
+  uint32_t allocated = allocated_.load(std::memory_order_acquire);
+  while (allocated != 0) {
+    const size_t i = absl::countr_zero(allocated);
+    allocated &= allocated - 1;
+    Participant* participant =
+        participants_[i].exchange(nullptr, std::memory_order_acquire);
+    if (participant == nullptr) continue;
+    delete participant;
+    allocated_.fetch_and(~(1u << i), std::memory_order_release);
+  }
+}
+
+void Party::RunParty() {
+  ScopedActivity activity(this);
+  while (true) {
+    const uint64_t prev_state =
+        state_.fetch_and(kLocked, std::memory_order_acq_rel);
+    if (prev_state & kOrphaned) orphaned_ = true;
+    if (orphaned_) {
+      // Also destroys participants spawned after the orphan.
+      wake_after_poll_ = 0;
+      DestroyParticipants();
+    } else {
+      uint64_t wakeups = (prev_state & kWakeupMask) | wake_after_poll_;
+      wake_after_poll_ = 0;
+      while (wakeups != 0) {
+        const size_t i = absl::countr_zero(wakeups);
+        wakeups &= wakeups - 1;
+        Participant* participant =
+            participants_[i].load(std::memory_order_acquire);
+        // A stale waker may wake a slot that has since emptied.
+        if (participant == nullptr) continue;
+        currently_polling_ = i;
+        const bool done = participant->Poll();
+        currently_polling_ = kNotPolling;
+        if (done) {
+          participants_[i].store(nullptr, std::memory_order_relaxed);
+          delete participant;
+          allocated_.fetch_and(~(1u << i), std::memory_order_release);
+        }
+      }
+      if (wake_after_poll_ != 0) continue;
+    }
+    // Release the lock, unless more wakeups (or an orphan) came in meanwhile.
+    uint64_t expected = kLocked;
+    if (state_.compare_exchange_strong(expected, 0, std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+      break;
+    }
+  }
+  // Drop the ref held by this run.
+  Unref();
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,235 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_PROMISE_PARTY_H
+#define GRPC_CORE_LIB_PROMISE_PARTY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "absl/types/variant.h"
+
+#include "src/core/lib/gprpp/construct_destruct.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/detail/promise_factory.h"
+#include "src/core/lib/promise/poll.h"
+
+namespace grpc_core {
+
+// A Party is an Activity with multiple participant promises.
+// Each participant is woken, and polled, on its own: waking one participant
+// does not repoll the others. This suits calls, whose send and receive halves
+// make progress independently.
+// Wakeups are recorded in a bitmask of participants. Whoever sets the first
+// bit while nobody runs the party takes the party lock and schedules a run;
+// the run polls the woken participants until no wakeups remain.
+// Participants are polled under the party lock, one at a time, so they need
+// no synchronization between themselves.
+class Party : public Activity {
+ public:
+  // Maximum number of participants at any one time.
+  static constexpr size_t kMaxParticipants = 16;
+
+  Party(const Party&) = delete;
+  Party& operator=(const Party&) = delete;
+
+  // Spawn one promise onto the party.
+  // The promise will be created from promise_factory the first time it is
+  // polled, and on_complete will be called with its result when it resolves.
+  // If the party is orphaned first, the promise is destroyed without calling
+  // on_complete.
+  // May be called from any thread, including by participants of this party.
+  template <typename Factory, typename OnComplete>
+  void Spawn(Factory promise_factory, OnComplete on_complete);
+
+  // Spawns several promises with a single wakeup of the party, when the
+  // spawner goes out of scope: cheaper than spawning them one at a time, for
+  // instance when setting up a call.
+  class BulkSpawner {
+   public:
+    explicit BulkSpawner(Party* party) : party_(party) {}
+    ~BulkSpawner();
+    BulkSpawner(const BulkSpawner&) = delete;
+    BulkSpawner& operator=(const BulkSpawner&) = delete;
+
+    template <typename Factory, typename OnComplete>
+    void Spawn(Factory promise_factory, OnComplete on_complete);
+
+   private:
+    Party* const party_;
+    uint64_t wakeups_ = 0;
+  };
+
+  // Cancel the party: all its participants are destroyed (from within a run of
+  // the party, to give them their contexts), and the owner's ref is dropped.
+  void Orphan() final;
+
+  // Activity implementation.
+  void ForceImmediateRepoll() final;
+  Waker MakeOwningWaker() final;
+  Waker MakeNonOwningWaker() final;
+  std::string DebugTag() const override;
+
+ protected:
+  Party();
+  ~Party() override;
+
+  // Arrange for RunParty() to be called at the earliest opportunity, from a
+  // place where the party can safely be run (for instance, not within another
+  // activity), and with any contexts its participants need.
+  virtual void ScheduleWakeup() = 0;
+  // Called when the last ref to the party is dropped: destroy it.
+  virtual void PartyOver() = 0;
+
+  // Poll the woken participants until there are no more wakeups, then drop
+  // the ref taken when the run was scheduled.
+  void RunParty();
+
+ private:
+  class Participant {
+   public:
+    // Poll the promise: return true if it completed (and the completion
+    // callback was called).
+    virtual bool Poll() = 0;
+    virtual ~Participant() = default;
+  };
+
+  template <typename SuppliedFactory, typename OnComplete>
+  class ParticipantImpl;
+
+  // Wakes one participant of a party. Owning wakers hold a ref to the party.
+  class ParticipantWaker final : public Wakeable {
+   public:
+    void Wakeup() override;
+    void Drop() override;
+    std::string ActivityDebugTag() const override;
+
+   private:
+    friend class Party;
+    Party* party_;
+    uint16_t mask_;
+  };
+
+  class Handle;
+
+  // Bits of state_.
+  // Wakeups pending, one bit per participant.
+  static constexpr uint64_t kWakeupMask = (1u << kMaxParticipants) - 1;
+  // Somebody is running, or has scheduled a run of, the party.
+  static constexpr uint64_t kLocked = 1u << kMaxParticipants;
+  // The party has been orphaned: participants must be destroyed.
+  static constexpr uint64_t kOrphaned = kLocked << 1;
+  // Value of currently_polling_ between polls.
+  static constexpr uint8_t kNotPolling = 255;
+
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+  void Unref() {
+    if (1 == refs_.fetch_sub(1, std::memory_order_acq_rel)) PartyIsOver();
+  }
+  bool RefIfNonzero();
+  void PartyIsOver();
+
+  // Flag wakeups for the participants in mask. The caller passes a ref to the
+  // party: it is kept by the run this schedules, if any, or dropped if the
+  // party is already running.
+  void WakeupWithRef(uint64_t mask);
+  // Put a participant in a free slot, and return the slot's wakeup bit.
+  uint64_t AddParticipant(Participant* participant);
+  void DestroyParticipants();
+
+  std::atomic<uint64_t> state_{0};
+  std::atomic<uint32_t> refs_{1};
+  // Participant slots that are in use.
+  std::atomic<uint32_t> allocated_{0};
+  // The remaining members are only accessed by the run of the party, with the
+  // party lock held (or once the party is over).
+  // Wakeups flagged by participants for themselves during this run.
+  uint64_t wake_after_poll_ = 0;
+  // Index of the participant being polled, or kNotPolling.
+  uint8_t currently_polling_ = kNotPolling;
+  // Set once the party has seen kOrphaned: no more polling.
+  bool orphaned_ = false;
+  // Written by Spawn when it claims a slot, so atomic.
+  std::atomic<Participant*> participants_[kMaxParticipants] = {};
+  ParticipantWaker wakers_[kMaxParticipants];
+  // Weak handle for non-owning wakers, created on demand.
+  Handle* handle_ = nullptr;
+};
+
+template <typename SuppliedFactory, typename OnComplete>
+class Party::ParticipantImpl final : public Party::Participant {
+  using Factory = promise_detail::OncePromiseFactory<void, SuppliedFactory>;
+  using Promise = typename Factory::Promise;
+
+ public:
+  ParticipantImpl(SuppliedFactory promise_factory, OnComplete on_complete)
+      : on_complete_(std::move(on_complete)) {
+    Construct(&factory_, std::move(promise_factory));
+  }
+  ~ParticipantImpl() override {
+    if (!started_) {
+      Destruct(&factory_);
+    } else {
+      Destruct(&promise_);
+    }
+  }
+
+  bool Poll() override {
+    if (!started_) {
+      auto p = factory_.Make();
+      Destruct(&factory_);
+      Construct(&promise_, std::move(p));
+      started_ = true;
+    }
+    auto p = promise_();
+    if (auto* r = absl::get_if<kPollReadyIdx>(&p)) {
+      on_complete_(std::move(*r));
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  union {
+    GPR_NO_UNIQUE_ADDRESS Factory factory_;
+    GPR_NO_UNIQUE_ADDRESS Promise promise_;
+  };
+  GPR_NO_UNIQUE_ADDRESS OnComplete on_complete_;
+  bool started_ = false;
+};
+
+template <typename Factory, typename OnComplete>
+void Party::Spawn(Factory promise_factory, OnComplete on_complete) {
+  const uint64_t wakeup = AddParticipant(new ParticipantImpl<Factory, OnComplete>(
+      std::move(promise_factory), std::move(on_complete)));
+  Ref();
+  WakeupWithRef(wakeup);
+}
+
+template <typename Factory, typename OnComplete>
+void Party::BulkSpawner::Spawn(Factory promise_factory,
+                               OnComplete on_complete) {
+  wakeups_ |= party_->AddParticipant(new ParticipantImpl<Factory, OnComplete>(
+      std::move(promise_factory), std::move(on_complete)));
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_PROMISE_PARTY_H
@@ -17,11 +17,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <new>
 #include <string>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 #include "absl/types/variant.h"
@@ -47,6 +50,10 @@ class Center;
 template <typename T>
 struct Pipe;
 
+// A batch of values moved through a pipe in one poll by PushBatch/NextBatch.
+template <typename T>
+using PipeBatch = absl::InlinedVector<T, 8>;
+
 // Result of Pipe::Next - represents a received value.
 // If has_value() is false, the pipe was closed by the time we polled for the
 // next value. No value was received, nor will there ever be.
@@ -91,19 +98,42 @@ namespace pipe_detail {
 template <typename T>
 class Push;
 template <typename T>
+class PushBatch;
+template <typename T>
 class Next;
+template <typename T>
+class NextBatch;
 
-// Center sits between a sender and a receiver to provide a one-deep buffer of
-// Ts
+// Center sits between a sender and a receiver to provide a buffer of Ts: one
+// deep by default, or up to a power of two capacity for pipes that move
+// batches.
+// Values are numbered in the order they are pushed, and stay in the buffer
+// until the receiver acks them. The buffer is a ring indexed by these numbers.
 template <typename T>
 class Center {
  public:
   // Initialize with one send ref (held by PipeSender) and one recv ref (held by
   // PipeReceiver)
-  Center() {
+  Center() : values_(&value_) {
     send_refs_ = 1;
     recv_refs_ = 1;
-    value_state_ = ValueState::kEmpty;
+    receive_mode_ = kAnyReceiveMode;
+  }
+
+  // Initialize with room for capacity values, allocated from arena.
+  Center(Arena* arena, uint8_t capacity) : Center() {
+    GPR_ASSERT(capacity != 0 && (capacity & (capacity - 1)) == 0);
+    capacity_ = capacity;
+    if (capacity > 1) {
+      values_ = static_cast<T*>(arena->Alloc(sizeof(T) * capacity));
+      for (uint8_t i = 0; i < capacity; i++) new (&values_[i]) T();
+    }
+  }
+
+  ~Center() {
+    if (values_ != &value_) {
+      for (uint8_t i = 0; i < capacity_; i++) values_[i].~T();
+    }
   }
 
   // Add one ref to the send side of this object, and return this.
@@ -158,12 +188,15 @@ class Center {
       on_empty_.Wake();
       if (0 == send_refs_) {
         this->~Center();
-      } else if (value_state_ == ValueState::kReady) {
-        ResetValue();
+      } else {
+        ResetValues();
       }
     }
   }
 
+  // Number that the next value pushed will have.
+  uint32_t next_push_seq() const { return num_pushed_; }
+
   // Try to push *value into the pipe.
   // Return Pending if there is no space.
   // Return true if the value was pushed.
@@ -174,22 +207,25 @@ class Center {
     }
     GPR_DEBUG_ASSERT(send_refs_ != 0);
     if (recv_refs_ == 0) return false;
-    if (value_state_ != ValueState::kEmpty) return on_empty_.pending();
-    value_state_ = ValueState::kReady;
-    value_ = std::move(*value);
+    if (num_queued() == capacity_) return on_empty_.pending();
+    slot(num_pushed_) = std::move(*value);
+    ++num_pushed_;
     on_full_.Wake();
     return true;
   }
 
-  Poll<bool> PollAck() {
+  // Poll for the receiver to have acked value number seq.
+  // Return true once it has.
+  // Return false if the recv end closed before it did.
+  Poll<bool> PollAck(uint32_t seq) {
     if (grpc_trace_promise_pipe.enabled()) {
       gpr_log(GPR_INFO, "%s", DebugOpString("PollAck").c_str());
     }
     GPR_DEBUG_ASSERT(send_refs_ != 0);
-    if (recv_refs_ == 0) return value_state_ == ValueState::kAcked;
-    if (value_state_ != ValueState::kAcked) return on_empty_.pending();
-    value_state_ = ValueState::kEmpty;
-    return true;
+    // Wraparound safe: at most capacity_ values are ever outstanding.
+    if (static_cast<int32_t>(num_acked_ - seq) > 0) return true;
+    if (recv_refs_ == 0) return false;
+    return on_empty_.pending();
   }
 
   // Try to receive a value from the pipe.
@@ -201,64 +237,92 @@ class Center {
       gpr_log(GPR_INFO, "%s", DebugOpString("Next").c_str());
     }
     GPR_DEBUG_ASSERT(recv_refs_ != 0);
-    if (value_state_ != ValueState::kReady) {
+    SetReceiveMode(kNextMode);
+    if (num_queued() == 0) {
       if (send_refs_ == 0) return NextResult<T>(nullptr);
       return on_full_.pending();
     }
     return NextResult<T>(RefRecv());
   }
 
+  // Try to receive all the queued values from the pipe, acking them at once.
+  // Return Pending if there is no value.
+  // Return the values if any were retrieved.
+  // Return nullopt if the send end is closed and no value had been pushed.
+  Poll<absl::optional<PipeBatch<T>>> NextBatch() {
+    if (grpc_trace_promise_pipe.enabled()) {
+      gpr_log(GPR_INFO, "%s", DebugOpString("NextBatch").c_str());
+    }
+    GPR_DEBUG_ASSERT(recv_refs_ != 0);
+    SetReceiveMode(kNextBatchMode);
+    if (num_queued() == 0) {
+      if (send_refs_ == 0) return absl::optional<PipeBatch<T>>();
+      return on_full_.pending();
+    }
+    PipeBatch<T> values;
+    values.reserve(num_queued());
+    for (; num_acked_ != num_pushed_; ++num_acked_) {
+      values.emplace_back(std::move(slot(num_acked_)));
+    }
+    on_empty_.Wake();
+    return absl::optional<PipeBatch<T>>(std::move(values));
+  }
+
   void AckNext() {
     if (grpc_trace_promise_pipe.enabled()) {
       gpr_log(GPR_INFO, "%s", DebugOpString("AckNext").c_str());
     }
-    GPR_DEBUG_ASSERT(value_state_ == ValueState::kReady);
-    value_state_ = ValueState::kAcked;
+    GPR_DEBUG_ASSERT(num_queued() != 0);
+    ++num_acked_;
     on_empty_.Wake();
     UnrefRecv();
   }
 
-  T& value() { return value_; }
-  const T& value() const { return value_; }
+  // The oldest value not yet acked.
+  T& value() { return slot(num_acked_); }
+  const T& value() const { return values_[num_acked_ & (capacity_ - 1)]; }
 
  private:
+  // How values are received. The first Next or NextBatch poll picks the mode
+  // of the pipe, and the other one must not be used after it: NextBatch would
+  // ack values that a NextResult still refers to.
+  enum ReceiveMode : uint8_t {
+    kAnyReceiveMode,
+    kNextMode,
+    kNextBatchMode,
+  };
+
+  void SetReceiveMode(ReceiveMode mode) {
+    GPR_ASSERT(receive_mode_ == kAnyReceiveMode || receive_mode_ == mode);
+    receive_mode_ = mode;
+  }
+
   std::string DebugTag() {
     return absl::StrCat(Activity::current()->DebugTag(), "PIPE[0x",
                         reinterpret_cast<uintptr_t>(this), "]: ");
   }
   std::string DebugOpString(std::string op) {
     return absl::StrCat(DebugTag(), op, " send_refs=", send_refs_,
-                        " recv_refs=", recv_refs_,
-                        " value_state=", ValueStateName(value_state_));
-  }
-  void ResetValue() {
-    // Fancy dance to move out of value in the off chance that we reclaim some
-    // memory earlier.
-    [](T) {}(std::move(value_));
-    value_state_ = ValueState::kEmpty;
-  }
-  // State of value_.
-  enum class ValueState : uint8_t {
-    // No value is set, it's possible to send.
-    kEmpty,
-    // Value has been pushed but not acked, it's possible to receive.
-    kReady,
-    // Value has been received and acked, we can unblock senders and transition
-    // to empty.
-    kAcked,
-  };
-  static const char* ValueStateName(ValueState state) {
-    switch (state) {
-      case ValueState::kEmpty:
-        return "kEmpty";
-      case ValueState::kReady:
-        return "kReady";
-      case ValueState::kAcked:
-        return "kAcked";
+                        " recv_refs=", recv_refs_, " queued=", num_queued(),
+                        "/", capacity_);
+  }
+  uint32_t num_queued() const { return num_pushed_ - num_acked_; }
+  T& slot(uint32_t seq) { return values_[seq & (capacity_ - 1)]; }
+  void ResetValues() {
+    // Fancy dance to move out of the values in the off chance that we reclaim
+    // some memory earlier. They are dropped, not acked: pushers see false.
+    for (uint32_t seq = num_acked_; seq != num_pushed_; ++seq) {
+      [](T) {}(std::move(slot(seq)));
     }
-    GPR_UNREACHABLE_CODE(return "unknown");
   }
   T value_;
+  // Ring buffer of capacity_ values: &value_ for one-deep pipes.
+  T* values_;
+  // Number of values pushed/acked so far: values numbered in
+  // [num_acked_, num_pushed_) are queued.
+  uint32_t num_pushed_ = 0;
+  uint32_t num_acked_ = 0;
+  uint8_t capacity_ = 1;
   // Number of sending objects.
   // 0 => send is closed.
   // 1 ref each for PipeSender and Push.
@@ -267,8 +331,8 @@ class Center {
   // 0 => recv is closed.
   // 1 ref each for PipeReceiver, Next, and NextResult.
   uint8_t recv_refs_ : 2;
-  // Current state of the value.
-  ValueState value_state_ : 2;
+  // ReceiveMode of the pipe.
+  uint8_t receive_mode_ : 2;
   IntraActivityWaiter on_empty_;
   IntraActivityWaiter on_full_;
 };
@@ -280,6 +344,7 @@ template <typename T>
 class PipeSender {
  public:
   using PushType = pipe_detail::Push<T>;
+  using PushBatchType = pipe_detail::PushBatch<T>;
 
   PipeSender(const PipeSender&) = delete;
   PipeSender& operator=(const PipeSender&) = delete;
@@ -310,6 +375,13 @@ class PipeSender {
   // receiver is either closed or able to receive another message.
   PushType Push(T value);
 
+  // Send a batch of messages along the pipe, in order, as many per poll as
+  // there is room for in the pipe.
+  // Returns a promise that will resolve to a bool - true if all the messages
+  // were received, false if some could never be. Blocks the promise until the
+  // receiver has received the last message.
+  PushBatchType PushBatch(PipeBatch<T> values);
+
  private:
   friend struct Pipe<T>;
   explicit PipeSender(pipe_detail::Center<T>* center) : center_(center) {}
@@ -321,6 +393,7 @@ template <typename T>
 class PipeReceiver {
  public:
   using NextType = pipe_detail::Next<T>;
+  using NextBatchType = pipe_detail::NextBatch<T>;
 
   PipeReceiver(const PipeReceiver&) = delete;
   PipeReceiver& operator=(const PipeReceiver&) = delete;
@@ -347,6 +420,14 @@ class PipeReceiver {
   // available.
   NextType Next();
 
+  // Receive all the messages queued in the pipe.
+  // Returns a promise that will resolve to an optional<PipeBatch<T>> - with at
+  // least one message if any were received, or no value if the other end of
+  // the pipe was closed. The messages are acked as soon as they are received.
+  // A receiver uses either Next or NextBatch: mixing them on one pipe is a
+  // fatal error.
+  NextBatchType NextBatch();
+
  private:
   friend struct Pipe<T>;
   explicit PipeReceiver(pipe_detail::Center<T>* center) : center_(center) {}
@@ -362,7 +443,9 @@ class Push {
   Push(const Push&) = delete;
   Push& operator=(const Push&) = delete;
   Push(Push&& other) noexcept
-      : center_(other.center_), push_(std::move(other.push_)) {
+      : center_(other.center_),
+        push_(std::move(other.push_)),
+        seq_(other.seq_) {
     other.center_ = nullptr;
   }
   Push& operator=(Push&& other) noexcept {
@@ -370,6 +453,7 @@ class Push {
     center_ = other.center_;
     other.center_ = nullptr;
     push_ = std::move(other.push_);
+    seq_ = other.seq_;
     return *this;
   }
 
@@ -379,6 +463,7 @@ class Push {
 
   Poll<bool> operator()() {
     if (push_.has_value()) {
+      seq_ = center_->next_push_seq();
       auto r = center_->Push(&*push_);
       if (auto* ok = absl::get_if<bool>(&r)) {
         push_.reset();
@@ -388,7 +473,7 @@ class Push {
       }
     }
     GPR_DEBUG_ASSERT(!push_.has_value());
-    return center_->PollAck();
+    return center_->PollAck(seq_);
   }
 
  private:
@@ -397,6 +482,59 @@ class Push {
       : center_(center), push_(std::move(push)) {}
   Center<T>* center_;
   absl::optional<T> push_;
+  // Number of the pushed value, to wait for its ack.
+  uint32_t seq_ = 0;
+};
+
+// Implementation of PipeSender::PushBatch promise.
+template <typename T>
+class PushBatch {
+ public:
+  PushBatch(const PushBatch&) = delete;
+  PushBatch& operator=(const PushBatch&) = delete;
+  PushBatch(PushBatch&& other) noexcept
+      : center_(std::exchange(other.center_, nullptr)),
+        values_(std::move(other.values_)),
+        num_pushed_(other.num_pushed_),
+        last_seq_(other.last_seq_) {}
+  PushBatch& operator=(PushBatch&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefSend();
+    center_ = std::exchange(other.center_, nullptr);
+    values_ = std::move(other.values_);
+    num_pushed_ = other.num_pushed_;
+    last_seq_ = other.last_seq_;
+    return *this;
+  }
+
+  ~PushBatch() {
+    if (center_ != nullptr) center_->UnrefSend();
+  }
+
+  Poll<bool> operator()() {
+    if (values_.empty()) return true;
+    while (num_pushed_ != values_.size()) {
+      last_seq_ = center_->next_push_seq();
+      auto r = center_->Push(&values_[num_pushed_]);
+      if (auto* ok = absl::get_if<bool>(&r)) {
+        if (!*ok) return false;
+        ++num_pushed_;
+      } else {
+        return Pending{};
+      }
+    }
+    return center_->PollAck(last_seq_);
+  }
+
+ private:
+  friend class PipeSender<T>;
+  PushBatch(pipe_detail::Center<T>* center, PipeBatch<T> values)
+      : center_(center), values_(std::move(values)) {}
+  Center<T>* center_;
+  PipeBatch<T> values_;
+  // Number of values_ in the pipe so far; the rest wait for room.
+  size_t num_pushed_ = 0;
+  // Number of the last pushed value, to wait for its ack.
+  uint32_t last_seq_ = 0;
 };
 
 // Implementation of PipeReceiver::Next promise.
@@ -433,6 +571,38 @@ class Next {
   Center<T>* center_;
 };
 
+// Implementation of PipeReceiver::NextBatch promise.
+template <typename T>
+class NextBatch {
+ public:
+  NextBatch(const NextBatch&) = delete;
+  NextBatch& operator=(const NextBatch&) = delete;
+  NextBatch(NextBatch&& other) noexcept
+      : center_(std::exchange(other.center_, nullptr)) {}
+  NextBatch& operator=(NextBatch&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = std::exchange(other.center_, nullptr);
+    return *this;
+  }
+
+  ~NextBatch() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  Poll<absl::optional<PipeBatch<T>>> operator()() {
+    auto r = center_->NextBatch();
+    if (!absl::holds_alternative<Pending>(r)) {
+      std::exchange(center_, nullptr)->UnrefRecv();
+    }
+    return r;
+  }
+
+ private:
+  friend class PipeReceiver<T>;
+  explicit NextBatch(pipe_detail::Center<T>* center) : center_(center) {}
+  Center<T>* center_;
+};
+
 }  // namespace pipe_detail
 
 template <typename T>
@@ -440,11 +610,21 @@ pipe_detail::Push<T> PipeSender<T>::Push(T value) {
   return pipe_detail::Push<T>(center_->RefSend(), std::move(value));
 }
 
+template <typename T>
+pipe_detail::PushBatch<T> PipeSender<T>::PushBatch(PipeBatch<T> values) {
+  return pipe_detail::PushBatch<T>(center_->RefSend(), std::move(values));
+}
+
 template <typename T>
 pipe_detail::Next<T> PipeReceiver<T>::Next() {
   return pipe_detail::Next<T>(center_->RefRecv());
 }
 
+template <typename T>
+pipe_detail::NextBatch<T> PipeReceiver<T>::NextBatch() {
+  return pipe_detail::NextBatch<T>(center_->RefRecv());
+}
+
 template <typename T>
 bool NextResult<T>::has_value() const {
   return center_ != nullptr;
@@ -483,10 +663,16 @@ void NextResult<T>::reset() {
 // few pipes per activity. If this assumption does not hold then a design
 // allowing inline filtering of pipe contents (instead of connecting pipes with
 // polling code) would likely be more appropriate.
+// By default a pipe holds one value at a time, and every value costs the
+// sender and the receiver a poll each. Pipes constructed with a larger
+// capacity let PushBatch/NextBatch move up to that many values per poll.
 template <typename T>
 struct Pipe {
   Pipe() : Pipe(GetContext<Arena>()) {}
   explicit Pipe(Arena* arena) : Pipe(arena->New<pipe_detail::Center<T>>()) {}
+  // capacity must be a power of two, at most 128.
+  Pipe(Arena* arena, uint8_t capacity)
+      : Pipe(arena->New<pipe_detail::Center<T>>(arena, capacity)) {}
   Pipe(const Pipe&) = delete;
   Pipe& operator=(const Pipe&) = delete;
   Pipe(Pipe&&) noexcept = default;
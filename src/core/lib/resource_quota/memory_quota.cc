@@ -20,14 +20,19 @@
 
 #include <algorithm>
 #include <atomic>
+#include <new>
 #include <tuple>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/mpscq.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/promise/detail/basic_seq.h"
 #include "src/core/lib/promise/exec_ctx_wakeup_scheduler.h"
 #include "src/core/lib/promise/loop.h"
@@ -201,32 +206,13 @@ size_t GrpcMemoryAllocatorImpl::Reserve(MemoryRequest request) {
 
 absl::optional<size_t> GrpcMemoryAllocatorImpl::TryReserve(
     MemoryRequest request) {
-  // How much memory should we request? (see the scaling below)
-  size_t scaled_size_over_min = request.max() - request.min();
-  // Scale the request down according to memory pressure if we have that
-  // flexibility.
-  if (scaled_size_over_min != 0) {
-    const auto pressure_info = memory_quota_->GetPressureInfo();
-    double pressure = pressure_info.pressure_control_value;
-    size_t max_recommended_allocation_size =
-        pressure_info.max_recommended_allocation_size;
-    // Reduce allocation size proportional to the pressure > 80% usage.
-    if (pressure > 0.8) {
-      scaled_size_over_min =
-          std::min(scaled_size_over_min,
-                   static_cast<size_t>((request.max() - request.min()) *
-                                       (1.0 - pressure) / 0.2));
-    }
-    if (max_recommended_allocation_size < request.min()) {
-      scaled_size_over_min = 0;
-    } else if (request.min() + scaled_size_over_min >
-               max_recommended_allocation_size) {
-      scaled_size_over_min = max_recommended_allocation_size - request.min();
-    }
-  }
-
-  // How much do we want to reserve?
-  const size_t reserve = request.min() + scaled_size_over_min;
+  // How much do we want to reserve? Scale the request down according to
+  // memory pressure if we have that flexibility.
+  const size_t reserve =
+      request.min() == request.max()
+          ? request.min()
+          : memory_quota_->GetPressureInfo().AdjustBufferSize(request.min(),
+                                                              request.max());
   // See how many bytes are available.
   size_t available = free_bytes_.load(std::memory_order_acquire);
   while (true) {
@@ -336,6 +322,11 @@ class BasicMemoryQuota::WaitForSweepPromise {
   uint64_t token_;
 };
 
+BasicMemoryQuota::~BasicMemoryQuota() {
+  Slab* slabs = slabs_.load(std::memory_order_relaxed);
+  if (slabs != nullptr) gpr_free_aligned(slabs);
+}
+
 void BasicMemoryQuota::Start() {
   auto self = shared_from_this();
 
@@ -349,6 +340,11 @@ void BasicMemoryQuota::Start() {
         if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
           return Pending{};
         }
+        // The memory held by the slabs is free too.
+        self->DrainSlabs();
+        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
+          return Pending{};
+        }
         return 0;
       },
       [self]() {
@@ -405,19 +401,90 @@ void BasicMemoryQuota::Stop() { reclaimer_activity_.reset(); }
 
 void BasicMemoryQuota::SetSize(size_t new_size) {
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
+  max_slab_bytes_.store(MaxSlabBytes(new_size), std::memory_order_relaxed);
+  DrainSlabs();
   if (old_size < new_size) {
     // We're growing the quota.
-    Return(new_size - old_size);
+    ReturnToQuota(new_size - old_size);
   } else {
     // We're shrinking the quota.
-    Take(old_size - new_size);
+    TakeFromQuota(old_size - new_size);
+  }
+}
+
+size_t BasicMemoryQuota::MaxSlabBytes(size_t quota_size) {
+  const size_t max_slab_bytes =
+      std::min(size_t{kMaxSlabBytes},
+               quota_size / 100 / std::max(gpr_cpu_num_cores(), 1u));
+  // Slabs that small would not save many trips to free_bytes_.
+  if (max_slab_bytes < 2 * kMinReplenishBytes) return 0;
+  return max_slab_bytes;
+}
+
+BasicMemoryQuota::Slab* BasicMemoryQuota::ThisCpuSlab(size_t amount) {
+  // Transfers of more than half a slab go straight to free_bytes_: they are
+  // rare, and the slab could not absorb them anyway.
+  if (!IsPerCpuMemoryQuotaEnabled() ||
+      amount > max_slab_bytes_.load(std::memory_order_relaxed) / 2 ||
+      ExecCtx::Get() == nullptr) {
+    return nullptr;
   }
+  Slab* slabs = slabs_.load(std::memory_order_acquire);
+  if (slabs == nullptr) slabs = CreateSlabs();
+  return &slabs[ExecCtx::Get()->starting_cpu()];
+}
+
+BasicMemoryQuota::Slab* BasicMemoryQuota::CreateSlabs() {
+  const size_t num_slabs = gpr_cpu_num_cores();
+  // new Slab[] only guarantees malloc alignment before C++17.
+  Slab* slabs = static_cast<Slab*>(
+      gpr_malloc_aligned(num_slabs * sizeof(Slab), alignof(Slab)));
+  for (size_t i = 0; i < num_slabs; i++) new (&slabs[i]) Slab();
+  Slab* expected = nullptr;
+  if (!slabs_.compare_exchange_strong(expected, slabs,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+    gpr_free_aligned(slabs);
+    return expected;
+  }
+  return slabs;
 }
 
 void BasicMemoryQuota::Take(size_t amount) {
   // If there's a request for nothing, then do nothing!
   if (amount == 0) return;
   GPR_DEBUG_ASSERT(amount <= std::numeric_limits<intptr_t>::max());
+  Slab* slab = ThisCpuSlab(amount);
+  if (slab == nullptr) {
+    TakeFromQuota(amount);
+    return;
+  }
+  // Take the memory from the slab of this CPU if it has enough.
+  intptr_t available = slab->free_bytes.load(std::memory_order_relaxed);
+  while (available >= static_cast<intptr_t>(amount)) {
+    if (slab->free_bytes.compare_exchange_weak(available, available - amount,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  // Otherwise take it from the quota, along with half a slab worth of bytes
+  // to refill the slab - unless that would leave the quota short of memory.
+  const intptr_t refill = static_cast<intptr_t>(
+      max_slab_bytes_.load(std::memory_order_relaxed) / 2);
+  intptr_t free = free_bytes_.load(std::memory_order_relaxed);
+  while (free >= static_cast<intptr_t>(amount) + 2 * refill) {
+    if (free_bytes_.compare_exchange_weak(free, free - amount - refill,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed)) {
+      slab->free_bytes.fetch_add(refill, std::memory_order_relaxed);
+      return;
+    }
+  }
+  TakeFromQuota(amount);
+}
+
+void BasicMemoryQuota::TakeFromQuota(size_t amount) {
   // Grab memory from the quota.
   auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
   // If we push into overcommit, awake the reclaimer.
@@ -445,9 +512,62 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
+  Slab* slab = ThisCpuSlab(amount);
+  // In overcommit the memory goes straight back to the quota, where the
+  // reclaimer sees it.
+  if (slab == nullptr || free_bytes_.load(std::memory_order_relaxed) <= 0) {
+    ReturnToQuota(amount);
+    return;
+  }
+  const intptr_t max_slab_bytes =
+      static_cast<intptr_t>(max_slab_bytes_.load(std::memory_order_relaxed));
+  intptr_t free =
+      slab->free_bytes.fetch_add(amount, std::memory_order_relaxed) +
+      static_cast<intptr_t>(amount);
+  // If the slab is over its limit, return all but half of it to the quota.
+  while (free > max_slab_bytes) {
+    if (slab->free_bytes.compare_exchange_weak(free, max_slab_bytes / 2,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed)) {
+      ReturnToQuota(free - max_slab_bytes / 2);
+      return;
+    }
+  }
+}
+
+void BasicMemoryQuota::ReturnToQuota(size_t amount) {
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
 }
 
+void BasicMemoryQuota::DrainSlabs() {
+  Slab* slabs = slabs_.load(std::memory_order_acquire);
+  if (slabs == nullptr) return;
+  for (size_t i = 0; i < gpr_cpu_num_cores(); i++) {
+    const intptr_t free =
+        slabs[i].free_bytes.exchange(0, std::memory_order_relaxed);
+    if (free != 0) free_bytes_.fetch_add(free, std::memory_order_relaxed);
+  }
+}
+
+size_t BasicMemoryQuota::PressureInfo::AdjustBufferSize(size_t min_size,
+                                                        size_t max_size) const {
+  GPR_DEBUG_ASSERT(min_size <= max_size);
+  size_t size_over_min = max_size - min_size;
+  // Reduce the size proportional to the pressure > 80% usage.
+  if (pressure_control_value > 0.8) {
+    size_over_min = std::min(
+        size_over_min, static_cast<size_t>((max_size - min_size) *
+                                           (1.0 - pressure_control_value) /
+                                           0.2));
+  }
+  if (max_recommended_allocation_size < min_size) {
+    size_over_min = 0;
+  } else if (min_size + size_over_min > max_recommended_allocation_size) {
+    size_over_min = max_recommended_allocation_size - min_size;
+  }
+  return min_size + size_over_min;
+}
+
 BasicMemoryQuota::PressureInfo BasicMemoryQuota::GetPressureInfo() {
   double free = free_bytes_.load();
   if (free < 0) free = 0;
@@ -286,9 +286,19 @@ class BasicMemoryQuota final
     double pressure_control_value;
     // Maximum recommended individual allocation size.
     size_t max_recommended_allocation_size;
+
+    // Size for a buffer of min_size to max_size bytes under this memory
+    // pressure: max_size until pressure_control_value reaches 80%, then
+    // shrinking linearly to min_size at 100%, and no more than
+    // max_recommended_allocation_size unless min_size is.
+    // Memory allocator reservations follow this policy, and so should every
+    // other buffer that can shrink under memory pressure, so that they all
+    // shrink together.
+    size_t AdjustBufferSize(size_t min_size, size_t max_size) const;
   };
 
   explicit BasicMemoryQuota(std::string name) : name_(std::move(name)) {}
+  ~BasicMemoryQuota();
 
   // Start the reclamation activity.
   void Start();
@@ -319,14 +329,46 @@ class BasicMemoryQuota final
   friend class ReclamationSweep;
   class WaitForSweepPromise;
 
-  static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
+  // Free bytes of the quota set aside for the allocators running on one CPU,
+  // so that they rarely touch the shared free_bytes_
+  // (per_cpu_memory_quota experiment).
+  // Slabs of different CPUs are on different cache lines.
+  struct alignas(GPR_CACHELINE_SIZE) Slab {
+    std::atomic<intptr_t> free_bytes{0};
+  };
 
-  // The amount of memory that's free in this quota.
+  static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
+  // Most bytes a slab holds when the quota is large enough.
+  static constexpr size_t kMaxSlabBytes = 1024 * 1024;
+
+  // The most bytes each slab may hold for a quota of quota_size bytes, or 0 if
+  // slabs should not be used.
+  static size_t MaxSlabBytes(size_t quota_size);
+  // The slab of the current CPU to transfer amount bytes through, or nullptr
+  // if the transfer should go straight to free_bytes_.
+  Slab* ThisCpuSlab(size_t amount);
+  // Allocate the slabs, or return the ones another thread just allocated.
+  Slab* CreateSlabs();
+  // Take() and Return() without the slabs.
+  void TakeFromQuota(size_t amount);
+  void ReturnToQuota(size_t amount);
+  // Return all the bytes held by the slabs to free_bytes_.
+  void DrainSlabs();
+
+  // The amount of memory that's free in this quota, not counting the bytes
+  // held by the slabs.
   // We use intptr_t as a reasonable proxy for ssize_t that's portable.
   // We allow arbitrary overcommit and so this must allow negative values.
   std::atomic<intptr_t> free_bytes_{kInitialSize};
   // The total number of bytes in this quota.
   std::atomic<size_t> quota_size_{kInitialSize};
+  // Per-CPU slabs of free bytes. Pressure is computed from free_bytes_ only,
+  // so the bytes they hold count as used: max_slab_bytes_ is bounded so that
+  // all slabs together hold at most 1% of the quota.
+  // One slab per core, allocated on first use so that quotas pay nothing for
+  // them while the experiment is off.
+  std::atomic<Slab*> slabs_{nullptr};
+  std::atomic<size_t> max_slab_bytes_{MaxSlabBytes(kInitialSize)};
 
   // Reclaimer queues.
   ReclaimerQueue reclaimers_[kNumReclamationPasses];
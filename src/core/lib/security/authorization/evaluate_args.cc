@@ -69,6 +69,52 @@ EvaluateArgs::PerChannelArgs::Address ParseEndpointUri(
 
 }  // namespace
 
+EvaluateArgs::PerChannelArgs::PeerMatchCache::Results::Results(uint64_t key,
+                                                               size_t size)
+    : key_(key), size_(size), results_(new std::atomic<uint8_t>[size]) {
+  for (size_t i = 0; i < size; ++i) {
+    results_[i].store(kUnknown, std::memory_order_relaxed);
+  }
+}
+
+bool EvaluateArgs::PerChannelArgs::PeerMatchCache::Results::Get(
+    size_t index, absl::FunctionRef<bool()> compute) {
+  GPR_DEBUG_ASSERT(index < size_);
+  uint8_t result = results_[index].load(std::memory_order_relaxed);
+  if (result == kUnknown) {
+    result = compute() ? kTrue : kFalse;
+    results_[index].store(result, std::memory_order_relaxed);
+  }
+  return result == kTrue;
+}
+
+RefCountedPtr<EvaluateArgs::PerChannelArgs::PeerMatchCache::Results>
+EvaluateArgs::PerChannelArgs::PeerMatchCache::Get(uint64_t key, size_t size) {
+  MutexLock lock(&mu_);
+  RefCountedPtr<Results>* empty = nullptr;
+  RefCountedPtr<Results>* oldest = nullptr;
+  for (auto& entry : entries_) {
+    if (entry == nullptr) {
+      if (empty == nullptr) empty = &entry;
+      continue;
+    }
+    if (entry->key_ == key) {
+      GPR_DEBUG_ASSERT(entry->size_ == size);
+      return entry;
+    }
+    if (oldest == nullptr || entry->key_ < (*oldest)->key_) oldest = &entry;
+  }
+  RefCountedPtr<Results>* slot = empty;
+  if (slot == nullptr) {
+    // Full: evict the oldest key, unless this one is older still.
+    if ((*oldest)->key_ > key) return nullptr;
+    slot = oldest;
+  }
+  // Calls still using an evicted entry keep it alive until they are done.
+  *slot = RefCountedPtr<Results>(new Results(key, size));
+  return *slot;
+}
+
 EvaluateArgs::PerChannelArgs::PerChannelArgs(grpc_auth_context* auth_context,
                                              grpc_endpoint* endpoint) {
   if (auth_context != nullptr) {
@@ -218,4 +264,12 @@ absl::string_view EvaluateArgs::GetSubject() const {
   return channel_args_->subject;
 }
 
+EvaluateArgs::PerChannelArgs::PeerMatchCache* EvaluateArgs::GetPeerMatchCache()
+    const {
+  if (channel_args_ == nullptr) {
+    return nullptr;
+  }
+  return channel_args_->peer_match_cache.get();
+}
+
 }  // namespace grpc_core
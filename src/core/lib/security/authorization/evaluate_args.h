@@ -17,14 +17,24 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -44,6 +54,54 @@ class EvaluateArgs {
       int port = 0;
     };
 
+    // Memoizes matcher results that only depend on the connection, so that
+    // they are computed at most once per connection rather than once per
+    // call. Entries are keyed by a caller-chosen id that must never be reused,
+    // and that is larger for newer callers. The lookup takes a lock, but each
+    // result is computed lazily, the first time it is needed, outside of it.
+    // Concurrent calls may both compute a result; they store the same value.
+    class PeerMatchCache {
+     public:
+      // The results stored for one key.
+      class Results : public RefCounted<Results, NonPolymorphicRefCount> {
+       public:
+        // Returns the result at index, calling compute to get it the first
+        // time.
+        bool Get(size_t index, absl::FunctionRef<bool()> compute);
+
+       private:
+        friend class PeerMatchCache;
+
+        enum : uint8_t { kUnknown, kFalse, kTrue };
+
+        Results(uint64_t key, size_t size);
+
+        const uint64_t key_;
+        const size_t size_;
+        std::unique_ptr<std::atomic<uint8_t>[]> results_;
+      };
+
+      PeerMatchCache() = default;
+
+      PeerMatchCache(const PeerMatchCache&) = delete;
+      PeerMatchCache& operator=(const PeerMatchCache&) = delete;
+
+      // Returns the results for key, with room for size results. When the
+      // cache is full, the entry with the smallest key is evicted for it;
+      // returns nullptr if key is smaller than all of those.
+      RefCountedPtr<Results> Get(uint64_t key, size_t size)
+          ABSL_LOCKS_EXCLUDED(mu_);
+
+     private:
+      // A connection only sees a handful of live keys at a time (typically
+      // an allow and a deny engine). Policy updates replace them with newer
+      // ones, whose keys then evict those of the engines they replaced.
+      static constexpr size_t kMaxEntries = 8;
+
+      Mutex mu_;
+      RefCountedPtr<Results> entries_[kMaxEntries] ABSL_GUARDED_BY(mu_);
+    };
+
     PerChannelArgs(grpc_auth_context* auth_context, grpc_endpoint* endpoint);
 
     absl::string_view transport_security_type;
@@ -54,6 +112,8 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    std::unique_ptr<PeerMatchCache> peer_match_cache =
+        std::make_unique<PeerMatchCache>();
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -84,6 +144,8 @@ class EvaluateArgs {
   std::vector<absl::string_view> GetDnsSans() const;
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
+  // Returns nullptr if there are no per-channel args.
+  PerChannelArgs::PeerMatchCache* GetPeerMatchCache() const;
 
  private:
   grpc_metadata_batch* metadata_;
@@ -17,39 +17,208 @@
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <utility>
 
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/matchers/matchers.h"
+
 namespace grpc_core {
 
+namespace {
+
+uint64_t NextEngineId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Returns true if the principal can be evaluated from the connection alone.
+bool DependsOnlyOnPeer(const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+    case Rbac::Principal::RuleType::kNot:
+      for (const auto& id : principal.principals) {
+        if (!DependsOnlyOnPeer(*id)) return false;
+      }
+      return true;
+    case Rbac::Principal::RuleType::kAny:
+    case Rbac::Principal::RuleType::kPrincipalName:
+    case Rbac::Principal::RuleType::kSourceIp:
+    case Rbac::Principal::RuleType::kDirectRemoteIp:
+    case Rbac::Principal::RuleType::kRemoteIp:
+    case Rbac::Principal::RuleType::kMetadata:
+      return true;
+    case Rbac::Principal::RuleType::kHeader:
+    case Rbac::Principal::RuleType::kPath:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
+//
+// GrpcAuthorizationEngine::PathIndex
+//
+
+GrpcAuthorizationEngine::PathIndex::PathFilter
+GrpcAuthorizationEngine::PathIndex::FilterFor(
+    const Rbac::Permission& permission) {
+  PathFilter filter;
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kPath: {
+      const StringMatcher& matcher = permission.string_matcher;
+      if (!matcher.case_sensitive()) break;
+      if (matcher.type() == StringMatcher::Type::kExact) {
+        filter.any = false;
+        filter.exact.push_back(matcher.string_matcher());
+      } else if (matcher.type() == StringMatcher::Type::kPrefix) {
+        filter.any = false;
+        filter.prefixes.push_back(matcher.string_matcher());
+      }
+      break;
+    }
+    case Rbac::Permission::RuleType::kAnd:
+      // Every rule must match, so any one restrictive rule is enough.
+      for (const auto& rule : permission.permissions) {
+        PathFilter rule_filter = FilterFor(*rule);
+        if (!rule_filter.any) return rule_filter;
+      }
+      break;
+    case Rbac::Permission::RuleType::kOr:
+      // Any rule may match, so all of them need to be restrictive.
+      for (const auto& rule : permission.permissions) {
+        PathFilter rule_filter = FilterFor(*rule);
+        if (rule_filter.any) return PathFilter();
+        for (auto& exact : rule_filter.exact) {
+          filter.exact.push_back(std::move(exact));
+        }
+        for (auto& prefix : rule_filter.prefixes) {
+          filter.prefixes.push_back(std::move(prefix));
+        }
+      }
+      filter.any = permission.permissions.empty();
+      break;
+    default:
+      break;
+  }
+  return filter;
+}
+
+void GrpcAuthorizationEngine::PathIndex::Add(
+    size_t policy, const Rbac::Permission& permissions) {
+  PathFilter filter = FilterFor(permissions);
+  if (filter.any) {
+    unindexed_.push_back(policy);
+    return;
+  }
+  for (const auto& exact : filter.exact) {
+    exact_[exact].push_back(policy);
+  }
+  for (const auto& prefix : filter.prefixes) {
+    PrefixTrieNode* node = &prefixes_;
+    for (char c : prefix) {
+      auto& child = node->children[c];
+      if (child == nullptr) child = std::make_unique<PrefixTrieNode>();
+      node = child.get();
+    }
+    node->policies.push_back(policy);
+  }
+}
+
+void GrpcAuthorizationEngine::PathIndex::Lookup(
+    absl::string_view path, PolicyIndices* policies) const {
+  policies->insert(policies->end(), unindexed_.begin(), unindexed_.end());
+  auto it = exact_.find(path);
+  if (it != exact_.end()) {
+    policies->insert(policies->end(), it->second.begin(), it->second.end());
+  }
+  const PrefixTrieNode* node = &prefixes_;
+  for (size_t i = 0;; ++i) {
+    policies->insert(policies->end(), node->policies.begin(),
+                     node->policies.end());
+    if (i == path.size()) break;
+    auto child = node->children.find(path[i]);
+    if (child == node->children.end()) break;
+    node = child->second.get();
+  }
+}
+
+//
+// GrpcAuthorizationEngine
+//
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac::Action action)
+    : action_(action), id_(NextEngineId()) {}
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
+    : action_(policy.action), id_(NextEngineId()) {
   for (auto& sub_policy : policy.policies) {
+    path_index_.Add(policies_.size(), sub_policy.second.permissions);
     Policy policy;
     policy.name = sub_policy.first;
-    policy.matcher = std::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
+    policy.principals_depend_only_on_peer =
+        DependsOnlyOnPeer(sub_policy.second.principals);
+    policy.permissions = AuthorizationMatcher::Create(
+        std::move(sub_policy.second.permissions));
+    policy.principals = AuthorizationMatcher::Create(
+        std::move(sub_policy.second.principals));
     policies_.push_back(std::move(policy));
   }
 }
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : action_(other.action_),
+      id_(other.id_),
+      policies_(std::move(other.policies_)),
+      path_index_(std::move(other.path_index_)) {}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
   action_ = other.action_;
+  id_ = other.id_;
   policies_ = std::move(other.policies_);
+  path_index_ = std::move(other.path_index_);
   return *this;
 }
 
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
+  // Candidates are visited in policy order, so that the decision names the
+  // same policy as a linear scan would.
+  PolicyIndices candidates;
+  path_index_.Lookup(args.GetPath(), &candidates);
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
   Decision decision;
   bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
+  // Peer principals are only looked up for policies that get that far, and
+  // only evaluated the first time a connection needs them.
+  RefCountedPtr<EvaluateArgs::PerChannelArgs::PeerMatchCache::Results>
+      peer_results;
+  bool peer_results_looked_up = false;
+  for (size_t index : candidates) {
+    const Policy& policy = policies_[index];
+    if (!policy.permissions->Matches(args)) continue;
+    auto principals_match = [&]() { return policy.principals->Matches(args); };
+    bool matched;
+    if (policy.principals_depend_only_on_peer) {
+      if (!peer_results_looked_up) {
+        auto* cache = args.GetPeerMatchCache();
+        if (cache != nullptr) peer_results = cache->Get(id_, policies_.size());
+        peer_results_looked_up = true;
+      }
+      matched = peer_results != nullptr
+                    ? peer_results->Get(index, principals_match)
+                    : principals_match();
+    } else {
+      matched = principals_match();
+    }
+    if (matched) {
       matches = true;
       decision.matching_policy_name = policy.name;
       break;
@@ -18,11 +18,17 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/evaluate_args.h"
 #include "src/core/lib/security/authorization/matchers.h"
@@ -39,7 +45,7 @@ namespace grpc_core {
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
-  explicit GrpcAuthorizationEngine(Rbac::Action action) : action_(action) {}
+  explicit GrpcAuthorizationEngine(Rbac::Action action);
   // Builds GrpcAuthorizationEngine with allow/deny RBAC policy.
   explicit GrpcAuthorizationEngine(Rbac policy);
 
@@ -56,12 +62,57 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   Decision Evaluate(const EvaluateArgs& args) const override;
 
  private:
+  using PolicyIndices = absl::InlinedVector<size_t, 8>;
+
   struct Policy {
     std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
+    std::unique_ptr<AuthorizationMatcher> permissions;
+    std::unique_ptr<AuthorizationMatcher> principals;
+    // True if the principals only look at properties of the connection (peer
+    // identity and addresses), in which case their result is computed at most
+    // once per connection, when a call first needs it, and cached in
+    // EvaluateArgs::PerChannelArgs.
+    bool principals_depend_only_on_peer = false;
   };
+
+  // Indexes policies by the request paths their permissions can match, so
+  // that Evaluate() only runs the matchers of policies that may apply to a
+  // request instead of walking every policy.
+  class PathIndex {
+   public:
+    void Add(size_t policy, const Rbac::Permission& permissions);
+    // Appends the policies that may match path, in no particular order.
+    void Lookup(absl::string_view path, PolicyIndices* policies) const;
+
+   private:
+    // Paths a permission can match. Exact and prefix matches are
+    // case-sensitive; anything else leaves the permission unindexed.
+    struct PathFilter {
+      bool any = true;
+      std::vector<std::string> exact;
+      std::vector<std::string> prefixes;
+    };
+
+    struct PrefixTrieNode {
+      // Policies with a prefix ending at this node.
+      std::vector<size_t> policies;
+      std::map<char, std::unique_ptr<PrefixTrieNode>> children;
+    };
+
+    static PathFilter FilterFor(const Rbac::Permission& permission);
+
+    std::vector<size_t> unindexed_;
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_;
+    PrefixTrieNode prefixes_;
+  };
+
   Rbac::Action action_;
+  // Unique for the lifetime of the process, and larger for newer engines;
+  // keys this engine's entries in per-connection caches, which evict the
+  // entries of older engines first.
+  uint64_t id_;
   std::vector<Policy> policies_;
+  PathIndex path_index_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,184 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/handshake_offload.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+HandshakeOffloadPool::HandshakeOffloadPool(size_t max_concurrent) {
+  Grow(std::max<size_t>(max_concurrent, 1));
+}
+
+HandshakeOffloadPool::~HandshakeOffloadPool() {
+  // Forkable unregisters only once the members are gone.
+  grpc_event_engine::experimental::StopManagingForkable(this);
+  std::vector<Thread> threads;
+  {
+    MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+    threads = std::move(threads_);
+  }
+  for (auto& thread : threads) thread.Join();
+}
+
+HandshakeOffloadPool* HandshakeOffloadPool::Get(size_t max_concurrent) {
+  static HandshakeOffloadPool* pool = new HandshakeOffloadPool(1);
+  pool->Grow(std::min<size_t>(max_concurrent, gpr_cpu_num_cores()));
+  return pool;
+}
+
+void HandshakeOffloadPool::Grow(size_t max_concurrent) {
+  MutexLock lock(&mu_);
+  num_threads_ = std::max(num_threads_, max_concurrent);
+  if (!forking_) StartThreadsLocked();
+}
+
+void HandshakeOffloadPool::StartThreadsLocked() {
+  while (threads_.size() < num_threads_) {
+    threads_.emplace_back("handshake_offload", &ThreadMain, this);
+    threads_.back().Start();
+  }
+}
+
+size_t HandshakeOffloadPool::max_concurrent() {
+  MutexLock lock(&mu_);
+  return num_threads_;
+}
+
+void HandshakeOffloadPool::Run(Priority priority, Timestamp deadline,
+                               Step step) {
+  const Timestamp now = Timestamp::Now();
+  std::vector<Step> expired;
+  {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(!shutdown_);
+    // Steps queued earlier with the same timeout expire first, so expired
+    // steps are found at the front of each queue.
+    TakeExpiredLocked(&in_progress_, now, &expired);
+    TakeExpiredLocked(&new_, now, &expired);
+    if (now > deadline) {
+      ++rejected_;
+      expired.push_back(std::move(step));
+    } else {
+      auto& queue = priority == Priority::kInProgress ? in_progress_ : new_;
+      queue.push_back(QueuedStep{deadline, std::move(step)});
+      cv_.Signal();
+    }
+  }
+  for (Step& step : expired) Reject(std::move(step));
+}
+
+void HandshakeOffloadPool::TakeExpiredLocked(std::deque<QueuedStep>* queue,
+                                             Timestamp now,
+                                             std::vector<Step>* expired) {
+  while (!queue->empty() && now > queue->front().deadline) {
+    ++rejected_;
+    expired->push_back(std::move(queue->front().step));
+    queue->pop_front();
+  }
+}
+
+void HandshakeOffloadPool::Reject(Step step) {
+  grpc_event_engine::experimental::GetDefaultEventEngine()->Run(
+      [step = std::move(step)]() mutable {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        step(absl::ResourceExhaustedError(
+            "Handshake expired while queued for the offload pool"));
+      });
+}
+
+void HandshakeOffloadPool::PrepareFork() {
+  std::vector<Thread> threads;
+  {
+    MutexLock lock(&mu_);
+    forking_ = true;
+    cv_.SignalAll();
+    threads = std::move(threads_);
+    threads_.clear();
+  }
+  // Threads finish the step they are running; queued steps wait for the
+  // threads started after the fork.
+  for (auto& thread : threads) thread.Join();
+}
+
+void HandshakeOffloadPool::PostforkParent() { Postfork(); }
+
+void HandshakeOffloadPool::PostforkChild() { Postfork(); }
+
+void HandshakeOffloadPool::Postfork() {
+  MutexLock lock(&mu_);
+  forking_ = false;
+  if (!shutdown_) StartThreadsLocked();
+}
+
+size_t HandshakeOffloadPool::queued() {
+  MutexLock lock(&mu_);
+  return in_progress_.size() + new_.size();
+}
+
+uint64_t HandshakeOffloadPool::rejected() {
+  MutexLock lock(&mu_);
+  return rejected_;
+}
+
+bool HandshakeOffloadPool::Dequeue(QueuedStep* out) {
+  MutexLock lock(&mu_);
+  while (in_progress_.empty() && new_.empty()) {
+    if (shutdown_ || forking_) return false;
+    cv_.Wait(&mu_);
+  }
+  if (forking_) return false;
+  auto& queue = in_progress_.empty() ? new_ : in_progress_;
+  *out = std::move(queue.front());
+  queue.pop_front();
+  return true;
+}
+
+void HandshakeOffloadPool::ThreadMain(void* arg) {
+  auto* pool = static_cast<HandshakeOffloadPool*>(arg);
+  QueuedStep queued;
+  while (pool->Dequeue(&queued)) {
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    absl::Status status;
+    if (Timestamp::Now() > queued.deadline) {
+      {
+        MutexLock lock(&pool->mu_);
+        ++pool->rejected_;
+      }
+      status = absl::ResourceExhaustedError(
+          "Handshake expired while queued for the offload pool");
+    }
+    Step step = std::move(queued.step);
+    step(std::move(status));
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,137 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_H
+#define GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+
+#include "src/core/lib/event_engine/forkable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+
+// A bounded set of dedicated threads that run TSI handshaker steps, so that
+// the CPU heavy parts of a handshake (public key operations) do not execute on
+// the I/O threads that also serve established connections.
+//
+// Admission control:
+// - at most max_concurrent steps run at once (one per pool thread)
+// - channels and servers that enable offload share one process-wide pool (see
+//   Get()), so the bound applies to the whole process
+// - a step that cannot start before its deadline is run with a
+//   RESOURCE_EXHAUSTED status instead, so that the handshake fails fast rather
+//   than piling up behind a reconnection storm. Expired steps are rejected as
+//   soon as they are queued or another step is queued behind them, without
+//   waiting for a pool thread.
+// - steps of handshakes that have already started are always dequeued before
+//   steps that would start a new handshake, so that in-flight work completes
+//   and frees its resources first
+//
+// The pool threads are stopped before a fork and restarted after it, in both
+// the parent and the child; steps queued meanwhile run once they are back.
+class HandshakeOffloadPool final
+    : public grpc_event_engine::experimental::Forkable {
+ public:
+  enum class Priority : uint8_t {
+    // The step continues a handshake that has already exchanged data.
+    kInProgress,
+    // The step is the first one of a new handshake.
+    kNew,
+  };
+
+  // A unit of work. Called exactly once, with an ExecCtx in scope, and never
+  // from within Run(). The status is OK if the step was admitted, in which
+  // case it runs on a pool thread, or RESOURCE_EXHAUSTED if it expired.
+  using Step = absl::AnyInvocable<void(absl::Status)>;
+
+  explicit HandshakeOffloadPool(size_t max_concurrent);
+  // Runs all queued steps, then joins the pool threads.
+  ~HandshakeOffloadPool() override;
+
+  HandshakeOffloadPool(const HandshakeOffloadPool&) = delete;
+  HandshakeOffloadPool& operator=(const HandshakeOffloadPool&) = delete;
+
+  // Returns the process-wide pool, creating it on first use. The pool grows to
+  // the largest \a max_concurrent asked for, but never beyond one thread per
+  // CPU core: handshake steps are CPU bound, so more threads would only add
+  // contention. The pool is never destroyed.
+  static HandshakeOffloadPool* Get(size_t max_concurrent);
+
+  void Run(Priority priority, Timestamp deadline, Step step);
+
+  size_t max_concurrent() ABSL_LOCKS_EXCLUDED(mu_);
+  // Number of steps waiting for a thread.
+  size_t queued() ABSL_LOCKS_EXCLUDED(mu_);
+  // Number of steps that were rejected by admission control so far.
+  uint64_t rejected() ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Forkable
+  void PrepareFork() override ABSL_LOCKS_EXCLUDED(mu_);
+  void PostforkParent() override ABSL_LOCKS_EXCLUDED(mu_);
+  void PostforkChild() override ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  struct QueuedStep {
+    Timestamp deadline;
+    Step step;
+  };
+
+  // Adds pool threads until there are \a max_concurrent of them.
+  void Grow(size_t max_concurrent) ABSL_LOCKS_EXCLUDED(mu_);
+  // Starts threads until there are num_threads_ of them.
+  void StartThreadsLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Postfork() ABSL_LOCKS_EXCLUDED(mu_);
+  // Takes the steps at the front of \a queue that are past their deadline.
+  void TakeExpiredLocked(std::deque<QueuedStep>* queue, Timestamp now,
+                         std::vector<Step>* expired)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Runs \a step with RESOURCE_EXHAUSTED on the EventEngine.
+  static void Reject(Step step);
+
+  static void ThreadMain(void* arg);
+  // Blocks until a step is available; returns false once shut down and
+  // drained, or when the thread must stop for a fork.
+  bool Dequeue(QueuedStep* out) ABSL_LOCKS_EXCLUDED(mu_);
+
+  Mutex mu_;
+  CondVar cv_;
+  std::deque<QueuedStep> in_progress_ ABSL_GUARDED_BY(mu_);
+  std::deque<QueuedStep> new_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // Set between PrepareFork() and Postfork*(), while the threads are stopped.
+  bool forking_ ABSL_GUARDED_BY(mu_) = false;
+  uint64_t rejected_ ABSL_GUARDED_BY(mu_) = 0;
+  // The number of pool threads, which threads_ holds unless forking_.
+  size_t num_threads_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<Thread> threads_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_H
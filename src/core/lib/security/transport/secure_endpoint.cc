@@ -42,6 +42,7 @@
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -61,9 +62,20 @@
 #include "src/core/tsi/transport_security_interface.h"
 
 #define STAGING_BUFFER_SIZE 8192
+#define MIN_STAGING_BUFFER_SIZE 1024
 
 static void on_read(void* user_data, grpc_error_handle error);
 
+// Staging buffers shrink under memory pressure, down to
+// MIN_STAGING_BUFFER_SIZE, with the pressure_aware_buffer_sizing experiment.
+static grpc_core::MemoryRequest staging_buffer_request() {
+  if (grpc_core::IsPressureAwareBufferSizingEnabled()) {
+    return grpc_core::MemoryRequest(MIN_STAGING_BUFFER_SIZE,
+                                    STAGING_BUFFER_SIZE);
+  }
+  return grpc_core::MemoryRequest(STAGING_BUFFER_SIZE);
+}
+
 namespace {
 struct secure_endpoint {
   secure_endpoint(const grpc_endpoint_vtable* vtable,
@@ -95,10 +107,8 @@ struct secure_endpoint {
       read_staging_buffer = grpc_empty_slice();
       write_staging_buffer = grpc_empty_slice();
     } else {
-      read_staging_buffer =
-          memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
-      write_staging_buffer =
-          memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
+      read_staging_buffer = memory_owner.MakeSlice(staging_buffer_request());
+      write_staging_buffer = memory_owner.MakeSlice(staging_buffer_request());
     }
     has_posted_reclaimer.store(false, std::memory_order_relaxed);
     min_progress_size = 1;
@@ -230,7 +240,7 @@ static void flush_read_staging_buffer(secure_endpoint* ep, uint8_t** cur,
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(ep->read_mu) {
   grpc_slice_buffer_add_indexed(ep->read_buffer, ep->read_staging_buffer);
   ep->read_staging_buffer =
-      ep->memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
+      ep->memory_owner.MakeSlice(staging_buffer_request());
   *cur = GRPC_SLICE_START_PTR(ep->read_staging_buffer);
   *end = GRPC_SLICE_END_PTR(ep->read_staging_buffer);
 }
@@ -375,7 +385,7 @@ static void flush_write_staging_buffer(secure_endpoint* ep, uint8_t** cur,
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(ep->write_mu) {
   grpc_slice_buffer_add_indexed(&ep->output_buffer, ep->write_staging_buffer);
   ep->write_staging_buffer =
-      ep->memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
+      ep->memory_owner.MakeSlice(staging_buffer_request());
   *cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
   *end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
   maybe_post_reclaimer(ep);
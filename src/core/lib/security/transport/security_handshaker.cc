@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/base/attributes.h"
 #include "absl/status/status.h"
@@ -48,6 +49,7 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/status_helper.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/endpoint.h"
@@ -56,6 +58,7 @@
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/tcp_server.h"
 #include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/security/transport/handshake_offload.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice.h"
@@ -86,6 +89,12 @@ class SecurityHandshaker : public Handshaker {
  private:
   grpc_error_handle DoHandshakerNextLocked(const unsigned char* bytes_received,
                                            size_t bytes_received_size);
+  // Invokes the TSI handshaker on the bytes in the read buffer, either inline
+  // or, if configured, on the handshake offload pool. Takes ownership of the
+  // caller's ref on success.
+  grpc_error_handle ProcessReadBufferLocked(
+      HandshakeOffloadPool::Priority priority);
+  void OnOffloadedStep(size_t bytes_received_size, absl::Status status);
 
   grpc_error_handle OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -133,6 +142,9 @@ class SecurityHandshaker : public Handshaker {
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
   std::string tsi_handshake_error_;
+  // If non-null, handshaker steps are run on this pool.
+  HandshakeOffloadPool* offload_pool_ = nullptr;
+  Duration offload_queue_timeout_;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -144,7 +156,17 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
       handshake_buffer_(
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(
-          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))) {
+          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))),
+      offload_queue_timeout_(
+          args.GetDurationFromIntMillis(
+                  GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD_QUEUE_TIMEOUT_MS)
+              .value_or(Duration::Seconds(10))) {
+  const int offload_max_concurrent =
+      args.GetInt(GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD_MAX_CONCURRENT)
+          .value_or(0);
+  if (offload_max_concurrent > 0) {
+    offload_pool_ = HandshakeOffloadPool::Get(offload_max_concurrent);
+  }
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -465,6 +487,41 @@ grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
                                    hs_result);
 }
 
+grpc_error_handle SecurityHandshaker::ProcessReadBufferLocked(
+    HandshakeOffloadPool::Priority priority) {
+  // Copy all slices received.
+  size_t bytes_received_size = MoveReadBufferIntoHandshakeBuffer();
+  if (offload_pool_ == nullptr) {
+    // Call TSI handshaker.
+    return DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+  }
+  // Hand the TSI handshaker call to the offload pool; the caller's ref is
+  // passed along and picked up in OnOffloadedStep().
+  offload_pool_->Run(priority, Timestamp::Now() + offload_queue_timeout_,
+                     [this, bytes_received_size](absl::Status status) {
+                       OnOffloadedStep(bytes_received_size, std::move(status));
+                     });
+  return absl::OkStatus();
+}
+
+void SecurityHandshaker::OnOffloadedStep(size_t bytes_received_size,
+                                         absl::Status status) {
+  RefCountedPtr<SecurityHandshaker> h(this);
+  MutexLock lock(&mu_);
+  grpc_error_handle error = std::move(status);
+  if (!error.ok() || is_shutdown_) {
+    HandshakeFailedLocked(
+        GRPC_ERROR_CREATE_REFERENCING("Handshake offload failed", &error, 1));
+    return;
+  }
+  error = DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+  if (!error.ok()) {
+    HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
 // This callback might be run inline while we are still holding on to the mutex,
 // so schedule OnHandshakeDataReceivedFromPeerFn on ExecCtx to avoid a deadlock.
 void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFnScheduler(
@@ -487,10 +544,8 @@ void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn(
         GRPC_ERROR_CREATE_REFERENCING("Handshake read failed", &error, 1));
     return;
   }
-  // Copy all slices received.
-  size_t bytes_received_size = h->MoveReadBufferIntoHandshakeBuffer();
-  // Call TSI handshaker.
-  error = h->DoHandshakerNextLocked(h->handshake_buffer_, bytes_received_size);
+  error = h->ProcessReadBufferLocked(
+      HandshakeOffloadPool::Priority::kInProgress);
   if (!error.ok()) {
     h->HandshakeFailedLocked(error);
   } else {
@@ -561,9 +616,8 @@ void SecurityHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
   MutexLock lock(&mu_);
   args_ = args;
   on_handshake_done_ = on_handshake_done;
-  size_t bytes_received_size = MoveReadBufferIntoHandshakeBuffer();
   grpc_error_handle error =
-      DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
+      ProcessReadBufferLocked(HandshakeOffloadPool::Priority::kNew);
   if (!error.ok()) {
     HandshakeFailedLocked(error);
   } else {
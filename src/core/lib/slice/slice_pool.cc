@@ -0,0 +1,159 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/slice_pool.h"
+
+#include <stdlib.h>
+
+#include <memory>
+
+#include "absl/numeric/bits.h"
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Size classes for payloads of 256 bytes, 512 bytes, ... 64kb.
+constexpr size_t kNumSizeClasses = 9;
+static_assert(SlicePool::kMinPayloadSize << (kNumSizeClasses - 1) ==
+                  SlicePool::kMaxPayloadSize,
+              "size classes must go from kMinPayloadSize to kMaxPayloadSize");
+
+// Size class of a block of size bytes, or kNumSizeClasses if it is too large
+// to be pooled.
+size_t SizeClass(size_t size) {
+  if (size <= SlicePool::kMinPayloadSize + SlicePool::kHeaderSlop) return 0;
+  if (size > SlicePool::kMaxPayloadSize + SlicePool::kHeaderSlop) {
+    return kNumSizeClasses;
+  }
+  const size_t payload = size - SlicePool::kHeaderSlop;
+  return absl::bit_width(payload - 1) -
+         absl::bit_width(SlicePool::kMinPayloadSize - 1);
+}
+
+size_t ClassBlockSize(size_t size_class) {
+  return (SlicePool::kMinPayloadSize << size_class) + SlicePool::kHeaderSlop;
+}
+
+// Free blocks are kept in singly linked lists through their first bytes.
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// Free blocks cached for one CPU.
+// The lock is only ever tried: a thread that finds it taken by another thread
+// on the same CPU goes to the system allocator instead of waiting.
+struct Shard {
+  gpr_spinlock lock = GPR_SPINLOCK_INITIALIZER;
+  FreeBlock* free_blocks[kNumSizeClasses] = {};
+  size_t num_free_blocks[kNumSizeClasses] = {};
+};
+
+class Shards {
+ public:
+  Shard& this_cpu() {
+    ExecCtx* exec_ctx = ExecCtx::Get();
+    const size_t cpu = exec_ctx != nullptr ? exec_ctx->starting_cpu()
+                                           : gpr_cpu_current_cpu();
+    return shards_[cpu % num_shards_];
+  }
+
+  Shard* begin() { return shards_.get(); }
+  Shard* end() { return shards_.get() + num_shards_; }
+
+ private:
+  const size_t num_shards_ = gpr_cpu_num_cores();
+  std::unique_ptr<Shard[]> shards_{new Shard[num_shards_]};
+};
+
+Shards& GetShards() {
+  static NoDestruct<Shards> shards;
+  return *shards;
+}
+
+}  // namespace
+
+size_t SlicePool::BlockSize(size_t size) {
+  const size_t size_class = SizeClass(size);
+  if (size_class == kNumSizeClasses) return size;
+  return ClassBlockSize(size_class);
+}
+
+void* SlicePool::Alloc(size_t size) {
+  const size_t size_class = SizeClass(size);
+  if (size_class == kNumSizeClasses) return malloc(size);
+  // Stats are per-CPU, and need an ExecCtx to tell which CPU.
+  const bool collect_stats = ExecCtx::Get() != nullptr;
+  if (collect_stats) global_stats().IncrementSlicePoolAllocs();
+  Shard& shard = GetShards().this_cpu();
+  if (gpr_spinlock_trylock(&shard.lock)) {
+    FreeBlock* block = shard.free_blocks[size_class];
+    if (block != nullptr) {
+      shard.free_blocks[size_class] = block->next;
+      --shard.num_free_blocks[size_class];
+    }
+    gpr_spinlock_unlock(&shard.lock);
+    if (block != nullptr) return block;
+  }
+  if (collect_stats) global_stats().IncrementSlicePoolMallocs();
+  return malloc(ClassBlockSize(size_class));
+}
+
+void SlicePool::Free(void* block, size_t size) {
+  const size_t size_class = SizeClass(size);
+  if (size_class < kNumSizeClasses) {
+    Shard& shard = GetShards().this_cpu();
+    if (gpr_spinlock_trylock(&shard.lock)) {
+      const bool cache = (shard.num_free_blocks[size_class] + 1) *
+                             (kMinPayloadSize << size_class) <=
+                         kMaxCachedBytesPerClass;
+      if (cache) {
+        FreeBlock* free_block = static_cast<FreeBlock*>(block);
+        free_block->next = shard.free_blocks[size_class];
+        shard.free_blocks[size_class] = free_block;
+        ++shard.num_free_blocks[size_class];
+      }
+      gpr_spinlock_unlock(&shard.lock);
+      if (cache) return;
+    }
+  }
+  free(block);
+}
+
+void SlicePool::TestOnlyReset() {
+  for (Shard& shard : GetShards()) {
+    gpr_spinlock_lock(&shard.lock);
+    for (size_t size_class = 0; size_class < kNumSizeClasses; size_class++) {
+      while (shard.free_blocks[size_class] != nullptr) {
+        FreeBlock* block = shard.free_blocks[size_class];
+        shard.free_blocks[size_class] = block->next;
+        free(block);
+      }
+      shard.num_free_blocks[size_class] = 0;
+    }
+    gpr_spinlock_unlock(&shard.lock);
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,54 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SLICE_SLICE_POOL_H
+#define GRPC_CORE_LIB_SLICE_SLICE_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+namespace grpc_core {
+
+// Recycles the memory blocks that hold refcounted slices (refcount and bytes
+// together), so that reading from the network does not need a malloc() and a
+// free() per slice.
+// Blocks come in size classes: a power of two from 256 bytes to 64kb, plus
+// kHeaderSlop bytes for the refcount. Each CPU keeps a few free blocks of each
+// class, up to kMaxCachedBytesPerClass, and returns the rest to the system
+// allocator. Larger blocks are not pooled. Threads never wait for the cache:
+// when another thread is using it, they use the system allocator.
+class SlicePool {
+ public:
+  // Room left in each size class for the slice refcount, so that requests for
+  // a power of two bytes of payload do not round up to the next class.
+  static constexpr size_t kHeaderSlop = 64;
+  static constexpr size_t kMinPayloadSize = 256;
+  static constexpr size_t kMaxPayloadSize = 64 * 1024;
+  static constexpr size_t kMaxCachedBytesPerClass = 128 * 1024;
+
+  // Size of the block that Alloc(size) returns: its size class, or size if it
+  // is too large to be pooled.
+  static size_t BlockSize(size_t size);
+  // Allocate a block of BlockSize(size) bytes.
+  static void* Alloc(size_t size);
+  // Free a block returned by Alloc(size).
+  static void Free(void* block, size_t size);
+  // Free all the cached blocks.
+  static void TestOnlyReset();
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SLICE_SLICE_POOL_H
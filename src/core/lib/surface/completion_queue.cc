@@ -20,10 +20,12 @@
 #include "src/core/lib/surface/completion_queue.h"
 
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <algorithm>
 #include <atomic>
+#include <memory>
 #include <new>
 #include <string>
 #include <utility>
@@ -37,12 +39,15 @@
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/atomic_utils.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -224,10 +229,14 @@ namespace {
 /* Queue that holds the cq_completion_events. Internally uses
  * MultiProducerSingleConsumerQueue (a lockfree multiproducer single consumer
  * queue). It uses a queue_lock to support multiple consumers.
+ * With more than one shard, each thread pushes to and first pops from the
+ * shard it maps to, and only steals from the other shards when its own is
+ * empty, so that threads polling the same queue mostly take different locks.
  * Only used in completion queues whose completion_type is GRPC_CQ_NEXT */
 class CqEventQueue {
  public:
-  CqEventQueue() = default;
+  explicit CqEventQueue(size_t num_shards)
+      : num_shards_(num_shards), shards_(new Shard[num_shards]) {}
   ~CqEventQueue() = default;
 
   /* Note: The counter is not incremented/decremented atomically with push/pop.
@@ -240,17 +249,41 @@ class CqEventQueue {
   grpc_cq_completion* Pop();
 
  private:
-  /* Spinlock to serialize consumers i.e pop() operations */
-  gpr_spinlock queue_lock_ = GPR_SPINLOCK_INITIALIZER;
+  struct Shard {
+    /* Spinlock to serialize consumers i.e pop() operations */
+    gpr_spinlock queue_lock = GPR_SPINLOCK_INITIALIZER;
 
-  grpc_core::MultiProducerSingleConsumerQueue queue_;
+    grpc_core::MultiProducerSingleConsumerQueue queue;
+
+    /* Keeps the next shard's lock off this shard's cache lines */
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  grpc_cq_completion* PopFromShard(Shard* shard);
+
+  size_t ThisThreadShard() const;
+
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
 
   /* A lazy counter of number of items in the queue. This is NOT atomically
      incremented/decremented along with push/pop operations and hence is only
-     eventually consistent */
+     eventually consistent. It counts the items of all shards. */
   std::atomic<intptr_t> num_queue_items_{0};
 };
 
+/* Set by grpc_cq_set_event_queue_shards_for_testing; 0 if unset */
+std::atomic<size_t> g_event_queue_shards_for_testing{0};
+
+/* Number of event shards of a GRPC_CQ_NEXT completion queue */
+size_t CqEventQueueShards() {
+  size_t forced =
+      g_event_queue_shards_for_testing.load(std::memory_order_relaxed);
+  if (forced != 0) return forced;
+  if (!grpc_core::IsShardedCompletionQueueEnabled()) return 1;
+  return grpc_core::Clamp<size_t>(gpr_cpu_num_cores(), 1, 64);
+}
+
 struct cq_next_data {
   ~cq_next_data() {
     GPR_ASSERT(queue.num_items() == 0);
@@ -262,7 +295,7 @@ struct cq_next_data {
   }
 
   /** Completed events for completion-queues of type GRPC_CQ_NEXT */
-  CqEventQueue queue;
+  CqEventQueue queue{CqEventQueueShards()};
 
   /** Counter of how many things have ever been queued on this completion queue
       useful for avoiding locks to check the queue */
@@ -480,19 +513,36 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
   return ret;
 }
 
+/* Threads are assigned shards round-robin the first time they touch a
+ * sharded queue. Completions are usually queued by the thread that was
+ * polling the queue when the operation finished, so the event tends to stay
+ * on that thread's shard. */
+static std::atomic<size_t> g_next_cq_thread_id{0};
+static thread_local size_t g_cq_thread_id = SIZE_MAX;
+
+size_t CqEventQueue::ThisThreadShard() const {
+  if (num_shards_ == 1) return 0;
+  if (g_cq_thread_id == SIZE_MAX) {
+    g_cq_thread_id =
+        g_next_cq_thread_id.fetch_add(1, std::memory_order_relaxed);
+  }
+  return g_cq_thread_id % num_shards_;
+}
+
 bool CqEventQueue::Push(grpc_cq_completion* c) {
-  queue_.Push(
+  shards_[ThisThreadShard()].queue.Push(
       reinterpret_cast<grpc_core::MultiProducerSingleConsumerQueue::Node*>(c));
   return num_queue_items_.fetch_add(1, std::memory_order_relaxed) == 0;
 }
 
-grpc_cq_completion* CqEventQueue::Pop() {
+grpc_cq_completion* CqEventQueue::PopFromShard(Shard* shard) {
   grpc_cq_completion* c = nullptr;
 
-  if (gpr_spinlock_trylock(&queue_lock_)) {
+  if (gpr_spinlock_trylock(&shard->queue_lock)) {
     bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
-    gpr_spinlock_unlock(&queue_lock_);
+    c = reinterpret_cast<grpc_cq_completion*>(
+        shard->queue.PopAndCheckEnd(&is_empty));
+    gpr_spinlock_unlock(&shard->queue_lock);
   }
 
   if (c) {
@@ -502,6 +552,25 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+grpc_cq_completion* CqEventQueue::Pop() {
+  if (num_shards_ == 1) return PopFromShard(&shards_[0]);
+  /* Avoid walking every shard when there is nothing to steal. A push that
+     races with this check kicks the pollset once it bumps the counter, just
+     like a push that races with a failed trylock. */
+  if (num_items() == 0) return nullptr;
+  const size_t first = ThisThreadShard();
+  for (size_t i = 0; i < num_shards_; ++i) {
+    grpc_cq_completion* c = PopFromShard(&shards_[(first + i) % num_shards_]);
+    if (c != nullptr) return c;
+  }
+  return nullptr;
+}
+
+void grpc_cq_set_event_queue_shards_for_testing(size_t num_shards) {
+  g_event_queue_shards_for_testing.store(num_shards,
+                                         std::memory_order_relaxed);
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
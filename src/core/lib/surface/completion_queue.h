@@ -23,6 +23,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <grpc/impl/codegen/grpc_types.h>
@@ -97,4 +98,9 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback);
 
+/* Makes GRPC_CQ_NEXT completion queues created from now on use \a num_shards
+   event queue shards, whatever the sharded_completion_queue experiment and
+   the number of cores say. 0 restores the default. Only for tests. */
+void grpc_cq_set_event_queue_shards_for_testing(size_t num_shards);
+
 #endif /* GRPC_CORE_LIB_SURFACE_COMPLETION_QUEUE_H */
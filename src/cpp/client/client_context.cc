@@ -167,7 +167,11 @@ void ClientContext::TryCancel() {
 void ClientContext::SendCancelToInterceptors() {
   internal::CancelInterceptorBatchMethods cancel_methods;
   for (size_t i = 0; i < rpc_info_.interceptors_.size(); i++) {
-    rpc_info_.RunInterceptor(&cancel_methods, i);
+    if (rpc_info_.interceptor_hooks_[i] &
+        experimental::InterceptionHookPointBit(
+            experimental::InterceptionHookPoints::PRE_SEND_CANCEL)) {
+      rpc_info_.RunInterceptor(&cancel_methods, i);
+    }
   }
 }
 
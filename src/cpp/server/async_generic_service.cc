@@ -16,9 +16,20 @@
  *
  */
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <grpcpp/client_context.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/impl/sync.h>
 #include <grpcpp/server.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/string_ref.h>
 
 namespace grpc {
 
@@ -30,4 +41,176 @@ void AsyncGenericService::RequestCall(
                                    tag);
 }
 
+namespace experimental {
+
+namespace {
+
+std::string ToString(grpc::string_ref s) {
+  return std::string(s.data(), s.size());
+}
+
+// Forwards one incoming call to an outgoing call on another channel. Requests
+// are read into request_ and written from it, responses likewise through
+// response_, so each direction has a single message in flight. Deletes itself
+// once both calls are done.
+class GenericCallSplice {
+ public:
+  GenericCallSplice(GenericCallbackServerContext* ctx,
+                    std::shared_ptr<grpc::ChannelInterface> channel)
+      : server_context_(ctx),
+        client_context_(ClientContext::FromCallbackServerContext(*ctx)),
+        channel_(std::move(channel)),
+        server_reactor_(this),
+        client_reactor_(this) {
+    for (const auto& entry : ctx->client_metadata()) {
+      client_context_->AddMetadata(ToString(entry.first),
+                                   ToString(entry.second));
+    }
+    internal::ClientCallbackReaderWriterFactory<ByteBuffer, ByteBuffer>::Create(
+        channel_.get(),
+        internal::RpcMethod(ctx->method().c_str(),
+                            /*suffix_for_stats=*/nullptr,
+                            internal::RpcMethod::BIDI_STREAMING),
+        client_context_.get(), &client_reactor_);
+    // Held until no more requests will be forwarded, see
+    // StopForwardingRequests.
+    client_reactor_.AddHold();
+    client_reactor_.StartCall();
+    server_reactor_.StartRead(&request_);
+  }
+
+  ServerGenericBidiReactor* server_reactor() { return &server_reactor_; }
+
+ private:
+  class ServerReactor : public ServerGenericBidiReactor {
+   public:
+    explicit ServerReactor(GenericCallSplice* splice) : splice_(splice) {}
+
+    void OnReadDone(bool ok) override { splice_->OnRequestRead(ok); }
+    void OnWriteDone(bool ok) override { splice_->OnResponseWritten(ok); }
+    void OnCancel() override { splice_->client_context_->TryCancel(); }
+    void OnDone() override { splice_->Unref(); }
+
+   private:
+    GenericCallSplice* const splice_;
+  };
+
+  class ClientReactor : public ClientBidiReactor<ByteBuffer, ByteBuffer> {
+   public:
+    explicit ClientReactor(GenericCallSplice* splice) : splice_(splice) {}
+
+    void OnReadInitialMetadataDone(bool ok) override {
+      splice_->OnInitialMetadataRead(ok);
+    }
+    void OnReadDone(bool ok) override { splice_->OnResponseRead(ok); }
+    void OnWriteDone(bool ok) override { splice_->OnRequestWritten(ok); }
+    void OnDone(const Status& s) override { splice_->OnClientDone(s); }
+
+   private:
+    GenericCallSplice* const splice_;
+  };
+
+  void OnRequestRead(bool ok) {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!forwarding_requests_) return;
+      if (ok) {
+        // The outgoing call may otherwise be done before the write starts.
+        client_reactor_.AddHold();
+      } else {
+        forwarding_requests_ = false;
+      }
+    }
+    if (ok) {
+      client_reactor_.StartWrite(&request_);
+    } else {
+      client_reactor_.StartWritesDone();
+    }
+    client_reactor_.RemoveHold();
+  }
+
+  void OnRequestWritten(bool ok) {
+    if (ok) {
+      server_reactor_.StartRead(&request_);
+    } else {
+      // The outgoing call has failed; OnClientDone forwards its status.
+      StopForwardingRequests();
+    }
+  }
+
+  void OnInitialMetadataRead(bool ok) {
+    if (!ok) return;
+    for (const auto& entry : client_context_->GetServerInitialMetadata()) {
+      server_context_->AddInitialMetadata(ToString(entry.first),
+                                          ToString(entry.second));
+    }
+    server_reactor_.StartSendInitialMetadata();
+    client_reactor_.StartRead(&response_);
+  }
+
+  void OnResponseRead(bool ok) {
+    if (ok) {
+      // Released in OnResponseWritten, which reads the next response.
+      client_reactor_.AddHold();
+      server_reactor_.StartWrite(&response_);
+    } else {
+      // The outgoing call has ended. Stop waiting for requests, which the
+      // client may never half-close, so that its status can be forwarded.
+      StopForwardingRequests();
+    }
+  }
+
+  void OnResponseWritten(bool ok) {
+    if (ok) {
+      client_reactor_.StartRead(&response_);
+    } else {
+      client_context_->TryCancel();
+    }
+    client_reactor_.RemoveHold();
+  }
+
+  void OnClientDone(const Status& s) {
+    for (const auto& entry : client_context_->GetServerTrailingMetadata()) {
+      server_context_->AddTrailingMetadata(ToString(entry.first),
+                                           ToString(entry.second));
+    }
+    server_reactor_.Finish(s);
+    Unref();
+  }
+
+  void StopForwardingRequests() {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!forwarding_requests_) return;
+      forwarding_requests_ = false;
+    }
+    client_reactor_.RemoveHold();
+  }
+
+  void Unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  GenericCallbackServerContext* const server_context_;
+  const std::unique_ptr<ClientContext> client_context_;
+  const std::shared_ptr<grpc::ChannelInterface> channel_;
+  ServerReactor server_reactor_;
+  ClientReactor client_reactor_;
+  ByteBuffer request_;
+  ByteBuffer response_;
+  grpc::internal::Mutex mu_;
+  bool forwarding_requests_ ABSL_GUARDED_BY(mu_) = true;
+  // One for each of the two calls.
+  std::atomic<int> refs_{2};
+};
+
+}  // namespace
+
+ServerGenericBidiReactor* SpliceGenericCall(
+    GenericCallbackServerContext* ctx,
+    std::shared_ptr<grpc::ChannelInterface> channel) {
+  return (new GenericCallSplice(ctx, std::move(channel)))->server_reactor();
+}
+
+}  // namespace experimental
 }  // namespace grpc
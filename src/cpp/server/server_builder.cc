@@ -405,6 +405,14 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   }
 
   server->RegisterContextAllocator(std::move(context_allocator_));
+  server->SetProtobufArenaNames(std::move(protobuf_arena_names_));
+  server->SetMessagePoolCapacity(message_pool_capacity_);
+  if (sync_server_settings_.use_executor) {
+    server->SetSyncServerExecutor(
+        sync_server_settings_.max_concurrent_rpcs,
+        sync_server_settings_.max_queued_rpcs,
+        std::move(sync_server_settings_.method_max_concurrency));
+  }
 
   for (const auto& value : services_) {
     if (!server->RegisterService(value->host.get(), value->service)) {
@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
+#include <deque>
+#include <map>
 #include <memory>
 #include <new>
 #include <sstream>
@@ -29,6 +31,7 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 
 #include <grpc/byte_buffer.h>
 #include <grpc/grpc.h>
@@ -68,6 +71,8 @@
 #include <grpcpp/support/status.h>
 
 #include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/event_engine/thread_pool.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
@@ -428,8 +433,8 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
       // Set interception point for RECV MESSAGE
       auto* handler = resources_ ? method_->handler()
                                  : server_->resource_exhausted_handler_.get();
-      deserialized_request_ = handler->Deserialize(call_, request_payload_,
-                                                   &request_status_, nullptr);
+      deserialized_request_ = handler->Deserialize(
+          call_, request_payload_, &request_status_, &handler_data_);
       if (!request_status_.ok()) {
         gpr_log(GPR_DEBUG, "Failed to deserialize message.");
       }
@@ -455,7 +460,7 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
                                : server_->resource_exhausted_handler_.get();
     handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
         &*wrapped_call_, &ctx_->ctx, deserialized_request_, request_status_,
-        nullptr, nullptr));
+        handler_data_, nullptr));
     global_callbacks_->PostSynchronousRequest(&ctx_->ctx);
 
     cq_.Shutdown();
@@ -481,6 +486,8 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
     delete this;
   }
 
+  grpc::internal::RpcServiceMethod* method() const { return method_; }
+
  private:
   SyncRequest(Server* server, grpc::internal::RpcServiceMethod* method)
       : server_(server),
@@ -514,6 +521,7 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
   std::shared_ptr<GlobalCallbacks> global_callbacks_;
   bool resources_;
   void* deserialized_request_ = nullptr;
+  void* handler_data_ = nullptr;
   grpc::internal::InterceptorBatchMethodsImpl interceptor_methods_;
 
   // ServerContextWrapper allows ManualConstructor while using a private
@@ -766,6 +774,123 @@ const char* Server::CallbackRequest<
   return ctx_->method().c_str();
 }
 
+// Runs the handlers of sync RPCs on an EventEngine thread pool shared by all
+// the sync server completion queues, so that the threads polling those queues
+// only hand RPCs over. RPCs wait in a FIFO while the server or their method is
+// at its concurrency limit, and get RESOURCE_EXHAUSTED once the FIFO is full.
+class Server::SyncServerExecutor {
+ public:
+  SyncServerExecutor(Server* server, int max_concurrent_rpcs,
+                     int max_queued_rpcs,
+                     std::map<std::string, int> method_max_concurrency)
+      : server_(server),
+        max_concurrent_rpcs_(max_concurrent_rpcs),
+        max_queued_rpcs_(max_queued_rpcs),
+        method_max_concurrency_(std::move(method_max_concurrency)),
+        thread_pool_(static_cast<unsigned>(
+            grpc_core::Clamp(max_concurrent_rpcs, 2, kMaxReserveThreads))) {}
+
+  ~SyncServerExecutor() { thread_pool_.Quiesce(); }
+
+  // Runs sync_req on the thread pool, queues it, or fails it right away with
+  // RESOURCE_EXHAUSTED if the queue is full.
+  void Dispatch(SyncRequest* sync_req) {
+    {
+      grpc::internal::ReleasableMutexLock lock(&mu_);
+      MethodState* state = GetMethodStateLocked(sync_req->method());
+      if (!CanStartLocked(*state)) {
+        if (max_queued_rpcs_ < 0 ||
+            queue_.size() < static_cast<size_t>(max_queued_rpcs_)) {
+          queue_.push_back(sync_req);
+          return;
+        }
+        lock.Release();
+        sync_req->Run(server_->global_callbacks_, /*resources=*/false);
+        return;
+      }
+      StartLocked(state);
+    }
+    thread_pool_.Run([this, sync_req] { RunUntilIdle(sync_req); });
+  }
+
+ private:
+  // Handlers block, so the pool keeps a thread per concurrent RPC, up to this
+  // many; beyond that it grows on demand.
+  static constexpr int kMaxReserveThreads = 256;
+
+  struct MethodState {
+    int max_concurrent_rpcs = INT_MAX;
+    int running = 0;
+  };
+
+  // Runs sync_req, then the queued RPCs that became runnable, for as long as
+  // there are any, so that a finishing handler does not need a thread hop to
+  // start the next one.
+  void RunUntilIdle(SyncRequest* sync_req) {
+    while (sync_req != nullptr) {
+      grpc::internal::RpcServiceMethod* method = sync_req->method();
+      // Run() deletes sync_req.
+      sync_req->Run(server_->global_callbacks_, /*resources=*/true);
+      grpc::internal::MutexLock lock(&mu_);
+      --running_;
+      --GetMethodStateLocked(method)->running;
+      sync_req = nullptr;
+      for (auto it = queue_.begin();
+           it != queue_.end() && running_ < max_concurrent_rpcs_; ++it) {
+        MethodState* state = GetMethodStateLocked((*it)->method());
+        if (CanStartLocked(*state)) {
+          StartLocked(state);
+          sync_req = *it;
+          queue_.erase(it);
+          break;
+        }
+      }
+    }
+  }
+
+  bool CanStartLocked(const MethodState& state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return running_ < max_concurrent_rpcs_ &&
+           state.running < state.max_concurrent_rpcs;
+  }
+
+  void StartLocked(MethodState* state) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    ++running_;
+    ++state->running;
+  }
+
+  // A method's limit is the one set for its full name, else the one set for
+  // its service, else none.
+  MethodState* GetMethodStateLocked(grpc::internal::RpcServiceMethod* method)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto it = method_states_.find(method);
+    if (it != method_states_.end()) return &it->second;
+    MethodState& state = method_states_[method];
+    const std::string name = method->name();
+    auto limit = method_max_concurrency_.find(name);
+    if (limit == method_max_concurrency_.end() && !name.empty() &&
+        name[0] == '/') {
+      limit = method_max_concurrency_.find(
+          name.substr(1, name.rfind('/') - 1));
+    }
+    if (limit != method_max_concurrency_.end()) {
+      state.max_concurrent_rpcs = limit->second;
+    }
+    return &state;
+  }
+
+  Server* const server_;
+  const int max_concurrent_rpcs_;
+  const int max_queued_rpcs_;
+  const std::map<std::string, int> method_max_concurrency_;
+  grpc_event_engine::experimental::ThreadPool thread_pool_;
+  grpc::internal::Mutex mu_;
+  int running_ ABSL_GUARDED_BY(mu_) = 0;
+  std::deque<SyncRequest*> queue_ ABSL_GUARDED_BY(mu_);
+  std::map<grpc::internal::RpcServiceMethod*, MethodState> method_states_
+      ABSL_GUARDED_BY(mu_);
+};
+
 // Implementation of ThreadManager. Each instance of SyncRequestThreadManager
 // manages a pool of threads that poll for incoming Sync RPCs and call the
 // appropriate RPC handlers
@@ -810,6 +935,10 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     GPR_DEBUG_ASSERT(sync_req != nullptr);
     GPR_DEBUG_ASSERT(ok);
 
+    if (resources && server_->sync_server_executor_ != nullptr) {
+      server_->sync_server_executor_->Dispatch(sync_req);
+      return;
+    }
     sync_req->Run(global_callbacks_, resources);
   }
 
@@ -944,6 +1073,15 @@ Server::Server(
   grpc_server_set_config_fetcher(server_, server_config_fetcher);
 }
 
+void Server::SetSyncServerExecutor(
+    int max_concurrent_rpcs, int max_queued_rpcs,
+    std::map<std::string, int> method_max_concurrency) {
+  if (sync_server_cqs_ == nullptr || sync_server_cqs_->empty()) return;
+  sync_server_executor_ = std::make_unique<SyncServerExecutor>(
+      this, max_concurrent_rpcs, max_queued_rpcs,
+      std::move(method_max_concurrency));
+}
+
 Server::~Server() {
   {
     grpc::internal::ReleasableMutexLock lock(&mu_);
@@ -1033,6 +1171,21 @@ bool Server::RegisterService(const std::string* addr, grpc::Service* service) {
       continue;
     }
 
+    if (method->handler() != nullptr && !protobuf_arena_names_.empty()) {
+      // Method names are "/package.Service/Method", so the service name is
+      // everything between the two slashes.
+      absl::string_view name(method->name());
+      absl::string_view service_name = name.substr(1, name.rfind('/') - 1);
+      method->handler()->set_use_message_arena(
+          protobuf_arena_names_.count(std::string(name)) > 0 ||
+          protobuf_arena_names_.count(std::string(service_name)) > 0);
+    }
+
+    if (method->handler() != nullptr && message_pool_capacity_ > 0 &&
+        !method->handler()->use_message_arena()) {
+      method->handler()->EnableMessagePool(message_pool_capacity_);
+    }
+
     void* method_registration_tag = grpc_server_register_method(
         server_, method->name(), addr ? addr->c_str() : nullptr,
         PayloadHandlingForMethod(method.get()), 0);
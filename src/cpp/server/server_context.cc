@@ -340,7 +340,11 @@ void ServerContextBase::TryCancel() const {
   internal::CancelInterceptorBatchMethods cancel_methods;
   if (rpc_info_) {
     for (size_t i = 0; i < rpc_info_->interceptors_.size(); i++) {
-      rpc_info_->RunInterceptor(&cancel_methods, i);
+      if (rpc_info_->interceptor_hooks_[i] &
+          experimental::InterceptionHookPointBit(
+              experimental::InterceptionHookPoints::PRE_SEND_CANCEL)) {
+        rpc_info_->RunInterceptor(&cancel_methods, i);
+      }
     }
   }
   grpc_call_error err =
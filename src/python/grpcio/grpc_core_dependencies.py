@@ -464,6 +464,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/posix_engine/timer.cc',
     'src/core/lib/event_engine/posix_engine/timer_heap.cc',
     'src/core/lib/event_engine/posix_engine/timer_manager.cc',
+    'src/core/lib/event_engine/posix_engine/timer_wheel.cc',
     'src/core/lib/event_engine/posix_engine/traced_buffer_list.cc',
     'src/core/lib/event_engine/posix_engine/wakeup_fd_eventfd.cc',
     'src/core/lib/event_engine/posix_engine/wakeup_fd_pipe.cc',
@@ -682,6 +683,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/security/security_connector/ssl_utils_config.cc',
     'src/core/lib/security/security_connector/tls/tls_security_connector.cc',
     'src/core/lib/security/transport/client_auth_filter.cc',
+    'src/core/lib/security/transport/handshake_offload.cc',
     'src/core/lib/security/transport/secure_endpoint.cc',
     'src/core/lib/security/transport/security_handshaker.cc',
     'src/core/lib/security/transport/server_auth_filter.cc',
@@ -693,6 +695,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/slice/percent_encoding.cc',
     'src/core/lib/slice/slice.cc',
     'src/core/lib/slice/slice_buffer.cc',
+    'src/core/lib/slice/slice_pool.cc',
     'src/core/lib/slice/slice_string_helpers.cc',
     'src/core/lib/surface/api_trace.cc',
     'src/core/lib/surface/builtins.cc',
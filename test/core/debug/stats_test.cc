@@ -20,12 +20,14 @@
 
 #include <algorithm>
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 
 #include <grpc/grpc.h>
 
 #include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/experiments/config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/test_config.h"
 
@@ -52,6 +54,40 @@ TEST(StatsTest, IncSpecificCounter) {
   EXPECT_EQ(snapshot->delta()->client_calls_created, 1);
 }
 
+TEST(StatsTest, QueueTimeSamplerTimesOneInSixtyFourItems) {
+  // Sampling counts the items queued by each thread, so start a fresh one.
+  std::thread([] {
+    QueueTimeSampler sampler;
+    int items[129];
+    int micros = -1;
+    for (int& item : items) sampler.OnQueued(&item);
+    EXPECT_FALSE(sampler.OnDequeued(&items[1], &micros));
+    EXPECT_TRUE(sampler.OnDequeued(&items[0], &micros));
+    EXPECT_GE(micros, 0);
+    // items[64] was due, but items[0] was still being timed.
+    for (int i = 1; i < 129; i++) {
+      EXPECT_FALSE(sampler.OnDequeued(&items[i], &micros)) << i;
+    }
+    // So the next item queued is timed instead.
+    int next;
+    sampler.OnQueued(&next);
+    EXPECT_TRUE(sampler.OnDequeued(&next, &micros));
+  }).join();
+}
+
+TEST(StatsTest, SampleQueueDepthSamplesOneInSixtyFourItems) {
+  std::thread([] {
+    int sampled = 0;
+    for (int i = 0; i < 640; i++) {
+      if (SampleQueueDepth()) {
+        EXPECT_EQ(i % 64, 0) << i;
+        ++sampled;
+      }
+    }
+    EXPECT_EQ(sampled, 10);
+  }).join();
+}
+
 static int FindExpectedBucket(const HistogramView& h, int value) {
   if (value < 0) {
     return 0;
@@ -90,6 +126,7 @@ INSTANTIATE_TEST_SUITE_P(
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::ForceEnableExperiment("queue_time_sampling", true);
   grpc_init();
   int ret = RUN_ALL_TESTS();
   grpc_shutdown();
@@ -0,0 +1,278 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+namespace {
+
+class FakeHost : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(now.load());
+  }
+  void Kick() override { kicks.fetch_add(1); }
+
+  std::atomic<int64_t> now{0};
+  std::atomic<int> kicks{0};
+};
+
+class CountingClosure : public experimental::EventEngine::Closure {
+ public:
+  void Run() override { runs.fetch_add(1); }
+
+  std::atomic<int> runs{0};
+};
+
+grpc_core::Timestamp Ms(int64_t ms) {
+  return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(ms);
+}
+
+// Checks for timers at now and runs them. Returns how many ran.
+int CheckAt(TimerWheel* wheel, FakeHost* host, int64_t now) {
+  host->now = now;
+  absl::optional<std::vector<experimental::EventEngine::Closure*>> timers =
+      wheel->TimerCheck(nullptr);
+  EXPECT_TRUE(timers.has_value());
+  for (auto* closure : *timers) closure->Run();
+  return static_cast<int>(timers->size());
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, Add) {
+  Timer timers[20];
+  CountingClosure closures[20];
+  FakeHost host;
+  host.now = 100;
+  TimerWheel wheel(&host);
+
+  for (int i = 0; i < 10; i++) {
+    wheel.TimerInit(&timers[i], Ms(110), &closures[i]);
+  }
+  for (int i = 10; i < 20; i++) {
+    wheel.TimerInit(&timers[i], Ms(1110), &closures[i]);
+  }
+
+  EXPECT_EQ(CheckAt(&wheel, &host, 600), 10);
+  for (int i = 0; i < 10; i++) EXPECT_EQ(closures[i].runs, 1);
+  EXPECT_EQ(CheckAt(&wheel, &host, 700), 0);
+  EXPECT_EQ(CheckAt(&wheel, &host, 1600), 10);
+  for (int i = 10; i < 20; i++) EXPECT_EQ(closures[i].runs, 1);
+  EXPECT_EQ(CheckAt(&wheel, &host, 1700), 0);
+}
+
+// Timers fire at their deadline and not before, whichever level of the wheel
+// or the overflow list they start in.
+TEST(TimerWheelTest, FiresAtDeadlineOnEveryLevel) {
+  const int64_t kStart = 12345;
+  const std::vector<int64_t> offsets = {
+      0,        1,        63,       64,       65,     4095,
+      4096,     4097,     262143,   262144,   262145, 16777215,
+      16777216, 16777217, 50000000, 2160000000};
+  std::vector<Timer> timers(offsets.size());
+  std::vector<CountingClosure> closures(offsets.size());
+  FakeHost host;
+  host.now = kStart;
+  TimerWheel wheel(&host);
+  for (size_t i = 0; i < offsets.size(); i++) {
+    wheel.TimerInit(&timers[i], Ms(kStart + offsets[i]), &closures[i]);
+  }
+  for (size_t i = 0; i < offsets.size(); i++) {
+    if (offsets[i] > 0) {
+      EXPECT_EQ(CheckAt(&wheel, &host, kStart + offsets[i] - 1), 0)
+          << "offset " << offsets[i];
+    }
+    EXPECT_EQ(CheckAt(&wheel, &host, kStart + offsets[i]), 1)
+        << "offset " << offsets[i];
+    EXPECT_EQ(closures[i].runs, 1);
+  }
+}
+
+TEST(TimerWheelTest, ReportsNextEvent) {
+  FakeHost host;
+  host.now = 1000;
+  TimerWheel wheel(&host);
+  Timer timer;
+  CountingClosure closure;
+  wheel.TimerInit(&timer, Ms(1500), &closure);
+  EXPECT_EQ(host.kicks, 1);
+  // The wheel may need to wake up early to cascade the timer to a lower
+  // level, but never later than the deadline.
+  for (;;) {
+    grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+    auto timers = wheel.TimerCheck(&next);
+    ASSERT_TRUE(timers.has_value());
+    if (!timers->empty()) break;
+    ASSERT_GT(next.milliseconds_after_process_epoch(), host.now.load());
+    ASSERT_LE(next.milliseconds_after_process_epoch(), 1500);
+    host.now = next.milliseconds_after_process_epoch();
+  }
+  EXPECT_EQ(host.now, 1500);
+  // An earlier timer kicks the host, a later one does not.
+  wheel.TimerInit(&timer, Ms(3000), &closure);
+  int kicks = host.kicks;
+  Timer earlier;
+  wheel.TimerInit(&earlier, Ms(2000), &closure);
+  EXPECT_EQ(host.kicks, kicks + 1);
+  kicks = host.kicks;
+  Timer later;
+  wheel.TimerInit(&later, Ms(2500), &closure);
+  EXPECT_EQ(host.kicks, kicks);
+  EXPECT_TRUE(wheel.TimerCancel(&timer));
+  EXPECT_TRUE(wheel.TimerCancel(&earlier));
+  EXPECT_TRUE(wheel.TimerCancel(&later));
+}
+
+// Timers due at or before the time of the last check run at the next one.
+TEST(TimerWheelTest, PastDeadlines) {
+  Timer timers[3];
+  CountingClosure closures[3];
+  FakeHost host;
+  TimerWheel wheel(&host);
+  wheel.TimerInit(&timers[0], Ms(200), &closures[0]);
+  EXPECT_EQ(CheckAt(&wheel, &host, 100), 0);
+  wheel.TimerInit(&timers[1], Ms(100), &closures[1]);
+  wheel.TimerInit(&timers[2], grpc_core::Timestamp::InfPast(), &closures[2]);
+  EXPECT_EQ(CheckAt(&wheel, &host, 100), 2);
+  EXPECT_EQ(closures[1].runs, 1);
+  EXPECT_EQ(closures[2].runs, 1);
+  EXPECT_EQ(CheckAt(&wheel, &host, 200), 1);
+  EXPECT_EQ(closures[0].runs, 1);
+}
+
+TEST(TimerWheelTest, Cancel) {
+  Timer timers[4];
+  CountingClosure closures[4];
+  FakeHost host;
+  TimerWheel wheel(&host);
+  wheel.TimerInit(&timers[0], Ms(1), &closures[0]);
+  wheel.TimerInit(&timers[1], Ms(100), &closures[1]);
+  wheel.TimerInit(&timers[2], Ms(100000), &closures[2]);
+  wheel.TimerInit(&timers[3],
+                  Ms(std::numeric_limits<int64_t>::max() - 1), &closures[3]);
+  EXPECT_EQ(CheckAt(&wheel, &host, 2), 1);
+  EXPECT_FALSE(wheel.TimerCancel(&timers[0]));
+  EXPECT_TRUE(wheel.TimerCancel(&timers[1]));
+  EXPECT_TRUE(wheel.TimerCancel(&timers[2]));
+  EXPECT_TRUE(wheel.TimerCancel(&timers[3]));
+  EXPECT_FALSE(wheel.TimerCancel(&timers[1]));
+  EXPECT_EQ(CheckAt(&wheel, &host, 1000000), 0);
+  EXPECT_EQ(closures[0].runs, 1);
+  for (int i = 1; i < 4; i++) EXPECT_EQ(closures[i].runs, 0);
+}
+
+// Adds, cancels and expires timers at random, and checks that the expired
+// timers are exactly the uncancelled ones with a deadline that passed.
+TEST(TimerWheelTest, RandomOperations) {
+  constexpr int kTimers = 20000;
+  std::mt19937 rng(42);
+  std::vector<Timer> timers(kTimers);
+  std::vector<CountingClosure> closures(kTimers);
+  std::vector<int64_t> deadlines(kTimers);
+  std::vector<bool> cancelled(kTimers, false);
+  FakeHost host;
+  host.now = 1000;
+  TimerWheel wheel(&host);
+  int next_timer = 0;
+  while (next_timer < kTimers) {
+    for (int i = 0; i < 100 && next_timer < kTimers; i++, next_timer++) {
+      // Mostly short deadlines, some far enough for the top levels.
+      const int64_t range = (rng() % 4 == 0) ? 100000000 : 5000;
+      deadlines[next_timer] = host.now + static_cast<int64_t>(rng() % range);
+      wheel.TimerInit(&timers[next_timer], Ms(deadlines[next_timer]),
+                      &closures[next_timer]);
+    }
+    for (int i = 0; i < 30; i++) {
+      const int t = rng() % next_timer;
+      const bool pending = !cancelled[t] && closures[t].runs == 0;
+      EXPECT_EQ(wheel.TimerCancel(&timers[t]), pending);
+      if (pending) cancelled[t] = true;
+    }
+    CheckAt(&wheel, &host, host.now + static_cast<int64_t>(rng() % 300));
+    for (int t = 0; t < next_timer; t++) {
+      const int expected = !cancelled[t] && deadlines[t] <= host.now ? 1 : 0;
+      ASSERT_EQ(closures[t].runs, expected)
+          << "timer " << t << " deadline " << deadlines[t] << " now "
+          << host.now;
+    }
+  }
+  CheckAt(&wheel, &host, host.now + 200000000);
+  for (int t = 0; t < kTimers; t++) {
+    EXPECT_EQ(closures[t].runs, cancelled[t] ? 0 : 1);
+  }
+}
+
+// Timers added from several threads, each to its own wheel, are cancelled
+// from and expire on other threads.
+TEST(TimerWheelTest, ManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kTimersPerThread = 1000;
+  std::vector<Timer> timers(kThreads * kTimersPerThread);
+  std::vector<CountingClosure> closures(kThreads * kTimersPerThread);
+  FakeHost host;
+  host.now = 1;
+  TimerWheel wheel(&host);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < kTimersPerThread; j++) {
+        const int t = i * kTimersPerThread + j;
+        wheel.TimerInit(&timers[t], Ms(2 + t % 5000), &closures[t]);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  threads.clear();
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < kTimersPerThread; j += 2) {
+        const int t = ((i + 1) % kThreads) * kTimersPerThread + j;
+        EXPECT_TRUE(wheel.TimerCancel(&timers[t]));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(CheckAt(&wheel, &host, 10000), kThreads * kTimersPerThread / 2);
+  for (int t = 0; t < kThreads * kTimersPerThread; t++) {
+    EXPECT_EQ(closures[t].runs, t % 2 == 0 ? 0 : 1);
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int64_t kGranularityMs = 100;
+
+// A timer with a closure that records how often, and with which error, it
+// ran.
+class TestTimer {
+ public:
+  TestTimer() { GRPC_CLOSURE_INIT(&closure_, OnDone, this, nullptr); }
+
+  void Init(Timestamp deadline) { timer_.Init(deadline, &closure_); }
+  void Cancel() { timer_.Cancel(); }
+
+  int runs() const { return runs_.load(); }
+  bool WaitForRun(absl::Duration timeout) {
+    return done_.WaitForNotificationWithTimeout(timeout);
+  }
+  absl::Status status() {
+    MutexLock lock(&mu_);
+    return status_;
+  }
+
+ private:
+  static void OnDone(void* arg, grpc_error_handle error) {
+    TestTimer* self = static_cast<TestTimer*>(arg);
+    {
+      MutexLock lock(&self->mu_);
+      self->status_ = error;
+    }
+    if (self->runs_.fetch_add(1) == 0) self->done_.Notify();
+  }
+
+  CoalescedDeadlineTimer timer_;
+  grpc_closure closure_;
+  std::atomic<int> runs_{0};
+  absl::Notification done_;
+  Mutex mu_;
+  absl::Status status_ ABSL_GUARDED_BY(mu_);
+};
+
+// The first millisecond of a granularity window an hour from now: every
+// deadline in [start, start + kGranularityMs) shares one bucket.
+Timestamp FarWindowStart() {
+  int64_t ms =
+      (Timestamp::Now() + Duration::Hours(1)).milliseconds_after_process_epoch();
+  return Timestamp::FromMillisecondsAfterProcessEpoch(
+      ms / kGranularityMs * kGranularityMs + 1);
+}
+
+// Leaves the shard of this thread with a known idle bucket, so that the
+// tests below can count buckets whatever the earlier tests left behind.
+Timestamp PrimeIdleBucket() {
+  Timestamp deadline = FarWindowStart() + Duration::Hours(1);
+  TestTimer timer;
+  timer.Init(deadline);
+  timer.Cancel();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(timer.runs(), 1);
+  return deadline;
+}
+
+TEST(CoalescedDeadlineTimerTest, DeadlinesInOneWindowShareABucket) {
+  ExecCtx exec_ctx;
+  PrimeIdleBucket();
+  const size_t base = CoalescedDeadlineTimer::TestOnlyNumPendingBuckets();
+  const Timestamp start = FarWindowStart();
+  std::deque<TestTimer> timers(kGranularityMs);
+  for (int64_t i = 0; i < kGranularityMs; i++) {
+    timers[i].Init(start + Duration::Milliseconds(i));
+  }
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base + 1);
+  // The next window gets a bucket of its own.
+  TestTimer next_window;
+  next_window.Init(start + Duration::Milliseconds(kGranularityMs));
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base + 2);
+  next_window.Cancel();
+  for (auto& timer : timers) timer.Cancel();
+  exec_ctx.Flush();
+  for (auto& timer : timers) {
+    EXPECT_EQ(timer.runs(), 1);
+    EXPECT_EQ(timer.status(), absl::CancelledError());
+  }
+  EXPECT_EQ(next_window.runs(), 1);
+  // Emptying the buckets retired the primed idle bucket and then the next
+  // window's one: only the last emptied bucket is kept.
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base);
+}
+
+TEST(CoalescedDeadlineTimerTest, IdleBucketIsReusedUntilRetired) {
+  ExecCtx exec_ctx;
+  const Timestamp idle_deadline = PrimeIdleBucket();
+  const size_t base = CoalescedDeadlineTimer::TestOnlyNumPendingBuckets();
+  // A timer with the idle bucket's deadline reuses it.
+  TestTimer reused;
+  reused.Init(idle_deadline);
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base);
+  reused.Cancel();
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base);
+  // Emptying another bucket retires it.
+  TestTimer other;
+  other.Init(FarWindowStart());
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base + 1);
+  other.Cancel();
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base);
+  // So the old deadline needs a new bucket again.
+  TestTimer renewed;
+  renewed.Init(idle_deadline);
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base + 1);
+  renewed.Cancel();
+  exec_ctx.Flush();
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), base);
+  EXPECT_EQ(reused.runs(), 1);
+  EXPECT_EQ(other.runs(), 1);
+  EXPECT_EQ(renewed.runs(), 1);
+}
+
+TEST(CoalescedDeadlineTimerTest, CancelAfterFireIsANoOp) {
+  ExecCtx exec_ctx;
+  TestTimer timer;
+  timer.Init(Timestamp::Now() + Duration::Milliseconds(10));
+  exec_ctx.Flush();
+  ASSERT_TRUE(timer.WaitForRun(absl::Seconds(30)));
+  EXPECT_EQ(timer.status(), absl::OkStatus());
+  timer.Cancel();
+  timer.Cancel();
+  exec_ctx.Flush();
+  EXPECT_EQ(timer.runs(), 1);
+  EXPECT_EQ(timer.status(), absl::OkStatus());
+}
+
+TEST(CoalescedDeadlineTimerTest, CancelRacingWithFireRunsClosureOnce) {
+  constexpr int kNumTimers = 1000;
+  ExecCtx exec_ctx;
+  // Start cancelling shortly before the shared deadline, slowly enough for
+  // the timer to fire half way through.
+  const Timestamp deadline =
+      Timestamp::FromMillisecondsAfterProcessEpoch(
+          (Timestamp::Now() + Duration::Milliseconds(2 * kGranularityMs))
+              .milliseconds_after_process_epoch() /
+          kGranularityMs * kGranularityMs);
+  std::deque<TestTimer> timers(kNumTimers);
+  for (auto& timer : timers) timer.Init(deadline);
+  exec_ctx.Flush();
+  while (Timestamp::Now() < deadline - Duration::Milliseconds(10)) {
+    absl::SleepFor(absl::Milliseconds(1));
+    exec_ctx.InvalidateNow();
+  }
+  for (auto& timer : timers) {
+    timer.Cancel();
+    exec_ctx.Flush();
+    absl::SleepFor(absl::Microseconds(20));
+  }
+  int num_fired = 0;
+  for (auto& timer : timers) {
+    ASSERT_TRUE(timer.WaitForRun(absl::Seconds(30)));
+    EXPECT_EQ(timer.runs(), 1);
+    if (timer.status().ok()) {
+      num_fired++;
+    } else {
+      EXPECT_EQ(timer.status(), absl::CancelledError());
+    }
+  }
+  gpr_log(GPR_INFO, "%d of %d timers fired before they were cancelled",
+          num_fired, kNumTimers);
+}
+
+// Shuts gRPC down, so it must stay the last test.
+TEST(CoalescedDeadlineTimerTest, ShutdownRunsPendingTimers) {
+  TestTimer pending;
+  TestTimer idle;
+  {
+    ExecCtx exec_ctx;
+    pending.Init(FarWindowStart());
+    idle.Init(FarWindowStart() + Duration::Hours(1));
+    idle.Cancel();
+  }
+  EXPECT_EQ(idle.runs(), 1);
+  EXPECT_GE(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), 2);
+  grpc_shutdown_blocking();
+  ASSERT_TRUE(pending.WaitForRun(absl::Seconds(30)));
+  EXPECT_EQ(pending.runs(), 1);
+  EXPECT_FALSE(pending.status().ok());
+  EXPECT_EQ(CoalescedDeadlineTimer::TestOnlyNumPendingBuckets(), 0);
+  grpc_init();
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_deadline_timer_granularity_ms,
+                        grpc_core::kGranularityMs);
+  grpc_init();
+  int retval = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return retval;
+}
@@ -200,6 +200,29 @@ TEST(WorkSerializerTest, CallbackDestroysWorkSerializer) {
   lock->Run([&]() { lock.reset(); }, DEBUG_LOCATION);
 }
 
+// Tests that callbacks need not be copyable, whether they run inline or are
+// queued.
+TEST(WorkSerializerTest, MoveOnlyCallbacks) {
+  grpc_core::WorkSerializer lock;
+  int sum = 0;
+  auto add = [&sum](std::unique_ptr<int> x) {
+    return [&sum, x = std::move(x)]() { sum += *x; };
+  };
+  lock.Run(add(std::make_unique<int>(1)), DEBUG_LOCATION);
+  EXPECT_EQ(sum, 1);
+  lock.Schedule(add(std::make_unique<int>(2)), DEBUG_LOCATION);
+  lock.Run(
+      [&]() {
+        // Runs ahead of the scheduled callback, which is still queued. The
+        // next one is queued behind it.
+        EXPECT_EQ(sum, 1);
+        lock.Run(add(std::make_unique<int>(3)), DEBUG_LOCATION);
+        EXPECT_EQ(sum, 1);
+      },
+      DEBUG_LOCATION);
+  EXPECT_EQ(sum, 6);
+}
+
 // Tests additional racy conditions when the last callback triggers work
 // serializer destruction.
 TEST(WorkSerializerTest, WorkSerializerDestructionRace) {
@@ -23,7 +23,10 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/thd_id.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "test/core/util/test_config.h"
@@ -139,6 +142,106 @@ TEST(CombinerTest, TestExecuteFinally) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+typedef struct {
+  size_t ctr;
+  size_t num_closures;
+  // Closures run by the thread that queued them.
+  gpr_thd_id caller;
+  size_t ran_on_caller;
+  gpr_event done;
+} quota_args;
+
+static void init_quota_args(quota_args* args, size_t num_closures) {
+  args->ctr = 0;
+  args->num_closures = num_closures;
+  args->caller = gpr_thd_currentid();
+  args->ran_on_caller = 0;
+  gpr_event_init(&args->done);
+}
+
+static void count_one(void* a, grpc_error_handle /*error*/) {
+  quota_args* args = static_cast<quota_args*>(a);
+  if (gpr_thd_currentid() == args->caller) ++args->ran_on_caller;
+  if (++args->ctr == args->num_closures) {
+    gpr_event_set(&args->done, reinterpret_cast<void*>(1));
+  }
+}
+
+TEST(CombinerTest, TestBatchQuota) {
+  gpr_log(GPR_DEBUG, "test_batch_quota");
+
+  grpc_core::Combiner* lock = grpc_combiner_create(3);
+  EXPECT_EQ(lock->batch_quota, 3u);
+  quota_args args;
+  init_quota_args(&args, 10);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < args.num_closures; i++) {
+      lock->Run(GRPC_CLOSURE_CREATE(count_one, &args, nullptr),
+                absl::OkStatus());
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+    ASSERT_NE(gpr_event_wait(&args.done, grpc_timeout_seconds_to_deadline(5)),
+              nullptr);
+  }
+  // This thread ran one turn's worth of closures, and the executor the rest.
+  EXPECT_EQ(args.ran_on_caller, 3u);
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_COMBINER_UNREF(lock, "test_batch_quota");
+}
+
+TEST(CombinerTest, TestNoBatchQuotaRunsUncontendedClosuresInline) {
+  gpr_log(GPR_DEBUG, "test_no_batch_quota_runs_uncontended_closures_inline");
+
+  grpc_core::Combiner* lock = grpc_combiner_create(0);
+  quota_args args;
+  init_quota_args(&args, 10);
+  const uint64_t offloads_before =
+      grpc_core::global_stats().Collect()->combiner_locks_offloaded;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < args.num_closures; i++) {
+      lock->Run(GRPC_CLOSURE_CREATE(count_one, &args, nullptr),
+                absl::OkStatus());
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  // Only this thread used the combiner, so it ran everything.
+  EXPECT_EQ(args.ctr, args.num_closures);
+  EXPECT_EQ(args.ran_on_caller, args.num_closures);
+  EXPECT_EQ(grpc_core::global_stats().Collect()->combiner_locks_offloaded,
+            offloads_before);
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_COMBINER_UNREF(lock, "test_no_batch_quota");
+}
+
+TEST(CombinerTest, TestBatchQuotaOffloads) {
+  gpr_log(GPR_DEBUG, "test_batch_quota_offloads");
+
+  grpc_core::Combiner* lock = grpc_combiner_create(2);
+  quota_args args;
+  init_quota_args(&args, 10);
+  const uint64_t offloads_before =
+      grpc_core::global_stats().Collect()->combiner_locks_offloaded;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < args.num_closures; i++) {
+      lock->Run(GRPC_CLOSURE_CREATE(count_one, &args, nullptr),
+                absl::OkStatus());
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+    // This thread ran at most one turn's worth of closures: the executor runs
+    // the rest, two at a time.
+    ASSERT_NE(gpr_event_wait(&args.done, grpc_timeout_seconds_to_deadline(5)),
+              nullptr);
+  }
+  EXPECT_GE(grpc_core::global_stats().Collect()->combiner_locks_offloaded -
+                offloads_before,
+            4u);
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_COMBINER_UNREF(lock, "test_batch_quota_offloads");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
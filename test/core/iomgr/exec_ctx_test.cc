@@ -0,0 +1,143 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Schedule a closure on the current ExecCtx that counts its runs.
+void ScheduleCounted(int* runs) {
+  ExecCtx::Run(DEBUG_LOCATION,
+               NewClosure([runs](grpc_error_handle) { ++*runs; }),
+               absl::OkStatus());
+}
+
+TEST(ExecCtxTest, TopLevelExecCtxFlushesOnDestruction) {
+  int runs = 0;
+  {
+    ExecCtx exec_ctx;
+    EXPECT_EQ(ExecCtx::Get(), &exec_ctx);
+    ScheduleCounted(&runs);
+    EXPECT_EQ(runs, 0);
+  }
+  EXPECT_EQ(runs, 1);
+  EXPECT_EQ(ExecCtx::Get(), nullptr);
+}
+
+TEST(ExecCtxTest, NestedExecCtxPassesThrough) {
+  ExecCtx outer;
+  int runs = 0;
+  {
+    ExecCtx inner;
+    EXPECT_EQ(ExecCtx::Get(), &outer);
+    ScheduleCounted(&runs);
+  }
+  // The closure went to the outer ExecCtx, and runs when it flushes.
+  EXPECT_EQ(runs, 0);
+  EXPECT_TRUE(outer.HasWork());
+  outer.Flush();
+  EXPECT_EQ(runs, 1);
+}
+
+TEST(ExecCtxTest, NestedExecCtxClosuresRunWhenTheActiveOneFinishes) {
+  ASSERT_TRUE(IsPassThroughExecCtxEnabled());
+  int runs = 0;
+  {
+    ExecCtx outer;
+    for (int i = 0; i < 3; i++) {
+      ExecCtx inner;
+      ScheduleCounted(&runs);
+    }
+    // None of the nested scopes flushed when it ended.
+    EXPECT_EQ(runs, 0);
+  }
+  EXPECT_EQ(runs, 3);
+}
+
+TEST(ExecCtxTest, NestedFlushFlushesTheActiveExecCtx) {
+  ExecCtx outer;
+  int runs = 0;
+  ExecCtx inner;
+  ScheduleCounted(&runs);
+  EXPECT_TRUE(inner.Flush());
+  EXPECT_EQ(runs, 1);
+  EXPECT_FALSE(outer.HasWork());
+}
+
+TEST(ExecCtxTest, NestedExecCtxSharesCachedTime) {
+  ExecCtx outer;
+  const Timestamp now = Timestamp::FromMillisecondsAfterProcessEpoch(12345);
+  outer.TestOnlySetNow(now);
+  {
+    ExecCtx inner;
+    EXPECT_EQ(inner.Now(), now);
+    inner.TestOnlySetNow(now + Duration::Seconds(1));
+  }
+  EXPECT_EQ(outer.Now(), now + Duration::Seconds(1));
+}
+
+TEST(ExecCtxTest, ExecCtxCreatedWhileFlushingIsNotNested) {
+  ExecCtx outer;
+  int runs = 0;
+  ExecCtx::Run(DEBUG_LOCATION, NewClosure([&runs](grpc_error_handle) {
+                 {
+                   ExecCtx inner;
+                   EXPECT_EQ(ExecCtx::Get(), &inner);
+                   ScheduleCounted(&runs);
+                 }
+                 // The inner ExecCtx ran its closure before going away.
+                 EXPECT_EQ(runs, 1);
+               }),
+               absl::OkStatus());
+  outer.Flush();
+  EXPECT_EQ(runs, 1);
+}
+
+TEST(ExecCtxTest, ExecCtxWithFlagsIsNotNested) {
+  ExecCtx outer;
+  int runs = 0;
+  {
+    ExecCtx inner(0);
+    EXPECT_EQ(ExecCtx::Get(), &inner);
+    ScheduleCounted(&runs);
+  }
+  EXPECT_EQ(runs, 1);
+  EXPECT_EQ(ExecCtx::Get(), &outer);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::ForceEnableExperiment("pass_through_exec_ctx", true);
+  grpc_init();
+  int retval = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return retval;
+}
@@ -0,0 +1,164 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Floods a server that has a small resource quota with large messages, and
+// checks that the memory use of the process stays bounded while the server's
+// buffers shrink under memory pressure.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/resource_quota.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/memory_usage/memstats.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr size_t kQuotaSize = 16 * 1024 * 1024;
+constexpr size_t kMessageSize = 1024 * 1024;
+constexpr int kStreams = 8;
+constexpr int kMessagesPerStream = 64;
+// How much the resident set may grow during the flood, in kb. The flood
+// sends 512MB, the server quota is 16MB and each client stream buffers a few
+// messages: this takes about 50MB, against more than 100MB without a quota.
+constexpr long kMaxRssGrowthKb = 96 * 1024;
+
+// Reads and drops every message of the stream.
+class DrainService : public EchoTestService::Service {
+ public:
+  Status RequestStream(ServerContext* /*context*/,
+                       ServerReader<EchoRequest>* reader,
+                       EchoResponse* response) override {
+    EchoRequest request;
+    size_t received = 0;
+    while (reader->Read(&request)) {
+      received += request.message().size();
+    }
+    response->set_message(absl::StrCat(received));
+    return Status::OK;
+  }
+};
+
+class BufferPressureStressTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ResourceQuota quota("buffer_pressure_stress_test");
+    quota.Resize(kQuotaSize);
+    ServerBuilder builder;
+    int port;
+    builder.AddListeningPort("localhost:0", InsecureServerCredentials(), &port);
+    builder.SetResourceQuota(quota);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    server_address_ = absl::StrCat("localhost:", port);
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  // Sends kMessagesPerStream large messages on one stream of its own
+  // connection. Returns true if the server received them all.
+  bool Flood() {
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto stub = EchoTestService::NewStub(CreateCustomChannel(
+        server_address_, InsecureChannelCredentials(), args));
+    EchoRequest request;
+    request.set_message(std::string(kMessageSize, 'a'));
+    EchoResponse response;
+    ClientContext context;
+    auto stream = stub->RequestStream(&context, &response);
+    for (int i = 0; i < kMessagesPerStream; i++) {
+      if (!stream->Write(request)) break;
+    }
+    stream->WritesDone();
+    Status status = stream->Finish();
+    // The server may cancel streams or close connections it has no memory
+    // for, but must not fail them for any other reason.
+    EXPECT_TRUE(status.ok() ||
+                status.error_code() == StatusCode::RESOURCE_EXHAUSTED ||
+                status.error_code() == StatusCode::UNAVAILABLE)
+        << status.error_code() << ": " << status.error_message();
+    return status.ok();
+  }
+
+  std::string server_address_;
+  DrainService service_;
+  std::unique_ptr<Server> server_;
+};
+
+TEST_F(BufferPressureStressTest, RssStaysBoundedUnderLargeMessageFlood) {
+  // Warm up, so that the baseline includes what any connection needs.
+  Flood();
+  const long baseline_kb = MemStats::Snapshot().rss;
+  std::atomic<bool> done{false};
+  std::atomic<long> peak_kb{baseline_kb};
+  std::thread sampler([&done, &peak_kb] {
+    while (!done.load(std::memory_order_relaxed)) {
+      peak_kb.store(std::max(peak_kb.load(std::memory_order_relaxed),
+                             MemStats::Snapshot().rss),
+                    std::memory_order_relaxed);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+  std::atomic<int> ok_streams{0};
+  std::vector<std::thread> threads;
+  threads.reserve(kStreams);
+  for (int i = 0; i < kStreams; i++) {
+    threads.emplace_back([this, &ok_streams] {
+      if (Flood()) ok_streams.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done.store(true, std::memory_order_relaxed);
+  sampler.join();
+  EXPECT_GT(ok_streams.load(), 0);
+  EXPECT_LT(peak_kb.load() - baseline_kb, kMaxRssGrowthKb)
+      << "baseline " << baseline_kb << "kb, peak " << peak_kb.load() << "kb";
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
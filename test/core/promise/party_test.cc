@@ -0,0 +1,303 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/promise/party.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Party that runs inline when woken, or, if deferred, when the test says so.
+class TestParty final : public Party {
+ public:
+  explicit TestParty(bool deferred = false) : deferred_(deferred) {}
+
+  // Run the party if a run was scheduled: returns true if it was.
+  bool RunScheduled() {
+    if (!scheduled_) return false;
+    scheduled_ = false;
+    RunParty();
+    return true;
+  }
+
+ private:
+  void ScheduleWakeup() override {
+    if (deferred_) {
+      EXPECT_FALSE(scheduled_);
+      scheduled_ = true;
+    } else {
+      RunParty();
+    }
+  }
+  void PartyOver() override { delete this; }
+
+  const bool deferred_;
+  bool scheduled_ = false;
+};
+
+using TestPartyPtr = OrphanablePtr<TestParty>;
+
+// A promise that stays pending until released, counting its polls.
+class Gate {
+ public:
+  auto Wait() {
+    return [this]() -> Poll<int> {
+      MutexLock lock(&mu_);
+      ++polls_;
+      if (released_) return polls_;
+      waker_ = Activity::current()->MakeOwningWaker();
+      return Pending{};
+    };
+  }
+
+  void Release() {
+    Waker waker;
+    {
+      MutexLock lock(&mu_);
+      released_ = true;
+      waker = std::move(waker_);
+    }
+    waker.Wakeup();
+  }
+
+  // Wake the waiting promise without releasing it.
+  void Poke() {
+    Waker waker;
+    {
+      MutexLock lock(&mu_);
+      waker = std::move(waker_);
+    }
+    waker.Wakeup();
+  }
+
+  int polls() {
+    MutexLock lock(&mu_);
+    return polls_;
+  }
+
+ private:
+  Mutex mu_;
+  bool released_ ABSL_GUARDED_BY(mu_) = false;
+  int polls_ ABSL_GUARDED_BY(mu_) = 0;
+  Waker waker_ ABSL_GUARDED_BY(mu_);
+};
+
+TEST(PartyTest, Noop) { TestPartyPtr party = MakeOrphanable<TestParty>(); }
+
+TEST(PartyTest, CanSpawnAndComplete) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  int result = 0;
+  party->Spawn([]() { return []() -> Poll<int> { return 42; }; },
+               [&result](int x) { result = x; });
+  EXPECT_EQ(result, 42);
+}
+
+TEST(PartyTest, OnlyWokenParticipantIsPolled) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  Gate a;
+  Gate b;
+  int a_done = 0;
+  int b_done = 0;
+  party->Spawn([&a]() { return a.Wait(); }, [&a_done](int x) { a_done = x; });
+  party->Spawn([&b]() { return b.Wait(); }, [&b_done](int x) { b_done = x; });
+  EXPECT_EQ(a.polls(), 1);
+  EXPECT_EQ(b.polls(), 1);
+  a.Poke();
+  EXPECT_EQ(a.polls(), 2);
+  EXPECT_EQ(b.polls(), 1);
+  b.Release();
+  EXPECT_EQ(a.polls(), 2);
+  EXPECT_EQ(b_done, 2);
+  a.Release();
+  EXPECT_EQ(a_done, 3);
+}
+
+TEST(PartyTest, WakeupsCoalesceUntilTheRun) {
+  TestPartyPtr party = MakeOrphanable<TestParty>(true);
+  Gate a;
+  Gate b;
+  int a_done = 0;
+  int b_done = 0;
+  party->Spawn([&a]() { return a.Wait(); }, [&a_done](int x) { a_done = x; });
+  party->Spawn([&b]() { return b.Wait(); }, [&b_done](int x) { b_done = x; });
+  // One run for both spawns.
+  EXPECT_TRUE(party->RunScheduled());
+  EXPECT_FALSE(party->RunScheduled());
+  EXPECT_EQ(a.polls(), 1);
+  EXPECT_EQ(b.polls(), 1);
+  a.Release();
+  b.Release();
+  EXPECT_EQ(a_done, 0);
+  EXPECT_TRUE(party->RunScheduled());
+  EXPECT_FALSE(party->RunScheduled());
+  EXPECT_EQ(a_done, 2);
+  EXPECT_EQ(b_done, 2);
+  // Orphaning needs a run too, to destroy the party.
+  TestParty* p = party.get();
+  party.reset();
+  EXPECT_TRUE(p->RunScheduled());
+}
+
+TEST(PartyTest, BulkSpawnRunsOnce) {
+  TestPartyPtr party = MakeOrphanable<TestParty>(true);
+  int results[3] = {};
+  {
+    Party::BulkSpawner spawner(party.get());
+    for (int i = 0; i < 3; i++) {
+      spawner.Spawn([i]() { return [i]() -> Poll<int> { return i + 1; }; },
+                    [&results, i](int x) { results[i] = x; });
+    }
+    EXPECT_FALSE(party->RunScheduled());
+  }
+  EXPECT_TRUE(party->RunScheduled());
+  EXPECT_FALSE(party->RunScheduled());
+  EXPECT_EQ(results[0], 1);
+  EXPECT_EQ(results[1], 2);
+  EXPECT_EQ(results[2], 3);
+  TestParty* p = party.get();
+  party.reset();
+  EXPECT_TRUE(p->RunScheduled());
+}
+
+TEST(PartyTest, CanForceImmediateRepoll) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  int polls = 0;
+  int result = 0;
+  party->Spawn(
+      [&polls]() {
+        return [&polls]() -> Poll<int> {
+          if (++polls == 3) return polls;
+          Activity::current()->ForceImmediateRepoll();
+          return Pending{};
+        };
+      },
+      [&result](int x) { result = x; });
+  EXPECT_EQ(result, 3);
+}
+
+TEST(PartyTest, ParticipantsCanSpawn) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  TestParty* p = party.get();
+  Gate gate;
+  int inner = 0;
+  int outer = 0;
+  party->Spawn(
+      [p, &gate, &inner]() {
+        p->Spawn([&gate]() { return gate.Wait(); },
+                 [&inner](int x) { inner = x; });
+        return []() -> Poll<int> { return 1; };
+      },
+      [&outer](int x) { outer = x; });
+  EXPECT_EQ(outer, 1);
+  EXPECT_EQ(gate.polls(), 1);
+  gate.Release();
+  EXPECT_EQ(inner, 2);
+}
+
+TEST(PartyTest, OrphanDestroysParticipants) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  Gate gate;
+  auto alive = std::make_shared<int>(0);
+  bool completed = false;
+  party->Spawn(
+      [&gate, alive]() {
+        return [wait = gate.Wait(), alive]() mutable { return wait(); };
+      },
+      [&completed](int) { completed = true; });
+  EXPECT_EQ(gate.polls(), 1);
+  EXPECT_EQ(alive.use_count(), 2);
+  party.reset();
+  EXPECT_EQ(alive.use_count(), 1);
+  EXPECT_FALSE(completed);
+}
+
+TEST(PartyTest, NonOwningWakerWakesWhileThePartyLives) {
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  Waker waker;
+  int polls = 0;
+  party->Spawn(
+      [&waker, &polls]() {
+        return [&waker, &polls]() -> Poll<int> {
+          if (++polls == 2) return polls;
+          waker = Activity::current()->MakeNonOwningWaker();
+          return Pending{};
+        };
+      },
+      [](int) {});
+  EXPECT_EQ(polls, 1);
+  waker.Wakeup();
+  EXPECT_EQ(polls, 2);
+  party->Spawn(
+      [&waker]() {
+        return [&waker]() -> Poll<int> {
+          waker = Activity::current()->MakeNonOwningWaker();
+          return Pending{};
+        };
+      },
+      [](int) {});
+  party.reset();
+  // The party is gone: nothing to wake.
+  waker.Wakeup();
+}
+
+TEST(PartyTest, ThreadedWakeups) {
+  constexpr int kThreads = 4;
+  constexpr int kWakeupsPerThread = 1000;
+  TestPartyPtr party = MakeOrphanable<TestParty>();
+  Mutex mu;
+  int count = 0;
+  Waker waker;
+  std::atomic<bool> done{false};
+  party->Spawn(
+      [&]() {
+        return [&]() -> Poll<int> {
+          MutexLock lock(&mu);
+          if (count == kThreads * kWakeupsPerThread) return count;
+          waker = Activity::current()->MakeOwningWaker();
+          return Pending{};
+        };
+      },
+      [&done](int) { done.store(true); });
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kWakeupsPerThread; j++) {
+        Waker w;
+        {
+          MutexLock lock(&mu);
+          ++count;
+          w = std::move(waker);
+        }
+        w.Wakeup();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_TRUE(done.load());
+}
+
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
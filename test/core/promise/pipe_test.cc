@@ -17,8 +17,11 @@
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -28,9 +31,13 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/promise/activity.h"
 #include "src/core/lib/promise/detail/basic_join.h"
+#include "src/core/lib/promise/context.h"
 #include "src/core/lib/promise/join.h"
+#include "src/core/lib/promise/loop.h"
 #include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/poll.h"
 #include "src/core/lib/promise/seq.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 #include "test/core/promise/test_wakeup_schedulers.h"
@@ -203,6 +210,137 @@ TEST(PipeTest, CanFlowControlThroughManyStages) {
   ASSERT_TRUE(*done);
 }
 
+TEST(PipeTest, CanSendAndReceiveBatches) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  std::vector<int> received;
+  int num_batches = 0;
+  MakeActivity(
+      [&received, &num_batches] {
+        Pipe<int> pipe(GetContext<Arena>(), 4);
+        PipeBatch<int> values;
+        for (int i = 0; i < 10; i++) values.push_back(i);
+        auto sender = std::make_shared<std::unique_ptr<PipeSender<int>>>(
+            std::make_unique<PipeSender<int>>(std::move(pipe.sender)));
+        return Seq(
+            // Concurrently:
+            // - push 0..9 into the pipe as one batch, then close the sender
+            // - and receive batches until the pipe closes.
+            Join(Seq((*sender)->PushBatch(std::move(values)),
+                     [sender](bool ok) {
+                       sender->reset();
+                       return ok;
+                     }),
+                 Loop([receiver = std::move(pipe.receiver), &received,
+                       &num_batches]() mutable {
+                   return Map(receiver.NextBatch(),
+                              [&received, &num_batches](
+                                  absl::optional<PipeBatch<int>> batch)
+                                  -> LoopCtl<absl::Status> {
+                                if (!batch.has_value()) {
+                                  return absl::OkStatus();
+                                }
+                                ++num_batches;
+                                received.insert(received.end(), batch->begin(),
+                                                batch->end());
+                                return Continue();
+                              });
+                 })),
+            [](std::tuple<bool, absl::Status> result) {
+              EXPECT_EQ(result, std::make_tuple(true, absl::OkStatus()));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+  EXPECT_EQ(received, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  // At most four values fit in the pipe at a time.
+  EXPECT_EQ(num_batches, 3);
+}
+
+TEST(PipeTest, CanSendOneByOneThroughBatchPipe) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        Pipe<int> pipe(GetContext<Arena>(), 4);
+        auto push = pipe.sender.Push(1);
+        auto next = pipe.receiver.Next();
+        return Seq(
+            // Push waits for its value to be received, whatever the capacity.
+            Join(Seq(std::move(push),
+                     [sender = std::move(pipe.sender)](bool ok) mutable {
+                       EXPECT_TRUE(ok);
+                       return sender.Push(2);
+                     }),
+                 Seq(std::move(next),
+                     [receiver = std::move(pipe.receiver)](
+                         NextResult<int> r) mutable {
+                       EXPECT_EQ(r.value(), 1);
+                       return Map(receiver.Next(), [](NextResult<int> r) {
+                         return r.value();
+                       });
+                     })),
+            [](std::tuple<bool, int> result) {
+              EXPECT_EQ(result, std::make_tuple(true, 2));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(PipeTest, CanSeeClosedOnSendBatch) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        Pipe<int> pipe(GetContext<Arena>(), 2);
+        auto sender = std::move(pipe.sender);
+        auto receiver = std::make_shared<std::unique_ptr<PipeReceiver<int>>>(
+            std::make_unique<PipeReceiver<int>>(std::move(pipe.receiver)));
+        PipeBatch<int> values = {1, 2, 3};
+        return Seq(
+            // Concurrently:
+            // - push three values into a pipe with room for two, which will
+            //   stall because there is no reader
+            // - and close the receiver, which will fail the pending send.
+            Join(sender.PushBatch(std::move(values)),
+                 [receiver] {
+                   receiver->reset();
+                   return absl::OkStatus();
+                 }),
+            [](const std::tuple<bool, absl::Status>& result) {
+              EXPECT_EQ(result, std::make_tuple(false, absl::OkStatus()));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(PipeTest, MixingNextAndNextBatchIsFatal) {
+  EXPECT_DEATH_IF_SUPPORTED(
+      MakeActivity(
+          [] {
+            auto pipe = std::make_shared<Pipe<int>>(GetContext<Arena>(), 4);
+            return [pipe]() -> Poll<absl::Status> {
+              // Both just wait for a value, but a receiver must stick to one.
+              auto next = pipe->receiver.Next();
+              auto next_batch = pipe->receiver.NextBatch();
+              GPR_ASSERT(absl::holds_alternative<Pending>(next()));
+              GPR_ASSERT(absl::holds_alternative<Pending>(next_batch()));
+              return absl::OkStatus();
+            };
+          },
+          NoWakeupScheduler(), [](absl::Status) {},
+          MakeScopedArena(1024, g_memory_allocator)),
+      "");
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -0,0 +1,100 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Sizes of the buffers that shrink with memory pressure, under the
+// pressure_aware_buffer_sizing experiment.
+
+#include <stddef.h>
+
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "src/core/ext/transport/chttp2/transport/flow_control.h"
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+
+namespace grpc_core {
+namespace {
+
+BasicMemoryQuota::PressureInfo Pressure(
+    double pressure, size_t max_recommended_allocation_size =
+                         std::numeric_limits<size_t>::max()) {
+  return BasicMemoryQuota::PressureInfo{pressure, pressure,
+                                        max_recommended_allocation_size};
+}
+
+TEST(BufferSizingTest, AdjustBufferSize) {
+  EXPECT_EQ(Pressure(0.0, 1024 * 1024).AdjustBufferSize(1024, 65536), 65536);
+  EXPECT_EQ(Pressure(0.8, 1024 * 1024).AdjustBufferSize(1024, 65536), 65536);
+  EXPECT_NEAR(Pressure(0.9, 1024 * 1024).AdjustBufferSize(1024, 65536),
+              1024 + (65536 - 1024) / 2, 1);
+  EXPECT_EQ(Pressure(1.0, 1024 * 1024).AdjustBufferSize(1024, 65536), 1024);
+  // Never more than the maximum recommended allocation size...
+  EXPECT_EQ(Pressure(0.0, 1024 * 1024).AdjustBufferSize(1024, 4 * 1024 * 1024),
+            1024 * 1024);
+  // ... unless the minimum size is.
+  EXPECT_EQ(Pressure(0.0, 1024 * 1024)
+                .AdjustBufferSize(2 * 1024 * 1024, 4 * 1024 * 1024),
+            2 * 1024 * 1024);
+  // Sizes shrink monotonically with pressure.
+  size_t last = 65536;
+  for (double pressure = 0.0; pressure <= 1.0; pressure += 0.01) {
+    size_t size = Pressure(pressure, 1024 * 1024).AdjustBufferSize(1024, 65536);
+    EXPECT_LE(size, last);
+    last = size;
+  }
+}
+
+TEST(BufferSizingTest, SecureEndpointStagingBuffer) {
+  // Secure endpoints reserve between 1kB and 8kB for each staging buffer.
+  EXPECT_EQ(Pressure(0.5).AdjustBufferSize(1024, 8192), 8192);
+  EXPECT_NEAR(Pressure(0.9).AdjustBufferSize(1024, 8192), 1024 + 7168 / 2, 1);
+  EXPECT_EQ(Pressure(1.0).AdjustBufferSize(1024, 8192), 1024);
+}
+
+TEST(BufferSizingTest, FlowControlTargetUnchangedBelowThreshold) {
+  for (double pressure : {0.1, 0.5, 0.7}) {
+    EXPECT_EQ(chttp2::AdjustForMemoryPressure(Pressure(pressure), 20), 20);
+  }
+}
+
+TEST(BufferSizingTest, FlowControlTargetShrinksAboveThreshold) {
+  // The log2 target itself shrinks linearly from 70% to 90% pressure.
+  EXPECT_NEAR(chttp2::AdjustForMemoryPressure(Pressure(0.8), 20), 10, 1e-6);
+  EXPECT_NEAR(chttp2::AdjustForMemoryPressure(Pressure(0.85), 20), 5, 1e-6);
+  EXPECT_NEAR(chttp2::AdjustForMemoryPressure(Pressure(0.9), 20), 0, 1e-6);
+  EXPECT_EQ(chttp2::AdjustForMemoryPressure(Pressure(1.0), 20), 0);
+  double last = 20;
+  for (double pressure = 0.7; pressure <= 1.0; pressure += 0.01) {
+    double target = chttp2::AdjustForMemoryPressure(Pressure(pressure), 20);
+    EXPECT_LE(target, last);
+    last = target;
+    // Never larger than without the experiment, which shrinks the target
+    // from 80% to 90% pressure.
+    EXPECT_LE(target,
+              20 * (1 - Clamp((pressure - 0.8) / 0.1, 0.0, 1.0)) + 1e-6)
+        << pressure;
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::ForceEnableExperiment("pressure_aware_buffer_sizing", true);
+  return RUN_ALL_TESTS();
+}
@@ -169,6 +169,32 @@ TEST(MemoryQuotaTest, NoBunchingIfIdle) {
   EXPECT_GE(count_reclaimers_called.load(std::memory_order_relaxed), 8000);
 }
 
+TEST(MemoryQuotaTest, PressureRecoversAfterManyThreads) {
+  // Memory taken and returned from many threads, possibly through per-CPU
+  // slabs, all finds its way back: pressure goes back to (almost) zero.
+  MemoryQuota memory_quota("foo");
+  memory_quota.SetSize(1024 * 1024 * 1024);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&memory_quota] {
+      ExecCtx exec_ctx;
+      auto large = memory_quota.CreateMemoryAllocator("large");
+      for (int j = 0; j < 1000; j++) {
+        auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+        auto n = memory_allocator.Reserve(MemoryRequest(1, 65536));
+        large.Release(large.Reserve(MemoryRequest(3 * 1024 * 1024)));
+        memory_allocator.Release(n);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ExecCtx exec_ctx;
+  auto memory_owner = memory_quota.CreateMemoryOwner("check");
+  EXPECT_LT(memory_owner.GetPressureInfo().instantaneous_pressure, 0.011);
+}
+
 }  // namespace testing
 
 namespace memory_quota_detail {
@@ -16,6 +16,11 @@
 
 #include "src/core/lib/security/authorization/evaluate_args.h"
 
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -179,6 +184,88 @@ TEST_F(EvaluateArgsTest, GetSubjectFailDuplicateProperty) {
   EXPECT_TRUE(args.GetSubject().empty());
 }
 
+TEST_F(EvaluateArgsTest, PeerMatchCacheReturnsSameResultsPerKey) {
+  EvaluateArgs args = util_.MakeEvaluateArgs();
+  auto* cache = args.GetPeerMatchCache();
+  ASSERT_NE(cache, nullptr);
+  auto results = cache->Get(1, 2);
+  ASSERT_NE(results, nullptr);
+  EXPECT_EQ(cache->Get(1, 2), results);
+  EXPECT_NE(cache->Get(2, 2), results);
+}
+
+TEST_F(EvaluateArgsTest, PeerMatchCacheComputesEachResultLazilyOnce) {
+  EvaluateArgs args = util_.MakeEvaluateArgs();
+  auto results = args.GetPeerMatchCache()->Get(1, 3);
+  int computed[3] = {};
+  auto compute = [&computed](size_t index, bool result) {
+    return [&computed, index, result]() {
+      ++computed[index];
+      return result;
+    };
+  };
+  EXPECT_TRUE(results->Get(1, compute(1, true)));
+  // Only the result asked for was computed.
+  EXPECT_EQ(computed[0], 0);
+  EXPECT_EQ(computed[1], 1);
+  EXPECT_EQ(computed[2], 0);
+  EXPECT_FALSE(results->Get(0, compute(0, false)));
+  EXPECT_TRUE(results->Get(1, compute(1, false)));
+  EXPECT_FALSE(results->Get(0, compute(0, true)));
+  EXPECT_EQ(computed[0], 1);
+  EXPECT_EQ(computed[1], 1);
+  EXPECT_EQ(computed[2], 0);
+}
+
+TEST_F(EvaluateArgsTest, PeerMatchCacheConcurrentGetsAgree) {
+  EvaluateArgs args = util_.MakeEvaluateArgs();
+  auto* cache = args.GetPeerMatchCache();
+  constexpr int kThreads = 4;
+  EvaluateArgs::PerChannelArgs::PeerMatchCache::Results* seen[kThreads][2];
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([cache, &seen, i]() {
+      seen[i][0] = cache->Get(1, 1).get();
+      seen[i][1] = cache->Get(2, 1).get();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int i = 0; i < kThreads; ++i) {
+    EXPECT_EQ(seen[i][0], cache->Get(1, 1).get());
+    EXPECT_EQ(seen[i][1], cache->Get(2, 1).get());
+  }
+  EXPECT_NE(cache->Get(1, 1), cache->Get(2, 1));
+}
+
+TEST_F(EvaluateArgsTest, PeerMatchCacheFullEvictsOldestKeys) {
+  EvaluateArgs args = util_.MakeEvaluateArgs();
+  auto* cache = args.GetPeerMatchCache();
+  std::vector<
+      RefCountedPtr<EvaluateArgs::PerChannelArgs::PeerMatchCache::Results>>
+      results;
+  for (uint64_t key = 10; key < 110; ++key) {
+    results.push_back(cache->Get(key, 1));
+    ASSERT_NE(results.back(), nullptr);
+    results.back()->Get(0, [] { return true; });
+  }
+  // Only the newest keys are still cached. Older keys are not cached again.
+  size_t cached = 0;
+  while (cached < results.size() &&
+         cache->Get(109 - cached, 1) == results[results.size() - 1 - cached]) {
+    ++cached;
+  }
+  EXPECT_GT(cached, 1);
+  EXPECT_LT(cached, results.size());
+  EXPECT_EQ(cache->Get(0, 1), nullptr);
+  // Evicted results stay valid for the calls that still hold them.
+  EXPECT_TRUE(results[0]->Get(0, [] { return false; }));
+}
+
+TEST_F(EvaluateArgsTest, PeerMatchCacheNullWithoutChannelArgs) {
+  EvaluateArgs args(nullptr, nullptr);
+  EXPECT_EQ(args.GetPeerMatchCache(), nullptr);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
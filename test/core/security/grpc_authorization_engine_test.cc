@@ -19,6 +19,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <grpc/grpc.h>
+
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
@@ -103,9 +107,116 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+Rbac::Permission PathPermission(StringMatcher::Type type,
+                                absl::string_view path) {
+  return Rbac::Permission::MakePathPermission(
+      StringMatcher::Create(type, path).value());
+}
+
+TEST(GrpcAuthorizationEngineTest, PathIndexMatchesExactAndPrefixPolicies) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      PathPermission(StringMatcher::Type::kExact, "/pkg.Service/Method"),
+      Rbac::Principal::MakeAnyPrincipal());
+  policies["policy2"] =
+      Rbac::Policy(PathPermission(StringMatcher::Type::kPrefix, "/pkg."),
+                   Rbac::Principal::MakeAnyPrincipal());
+  std::vector<std::unique_ptr<Rbac::Permission>> any_of;
+  any_of.push_back(std::make_unique<Rbac::Permission>(
+      PathPermission(StringMatcher::Type::kExact, "/other.Service/Method")));
+  any_of.push_back(std::make_unique<Rbac::Permission>(
+      PathPermission(StringMatcher::Type::kPrefix, "/third.")));
+  policies["policy3"] =
+      Rbac::Policy(Rbac::Permission::MakeOrPermission(std::move(any_of)),
+                   Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  struct {
+    const char* path;
+    const char* matching_policy_name;
+  } cases[] = {
+      {"/pkg.Service/Method", "policy1"},
+      {"/pkg.Service/Other", "policy2"},
+      {"/pkg.", "policy2"},
+      {"/other.Service/Method", "policy3"},
+      {"/third.Service/Method", "policy3"},
+      {"/pkg", nullptr},
+      {"/other.Service/Other", nullptr},
+  };
+  for (const auto& c : cases) {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", c.path);
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    if (c.matching_policy_name == nullptr) {
+      EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny)
+          << c.path;
+      EXPECT_TRUE(decision.matching_policy_name.empty()) << c.path;
+    } else {
+      EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow)
+          << c.path;
+      EXPECT_EQ(decision.matching_policy_name, c.matching_policy_name)
+          << c.path;
+    }
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, UnindexedPolicyKeepsPolicyOrder) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission::MakeNotPermission(
+          PathPermission(StringMatcher::Type::kExact, "/pkg.Service/Other")),
+      Rbac::Principal::MakeAnyPrincipal());
+  policies["policy2"] = Rbac::Policy(
+      PathPermission(StringMatcher::Type::kExact, "/pkg.Service/Method"),
+      Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata(":path", "/pkg.Service/Method");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(decision.matching_policy_name, "policy1");
+}
+
+TEST(GrpcAuthorizationEngineTest, PeerPrincipalsEvaluatedPerEngine) {
+  std::map<std::string, Rbac::Policy> allow_policies;
+  allow_policies["policy1"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeDirectRemoteIpPrincipal(
+          Rbac::CidrRange("127.0.0.0", 8)));
+  GrpcAuthorizationEngine allow_engine(
+      Rbac(Rbac::Action::kAllow, std::move(allow_policies)));
+  std::map<std::string, Rbac::Policy> deny_policies;
+  deny_policies["policy2"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeDirectRemoteIpPrincipal(
+          Rbac::CidrRange("10.0.0.0", 8)));
+  GrpcAuthorizationEngine deny_engine(
+      Rbac(Rbac::Action::kDeny, std::move(deny_policies)));
+  EvaluateArgsTestUtil util;
+  util.SetPeerEndpoint("ipv4:127.0.0.1:443");
+  util.AddPairToMetadata(":path", "/pkg.Service/Method");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  // Evaluate repeatedly so that later calls use the per-connection results
+  // cached by the first ones.
+  for (int i = 0; i < 3; ++i) {
+    AuthorizationEngine::Decision decision = allow_engine.Evaluate(args);
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy1");
+    decision = deny_engine.Evaluate(args);
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_TRUE(decision.matching_policy_name.empty());
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
 }
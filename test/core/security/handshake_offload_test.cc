@@ -0,0 +1,210 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/security/transport/handshake_offload.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using Priority = HandshakeOffloadPool::Priority;
+
+TEST(HandshakeOffloadPoolTest, RunsStepOffThread) {
+  HandshakeOffloadPool pool(2);
+  EXPECT_EQ(pool.max_concurrent(), 2);
+  Notification done;
+  std::thread::id ran_on;
+  absl::Status ran_with = absl::UnknownError("not run");
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), [&](absl::Status status) {
+    EXPECT_NE(ExecCtx::Get(), nullptr);
+    ran_on = std::this_thread::get_id();
+    ran_with = std::move(status);
+    done.Notify();
+  });
+  done.WaitForNotification();
+  EXPECT_NE(ran_on, std::this_thread::get_id());
+  EXPECT_TRUE(ran_with.ok()) << ran_with;
+}
+
+TEST(HandshakeOffloadPoolTest, InProgressRunsBeforeNew) {
+  HandshakeOffloadPool pool(1);
+  Notification blocker_started;
+  Notification unblock;
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), [&](absl::Status) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+  });
+  blocker_started.WaitForNotification();
+  Mutex mu;
+  std::string order;
+  Notification done;
+  auto append = [&](char c) {
+    return [&, c](absl::Status status) {
+      EXPECT_TRUE(status.ok()) << status;
+      MutexLock lock(&mu);
+      order.push_back(c);
+      if (order.size() == 4) done.Notify();
+    };
+  };
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), append('a'));
+  pool.Run(Priority::kInProgress, Timestamp::InfFuture(), append('B'));
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), append('c'));
+  pool.Run(Priority::kInProgress, Timestamp::InfFuture(), append('D'));
+  EXPECT_EQ(pool.queued(), 4);
+  unblock.Notify();
+  done.WaitForNotification();
+  EXPECT_EQ(order, "BDac");
+}
+
+TEST(HandshakeOffloadPoolTest, ExpiredStepIsRejected) {
+  HandshakeOffloadPool pool(1);
+  Notification blocker_started;
+  Notification unblock;
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), [&](absl::Status) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+  });
+  blocker_started.WaitForNotification();
+  Notification done;
+  absl::Status ran_with;
+  pool.Run(Priority::kNew, Timestamp::InfPast(), [&](absl::Status status) {
+    ran_with = std::move(status);
+    done.Notify();
+  });
+  unblock.Notify();
+  done.WaitForNotification();
+  EXPECT_EQ(ran_with.code(), absl::StatusCode::kResourceExhausted) << ran_with;
+  EXPECT_EQ(pool.rejected(), 1);
+}
+
+TEST(HandshakeOffloadPoolTest, ExpiredStepIsRejectedWithoutAPoolThread) {
+  HandshakeOffloadPool pool(1);
+  Notification blocker_started;
+  Notification unblock;
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), [&](absl::Status) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+  });
+  blocker_started.WaitForNotification();
+  // The only pool thread is busy, yet both the step that expired in the queue
+  // and the one that was already expired are rejected.
+  Notification expired_in_queue;
+  pool.Run(Priority::kInProgress, Timestamp::Now() + Duration::Milliseconds(1),
+           [&](absl::Status status) {
+             EXPECT_EQ(status.code(), absl::StatusCode::kResourceExhausted)
+                 << status;
+             expired_in_queue.Notify();
+           });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  Notification expired_on_arrival;
+  pool.Run(Priority::kNew, Timestamp::InfPast(), [&](absl::Status status) {
+    EXPECT_EQ(status.code(), absl::StatusCode::kResourceExhausted) << status;
+    expired_on_arrival.Notify();
+  });
+  expired_in_queue.WaitForNotification();
+  expired_on_arrival.WaitForNotification();
+  EXPECT_EQ(pool.queued(), 0);
+  EXPECT_EQ(pool.rejected(), 2);
+  unblock.Notify();
+}
+
+TEST(HandshakeOffloadPoolTest, ThreadsRestartAfterFork) {
+  HandshakeOffloadPool pool(2);
+  pool.PrepareFork();
+  EXPECT_EQ(pool.max_concurrent(), 2);
+  Notification done;
+  pool.Run(Priority::kNew, Timestamp::InfFuture(), [&](absl::Status status) {
+    EXPECT_TRUE(status.ok()) << status;
+    done.Notify();
+  });
+  // No thread runs the step until the pool is restarted.
+  EXPECT_FALSE(done.WaitForNotificationWithTimeout(absl::Milliseconds(100)));
+  EXPECT_EQ(pool.queued(), 1);
+  pool.PostforkChild();
+  done.WaitForNotification();
+  EXPECT_EQ(pool.queued(), 0);
+}
+
+TEST(HandshakeOffloadPoolTest, ConcurrencyIsBounded) {
+  constexpr int kSteps = 64;
+  HandshakeOffloadPool pool(3);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::atomic<int> finished{0};
+  Notification done;
+  for (int i = 0; i < kSteps; ++i) {
+    pool.Run(i % 2 == 0 ? Priority::kNew : Priority::kInProgress,
+             Timestamp::InfFuture(), [&](absl::Status status) {
+               EXPECT_TRUE(status.ok()) << status;
+               int now = running.fetch_add(1) + 1;
+               int prev = max_running.load();
+               while (now > prev &&
+                      !max_running.compare_exchange_weak(prev, now)) {
+               }
+               std::this_thread::sleep_for(std::chrono::microseconds(100));
+               running.fetch_sub(1);
+               if (finished.fetch_add(1) + 1 == kSteps) done.Notify();
+             });
+  }
+  done.WaitForNotification();
+  EXPECT_LE(max_running.load(), 3);
+  EXPECT_EQ(pool.rejected(), 0);
+}
+
+TEST(HandshakeOffloadPoolTest, GetReturnsOneProcessWidePool) {
+  const size_t cores = gpr_cpu_num_cores();
+  HandshakeOffloadPool* pool = HandshakeOffloadPool::Get(1);
+  EXPECT_EQ(pool->max_concurrent(), 1);
+  // Asking for more threads grows the shared pool, up to one per core...
+  EXPECT_EQ(pool, HandshakeOffloadPool::Get(2));
+  EXPECT_EQ(pool->max_concurrent(), std::min<size_t>(2, cores));
+  EXPECT_EQ(pool, HandshakeOffloadPool::Get(cores + 10));
+  EXPECT_EQ(pool->max_concurrent(), cores);
+  // ... and asking for fewer does not shrink it.
+  EXPECT_EQ(pool, HandshakeOffloadPool::Get(1));
+  EXPECT_EQ(pool->max_concurrent(), cores);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int retval = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return retval;
+}
@@ -0,0 +1,90 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/slice/slice_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(SlicePoolTest, BlockSize) {
+  EXPECT_EQ(SlicePool::BlockSize(1), 256 + SlicePool::kHeaderSlop);
+  EXPECT_EQ(SlicePool::BlockSize(256 + SlicePool::kHeaderSlop),
+            256 + SlicePool::kHeaderSlop);
+  EXPECT_EQ(SlicePool::BlockSize(256 + SlicePool::kHeaderSlop + 1),
+            512 + SlicePool::kHeaderSlop);
+  EXPECT_EQ(SlicePool::BlockSize(8192), 8192 + SlicePool::kHeaderSlop);
+  EXPECT_EQ(SlicePool::BlockSize(65536 + SlicePool::kHeaderSlop),
+            65536 + SlicePool::kHeaderSlop);
+  // Too large to be pooled.
+  EXPECT_EQ(SlicePool::BlockSize(65536 + SlicePool::kHeaderSlop + 1),
+            65536 + SlicePool::kHeaderSlop + 1);
+}
+
+TEST(SlicePoolTest, RecyclesBlocks) {
+  ExecCtx exec_ctx;
+  SlicePool::TestOnlyReset();
+  void* block = SlicePool::Alloc(1000);
+  memset(block, 0, SlicePool::BlockSize(1000));
+  SlicePool::Free(block, 1000);
+  // Same size class, same CPU: the same block comes back.
+  void* block2 = SlicePool::Alloc(800);
+  EXPECT_EQ(block, block2);
+  SlicePool::Free(block2, 800);
+  // Too large to be pooled: still usable.
+  void* large = SlicePool::Alloc(1024 * 1024);
+  memset(large, 0, 1024 * 1024);
+  SlicePool::Free(large, 1024 * 1024);
+  SlicePool::TestOnlyReset();
+}
+
+TEST(SlicePoolTest, CachesBoundedBytes) {
+  ExecCtx exec_ctx;
+  SlicePool::TestOnlyReset();
+  constexpr size_t kBlocks = 32;
+  const size_t size = SlicePool::kMaxPayloadSize;
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kBlocks; i++) blocks.push_back(SlicePool::Alloc(size));
+  for (void* block : blocks) SlicePool::Free(block, size);
+  blocks.clear();
+  // Only kMaxCachedBytesPerClass worth of blocks were kept: the rest must
+  // come from the system allocator again.
+  const size_t cached = SlicePool::kMaxCachedBytesPerClass / size;
+  const uint64_t mallocs_before = global_stats().Collect()->slice_pool_mallocs;
+  for (size_t i = 0; i < kBlocks; i++) blocks.push_back(SlicePool::Alloc(size));
+  EXPECT_EQ(global_stats().Collect()->slice_pool_mallocs - mallocs_before,
+            kBlocks - cached);
+  for (void* block : blocks) SlicePool::Free(block, size);
+  SlicePool::TestOnlyReset();
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,10 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "gtest/gtest.h"
 
@@ -295,6 +299,144 @@ static void test_threading(size_t producers, size_t consumers) {
   gpr_free(options);
 }
 
+#define SHARDED_TEST_SHARDS 4
+#define SHARDED_TEST_PRODUCERS 8
+#define SHARDED_TEST_EVENTS_PER_PRODUCER 1000
+
+typedef struct sharded_producer_options {
+  grpc_completion_queue* cc;
+  intptr_t first_tag;
+} sharded_producer_options;
+
+/* Completes SHARDED_TEST_EVENTS_PER_PRODUCER distinct tags, starting at
+   opt->first_tag. Each producer thread maps to its own event queue shard. */
+static void sharded_producer_thread(void* arg) {
+  sharded_producer_options* opt = static_cast<sharded_producer_options*>(arg);
+  for (intptr_t i = 0; i < SHARDED_TEST_EVENTS_PER_PRODUCER; i++) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_cq_end_op(opt->cc, reinterpret_cast<void*>(opt->first_tag + i),
+                   absl::OkStatus(), free_completion, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
+}
+
+/* Begins one operation per tag, then completes them all from
+   SHARDED_TEST_PRODUCERS threads. Tags are 1..num_tags. */
+static void produce_on_all_shards(grpc_completion_queue* cc,
+                                  size_t* num_tags) {
+  *num_tags = SHARDED_TEST_PRODUCERS * SHARDED_TEST_EVENTS_PER_PRODUCER;
+  for (size_t tag = 1; tag <= *num_tags; tag++) {
+    ASSERT_TRUE(grpc_cq_begin_op(cc, reinterpret_cast<void*>(tag)));
+  }
+  sharded_producer_options options[SHARDED_TEST_PRODUCERS];
+  grpc_core::Thread threads[SHARDED_TEST_PRODUCERS];
+  for (int i = 0; i < SHARDED_TEST_PRODUCERS; i++) {
+    options[i].cc = cc;
+    options[i].first_tag = 1 + i * SHARDED_TEST_EVENTS_PER_PRODUCER;
+    threads[i] = grpc_core::Thread("grpc_sharded_producer",
+                                   sharded_producer_thread, &options[i]);
+    threads[i].Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+}
+
+typedef struct sharded_consumer_options {
+  grpc_completion_queue* cc;
+  std::atomic<int>* deliveries;
+  size_t num_tags;
+} sharded_consumer_options;
+
+static void sharded_consumer_thread(void* arg) {
+  sharded_consumer_options* opt = static_cast<sharded_consumer_options*>(arg);
+  for (;;) {
+    grpc_event ev = grpc_completion_queue_next(
+        opt->cc, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+    if (ev.type == GRPC_QUEUE_SHUTDOWN) return;
+    ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+    ASSERT_TRUE(ev.success);
+    size_t tag = reinterpret_cast<size_t>(ev.tag);
+    ASSERT_GE(tag, 1u);
+    ASSERT_LE(tag, opt->num_tags);
+    opt->deliveries[tag - 1].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/* Events are completed from threads on every shard while several threads
+   poll the queue: each one must be delivered exactly once. */
+static void test_sharded_queue_delivers_each_tag_once(size_t consumers) {
+  gpr_log(GPR_INFO,
+          "test_sharded_queue_delivers_each_tag_once: %" PRIuPTR " consumers",
+          consumers);
+  grpc_cq_set_event_queue_shards_for_testing(SHARDED_TEST_SHARDS);
+  grpc_completion_queue* cc = grpc_completion_queue_create_for_next(nullptr);
+  const size_t num_tags =
+      SHARDED_TEST_PRODUCERS * SHARDED_TEST_EVENTS_PER_PRODUCER;
+  std::unique_ptr<std::atomic<int>[]> deliveries(
+      new std::atomic<int>[num_tags]);
+  for (size_t i = 0; i < num_tags; i++) deliveries[i].store(0);
+  std::vector<sharded_consumer_options> options(
+      consumers, sharded_consumer_options{cc, deliveries.get(), num_tags});
+  std::vector<grpc_core::Thread> threads(consumers);
+  for (size_t i = 0; i < consumers; i++) {
+    threads[i] = grpc_core::Thread("grpc_sharded_consumer",
+                                   sharded_consumer_thread, &options[i]);
+    threads[i].Start();
+  }
+  size_t produced;
+  produce_on_all_shards(cc, &produced);
+  ASSERT_EQ(produced, num_tags);
+  grpc_completion_queue_shutdown(cc);
+  for (auto& th : threads) {
+    th.Join();
+  }
+  for (size_t i = 0; i < num_tags; i++) {
+    ASSERT_EQ(deliveries[i].load(), 1) << "tag " << i + 1;
+  }
+  grpc_completion_queue_destroy(cc);
+  grpc_cq_set_event_queue_shards_for_testing(0);
+}
+
+/* Events are left on every shard when the queue is shut down: a single
+   thread, which maps to just one of the shards, must still drain all of them
+   before it sees GRPC_QUEUE_SHUTDOWN. */
+static void test_sharded_queue_drains_all_shards_on_shutdown(void) {
+  LOG_TEST("test_sharded_queue_drains_all_shards_on_shutdown");
+  grpc_cq_set_event_queue_shards_for_testing(SHARDED_TEST_SHARDS);
+  grpc_completion_queue* cc = grpc_completion_queue_create_for_next(nullptr);
+  size_t num_tags;
+  produce_on_all_shards(cc, &num_tags);
+  grpc_completion_queue_shutdown(cc);
+  std::vector<int> deliveries(num_tags, 0);
+  for (size_t i = 0; i < num_tags; i++) {
+    grpc_event ev = grpc_completion_queue_next(
+        cc, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+    ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+    size_t tag = reinterpret_cast<size_t>(ev.tag);
+    ASSERT_GE(tag, 1u);
+    ASSERT_LE(tag, num_tags);
+    deliveries[tag - 1]++;
+  }
+  for (size_t i = 0; i < num_tags; i++) {
+    ASSERT_EQ(deliveries[i], 1) << "tag " << i + 1;
+  }
+  grpc_event ev = grpc_completion_queue_next(
+      cc, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+  ASSERT_EQ(ev.type, GRPC_QUEUE_SHUTDOWN);
+  grpc_completion_queue_destroy(cc);
+  grpc_cq_set_event_queue_shards_for_testing(0);
+}
+
+TEST(CompletionQueueThreadingTest, ShardedQueue) {
+  grpc_init();
+  test_sharded_queue_delivers_each_tag_once(1);
+  test_sharded_queue_delivers_each_tag_once(6);
+  test_sharded_queue_drains_all_shards_on_shutdown();
+  grpc_shutdown();
+}
+
 TEST(CompletionQueueThreadingTest, MainTest) {
   grpc_init();
   test_too_many_plucks();
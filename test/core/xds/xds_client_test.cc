@@ -23,7 +23,9 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
@@ -62,6 +64,8 @@
 // IWYU pragma: no_include <google/protobuf/unknown_field_set.h>
 // IWYU pragma: no_include <google/protobuf/util/json_util.h>
 
+using envoy::service::discovery::v3::DeltaDiscoveryRequest;
+using envoy::service::discovery::v3::DeltaDiscoveryResponse;
 using envoy::service::discovery::v3::DiscoveryRequest;
 using envoy::service::discovery::v3::DiscoveryResponse;
 
@@ -120,10 +124,12 @@ class XdsClientTest : public ::testing::Test {
       bool IgnoreResourceDeletion() const override {
         return ignore_resource_deletion_;
       }
+      bool UseDeltaProtocol() const override { return use_delta_protocol_; }
       bool Equals(const XdsServer& other) const override {
         const auto& o = static_cast<const FakeXdsServer&>(other);
         return server_uri_ == o.server_uri_ &&
-               ignore_resource_deletion_ == o.ignore_resource_deletion_;
+               ignore_resource_deletion_ == o.ignore_resource_deletion_ &&
+               use_delta_protocol_ == o.use_delta_protocol_;
       }
 
       void set_server_uri(std::string server_uri) {
@@ -132,10 +138,14 @@ class XdsClientTest : public ::testing::Test {
       void set_ignore_resource_deletion(bool ignore_resource_deletion) {
         ignore_resource_deletion_ = ignore_resource_deletion;
       }
+      void set_use_delta_protocol(bool use_delta_protocol) {
+        use_delta_protocol_ = use_delta_protocol;
+      }
 
      private:
       std::string server_uri_ = "default_xds_server";
       bool ignore_resource_deletion_ = false;
+      bool use_delta_protocol_ = false;
     };
 
     class FakeAuthority : public Authority {
@@ -169,6 +179,10 @@ class XdsClientTest : public ::testing::Test {
         server_.set_ignore_resource_deletion(ignore_resource_deletion);
         return *this;
       }
+      Builder& set_use_delta_protocol(bool use_delta_protocol) {
+        server_.set_use_delta_protocol(use_delta_protocol);
+        return *this;
+      }
       std::unique_ptr<XdsBootstrap> Build() {
         auto bootstrap = std::make_unique<FakeXdsBootstrap>();
         bootstrap->server_ = std::move(server_);
@@ -347,6 +361,7 @@ class XdsClientTest : public ::testing::Test {
     XdsResourceType::DecodeResult Decode(
         const XdsResourceType::DecodeContext& /*context*/,
         absl::string_view serialized_resource) const override {
+      num_decodes_.fetch_add(1, std::memory_order_relaxed);
       auto json = Json::Parse(serialized_resource);
       XdsResourceType::DecodeResult result;
       if (!json.ok()) {
@@ -379,6 +394,14 @@ class XdsClientTest : public ::testing::Test {
       any.set_value(resource.AsJsonString());
       return any;
     }
+
+    // Number of resources decoded so far.
+    size_t num_decodes() const {
+      return num_decodes_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    mutable std::atomic<size_t> num_decodes_{0};
   };
 
   // A fake "Foo" xDS resource type.
@@ -548,6 +571,60 @@ class XdsClientTest : public ::testing::Test {
     DiscoveryResponse response_;
   };
 
+  // A helper class to build and serialize a DeltaDiscoveryResponse.
+  class DeltaResponseBuilder {
+   public:
+    explicit DeltaResponseBuilder(absl::string_view type_url) {
+      response_.set_type_url(absl::StrCat("type.googleapis.com/", type_url));
+    }
+
+    DeltaResponseBuilder& set_system_version_info(
+        absl::string_view system_version_info) {
+      response_.set_system_version_info(std::string(system_version_info));
+      return *this;
+    }
+    DeltaResponseBuilder& set_nonce(absl::string_view nonce) {
+      response_.set_nonce(std::string(nonce));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddFooResource(const XdsFooResource& resource,
+                                         absl::string_view version) {
+      auto* res = response_.add_resources();
+      res->set_name(resource.name);
+      res->set_version(std::string(version));
+      *res->mutable_resource() = XdsFooResourceType::EncodeAsAny(resource);
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddInvalidResource(absl::string_view type_url,
+                                             absl::string_view name,
+                                             absl::string_view version,
+                                             absl::string_view value) {
+      auto* res = response_.add_resources();
+      res->set_name(std::string(name));
+      res->set_version(std::string(version));
+      res->mutable_resource()->set_type_url(
+          absl::StrCat("type.googleapis.com/", type_url));
+      res->mutable_resource()->set_value(std::string(value));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddRemovedResource(absl::string_view name) {
+      response_.add_removed_resources(std::string(name));
+      return *this;
+    }
+
+    std::string Serialize() {
+      std::string serialized_response;
+      EXPECT_TRUE(response_.SerializeToString(&serialized_response));
+      return serialized_response;
+    }
+
+   private:
+    DeltaDiscoveryResponse response_;
+  };
+
   class ScopedExperimentalEnvVar {
    public:
     explicit ScopedExperimentalEnvVar(const char* env_var) : env_var_(env_var) {
@@ -622,7 +699,9 @@ class XdsClientTest : public ::testing::Test {
     const auto* xds_server = xds_client_->bootstrap().FindXdsServer(server);
     GPR_ASSERT(xds_server != nullptr);
     return transport_factory_->WaitForStream(
-        *xds_server, FakeXdsTransportFactory::kAdsMethod,
+        *xds_server,
+        xds_server->UseDeltaProtocol() ? FakeXdsTransportFactory::kDeltaAdsMethod
+                                       : FakeXdsTransportFactory::kAdsMethod,
         timeout * grpc_test_slowdown_factor());
   }
 
@@ -683,6 +762,59 @@ class XdsClientTest : public ::testing::Test {
         << location.file() << ":" << location.line();
   }
 
+  // Gets the latest delta request sent to the fake xDS server.
+  absl::optional<DeltaDiscoveryRequest> WaitForDeltaRequest(
+      FakeXdsTransportFactory::FakeStreamingCall* stream,
+      absl::Duration timeout = absl::Seconds(3),
+      SourceLocation location = SourceLocation()) {
+    auto message =
+        stream->WaitForMessageFromClient(timeout * grpc_test_slowdown_factor());
+    if (!message.has_value()) return absl::nullopt;
+    DeltaDiscoveryRequest request;
+    bool success = request.ParseFromString(*message);
+    EXPECT_TRUE(success) << "Failed to deserialize DeltaDiscoveryRequest at "
+                         << location.file() << ":" << location.line();
+    if (!success) return absl::nullopt;
+    return std::move(request);
+  }
+
+  // Helper function to check the fields of a DeltaDiscoveryRequest.
+  void CheckDeltaRequest(
+      const DeltaDiscoveryRequest& request, absl::string_view type_url,
+      absl::string_view response_nonce, absl::Status error_detail,
+      std::set<absl::string_view> resource_names_subscribe,
+      std::set<absl::string_view> resource_names_unsubscribe,
+      std::map<std::string, std::string> initial_resource_versions = {},
+      SourceLocation location = SourceLocation()) {
+    EXPECT_EQ(request.type_url(),
+              absl::StrCat("type.googleapis.com/", type_url))
+        << location.file() << ":" << location.line();
+    EXPECT_EQ(request.response_nonce(), response_nonce)
+        << location.file() << ":" << location.line();
+    if (error_detail.ok()) {
+      EXPECT_FALSE(request.has_error_detail())
+          << location.file() << ":" << location.line();
+    } else {
+      EXPECT_EQ(request.error_detail().code(),
+                static_cast<int>(error_detail.code()))
+          << location.file() << ":" << location.line();
+      EXPECT_EQ(request.error_detail().message(), error_detail.message())
+          << location.file() << ":" << location.line();
+    }
+    EXPECT_THAT(request.resource_names_subscribe(),
+                ::testing::UnorderedElementsAreArray(resource_names_subscribe))
+        << location.file() << ":" << location.line();
+    EXPECT_THAT(
+        request.resource_names_unsubscribe(),
+        ::testing::UnorderedElementsAreArray(resource_names_unsubscribe))
+        << location.file() << ":" << location.line();
+    std::map<std::string, std::string> actual_initial_resource_versions(
+        request.initial_resource_versions().begin(),
+        request.initial_resource_versions().end());
+    EXPECT_EQ(actual_initial_resource_versions, initial_resource_versions)
+        << location.file() << ":" << location.line();
+  }
+
   // Helper function to check the contents of the node message in a
   // request against the client's node info.
   void CheckRequestNode(const DiscoveryRequest& request,
@@ -2805,6 +2937,430 @@ TEST_F(XdsClientTest, FederationChannelFailureReportedToWatchers) {
   }
 }
 
+TEST_F(XdsClientTest, UnchangedResourceDoesNotNotifyWatchers) {
+  InitXdsClient();
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6))
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server sends a new version containing an identical resource.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo1", 6))
+          .Serialize());
+  // XdsClient should ACK the new version without notifying the watcher.
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"2", /*response_nonce=*/"B",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  EXPECT_FALSE(watcher->HasEvent());
+  // Both responses should be reflected in the parse stats.
+  auto stats = xds_client_->GetResourceTypeParseStats();
+  auto it = stats.find(std::string(XdsFooResourceType::Get()->type_url()));
+  ASSERT_NE(it, stats.end());
+  EXPECT_EQ(it->second.responses, 2u);
+  EXPECT_EQ(it->second.resources_decoded, 2u);
+  EXPECT_EQ(it->second.resources_invalid, 0u);
+  EXPECT_EQ(it->second.resources_unchanged, 1u);
+  EXPECT_GE(it->second.decode_time, absl::ZeroDuration());
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, LargeUpdateWithInvalidResources) {
+  // Enough resources for the response to be decoded in parallel.
+  constexpr size_t kNumResources = 200;
+  constexpr size_t kInvalidResources[] = {10, 150};
+  InitXdsClient();
+  std::vector<RefCountedPtr<XdsFooResourceType::Watcher>> watchers;
+  for (size_t i = 0; i < kNumResources; ++i) {
+    watchers.push_back(StartFooWatch(absl::StrCat("foo", i)));
+  }
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // Wait for the subscription request that contains all resources.
+  absl::optional<DiscoveryRequest> request;
+  do {
+    request = WaitForRequest(stream.get());
+    ASSERT_TRUE(request.has_value());
+  } while (static_cast<size_t>(request->resource_names_size()) <
+           kNumResources);
+  ResponseBuilder builder(XdsFooResourceType::Get()->type_url());
+  builder.set_version_info("1").set_nonce("A");
+  for (size_t i = 0; i < kNumResources; ++i) {
+    if (std::find(std::begin(kInvalidResources), std::end(kInvalidResources),
+                  i) != std::end(kInvalidResources)) {
+      builder.AddInvalidResource(
+          XdsFooResourceType::Get()->type_url(),
+          absl::StrCat("{\"name\":\"foo", i, "\",\"value\":[]}"));
+    } else {
+      builder.AddFooResource(XdsFooResource(absl::StrCat("foo", i), i));
+    }
+  }
+  stream->SendMessageToClient(builder.Serialize());
+  // Every watcher should see either its resource or an error.
+  for (size_t i = 0; i < kNumResources; ++i) {
+    if (std::find(std::begin(kInvalidResources), std::end(kInvalidResources),
+                  i) != std::end(kInvalidResources)) {
+      EXPECT_TRUE(watchers[i]->WaitForNextError().has_value()) << i;
+    } else {
+      auto resource = watchers[i]->WaitForNextResource();
+      ASSERT_TRUE(resource.has_value()) << i;
+      EXPECT_EQ(resource->value, i);
+    }
+  }
+  // The NACK should list the errors in the order of the resources in the
+  // response.
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  constexpr char kError[] =
+      "INVALID_ARGUMENT: errors validating JSON: "
+      "[field:value error:is not a number]";
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"1", /*response_nonce=*/"A",
+               /*error_detail=*/
+               absl::InvalidArgumentError(absl::StrCat(
+                   "xDS response validation errors: [resource index 10: "
+                   "foo10: ",
+                   kError, "; resource index 150: foo150: ", kError, "]")),
+               /*resource_names=*/
+               std::set<absl::string_view>(request->resource_names().begin(),
+                                           request->resource_names().end()));
+  auto stats = xds_client_->GetResourceTypeParseStats();
+  auto it = stats.find(std::string(XdsFooResourceType::Get()->type_url()));
+  ASSERT_NE(it, stats.end());
+  EXPECT_EQ(it->second.resources_decoded, kNumResources);
+  EXPECT_EQ(it->second.resources_invalid, 2u);
+  // Cancel watches.
+  for (size_t i = 0; i < kNumResources; ++i) {
+    CancelFooWatch(watchers[i].get(), absl::StrCat("foo", i),
+                   /*delay_unsubscription=*/i + 1 < kNumResources);
+  }
+}
+
+TEST_F(XdsClientTest, DeltaBasicWatch) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  // XdsClient should have created a delta ADS stream.
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // XdsClient should have sent a subscription request on the stream.
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1"},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_EQ(request->node().id(), xds_client_->bootstrap().node()->id());
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  // XdsClient should have delivered the response to the watcher.
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  // XdsClient should have sent an ACK with no subscription changes.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_FALSE(request->has_node());
+  // The server resends the same version of the resource.  XdsClient
+  // does not decode it again, so the watcher sees no update.
+  const size_t num_decodes = XdsFooResourceType::Get()->num_decodes();
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo1", 7), "v1")
+          .Serialize());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_FALSE(watcher->HasEvent());
+  EXPECT_EQ(XdsFooResourceType::Get()->num_decodes(), num_decodes);
+  // The server sends a new version of the resource.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("3")
+          .set_nonce("C")
+          .AddFooResource(XdsFooResource("foo1", 8), "v2")
+          .Serialize());
+  resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 8);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"C", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // The server removes the resource.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("4")
+          .set_nonce("D")
+          .AddRemovedResource("foo1")
+          .Serialize());
+  EXPECT_TRUE(watcher->WaitForDoesNotExist(absl::Seconds(1)));
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"D", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaSubscriptionChangesSentIncrementally) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1"},
+                    /*resource_names_unsubscribe=*/{});
+  // Start a watch for "foo2".  Only the new name is sent.
+  auto watcher2 = StartFooWatch("foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo2"},
+                    /*resource_names_unsubscribe=*/{});
+  // Server sends both resources.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .AddFooResource(XdsFooResource("foo2", 7), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  resource = watcher2->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 7);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Server sends a new version of only foo2.  Only foo2's watcher is
+  // notified.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo2", 8), "v2")
+          .Serialize());
+  resource = watcher2->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 8);
+  EXPECT_FALSE(watcher->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Cancel watch for "foo1".  Only the removed name is sent.
+  CancelFooWatch(watcher.get(), "foo1");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{"foo1"});
+  // Cancel watch for "foo2".
+  CancelFooWatch(watcher2.get(), "foo2");
+}
+
+TEST_F(XdsClientTest, DeltaNack) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server sends an invalid resource.
+  constexpr absl::string_view kErrorMessage =
+      "xDS response validation errors: [resource index 0: foo1: "
+      "INVALID_ARGUMENT: errors validating JSON: [field:value "
+      "error:is not a number]]";
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("2")
+          .set_nonce("B")
+          .AddInvalidResource(XdsFooResourceType::Get()->type_url(), "foo1",
+                              "v2", "{\"name\":\"foo1\",\"value\":[]}")
+          .Serialize());
+  // The watcher gets an error, and XdsClient NACKs the response.
+  auto error = watcher->WaitForNextError();
+  ASSERT_TRUE(error.has_value());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B",
+                    /*error_detail=*/absl::InvalidArgumentError(kErrorMessage),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaStreamRestartSendsInitialResourceVersions) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  auto watcher = StartFooWatch("foo1");
+  auto watcher2 = StartFooWatch("foo2");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // Read the subscription requests for both resources.
+  std::set<std::string> subscribed;
+  while (subscribed.size() < 2) {
+    auto request = WaitForDeltaRequest(stream.get());
+    ASSERT_TRUE(request.has_value());
+    subscribed.insert(request->resource_names_subscribe().begin(),
+                      request->resource_names_subscribe().end());
+  }
+  // Server sends only foo1.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_system_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server closes the stream.
+  stream->MaybeSendStatusToClient(absl::UnavailableError("restart"));
+  // The first request on the new stream subscribes to both resources
+  // and reports the cached version of foo1.
+  stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1", "foo2"},
+                    /*resource_names_unsubscribe=*/{},
+                    /*initial_resource_versions=*/{{"foo1", "v1"}});
+  EXPECT_TRUE(request->has_node());
+  // Cancel watches.
+  CancelFooWatch(watcher.get(), "foo1");
+  CancelFooWatch(watcher2.get(), "foo2");
+}
+
+// Simulates a large EDS-style fanout in which the server resends the
+// whole resource set with only one resource changed.  Only the changed
+// resource is parsed and only its watcher is notified.
+TEST_F(XdsClientTest, DeltaLargeUpdateParsesOnlyChangedResources) {
+  constexpr size_t kNumResources = 1000;
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  std::vector<RefCountedPtr<XdsFooResourceType::Watcher>> watchers;
+  for (size_t i = 0; i < kNumResources; ++i) {
+    watchers.push_back(StartFooWatch(absl::StrCat("foo", i)));
+  }
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // Subscription requests are sent incrementally, so the union of the
+  // subscribed names across all requests must be the full set.
+  std::set<std::string> subscribed;
+  while (subscribed.size() < kNumResources) {
+    auto request = WaitForDeltaRequest(stream.get());
+    ASSERT_TRUE(request.has_value());
+    EXPECT_EQ(request->resource_names_unsubscribe_size(), 0);
+    subscribed.insert(request->resource_names_subscribe().begin(),
+                      request->resource_names_subscribe().end());
+  }
+  auto send_all = [&](absl::string_view nonce, size_t changed_index) {
+    DeltaResponseBuilder builder(XdsFooResourceType::Get()->type_url());
+    builder.set_nonce(nonce);
+    for (size_t i = 0; i < kNumResources; ++i) {
+      const bool changed = i == changed_index;
+      builder.AddFooResource(
+          XdsFooResource(absl::StrCat("foo", i), changed ? 2 : 1),
+          changed ? "v2" : "v1");
+    }
+    stream->SendMessageToClient(builder.Serialize());
+  };
+  send_all("A", kNumResources);
+  for (auto& watcher : watchers) {
+    auto resource = watcher->WaitForNextResource();
+    ASSERT_TRUE(resource.has_value());
+    EXPECT_EQ(resource->value, 1);
+  }
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->response_nonce(), "A");
+  // Resend the whole set with one resource changed.
+  const size_t num_decodes = XdsFooResourceType::Get()->num_decodes();
+  send_all("B", kNumResources / 2);
+  auto resource = watchers[kNumResources / 2]->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 2);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->response_nonce(), "B");
+  EXPECT_EQ(XdsFooResourceType::Get()->num_decodes(), num_decodes + 1);
+  for (auto& watcher : watchers) {
+    EXPECT_FALSE(watcher->HasEvent());
+  }
+  // Cancel watches.
+  for (size_t i = 0; i < kNumResources; ++i) {
+    CancelFooWatch(watchers[i].get(), absl::StrCat("foo", i),
+                   /*delay_unsubscription=*/i + 1 < kNumResources);
+  }
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
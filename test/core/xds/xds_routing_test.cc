@@ -0,0 +1,208 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class VirtualHosts : public XdsRouting::VirtualHostListIterator {
+ public:
+  void Add(std::vector<std::string> domains) {
+    domains_.push_back(std::move(domains));
+  }
+
+  size_t Size() const override { return domains_.size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return domains_[index];
+  }
+
+ private:
+  std::vector<std::vector<std::string>> domains_;
+};
+
+class Routes : public XdsRouting::RouteListIterator {
+ public:
+  Routes& Add(StringMatcher::Type type, absl::string_view path,
+              bool case_sensitive = true) {
+    Matchers matchers;
+    matchers.path_matcher =
+        StringMatcher::Create(type, path, case_sensitive).value();
+    matchers_.push_back(std::move(matchers));
+    return *this;
+  }
+
+  Routes& WithHeader(absl::string_view name, absl::string_view value) {
+    matchers_.back().header_matchers.push_back(
+        HeaderMatcher::Create(name, HeaderMatcher::Type::kExact, value)
+            .value());
+    return *this;
+  }
+
+  size_t Size() const override { return matchers_.size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return matchers_[index];
+  }
+
+ private:
+  std::vector<Matchers> matchers_;
+};
+
+class XdsRoutingTest : public ::testing::Test {
+ protected:
+  // Checks that the index agrees with the linear scan, and returns the
+  // selected route.
+  absl::optional<size_t> GetRoute(const Routes& routes,
+                                  absl::string_view path) {
+    XdsRouting::RouteIndex index(routes);
+    auto expected = XdsRouting::GetRouteForRequest(routes, path, &metadata_);
+    auto actual = index.GetRouteForRequest(routes, path, &metadata_);
+    EXPECT_EQ(actual, expected) << path;
+    return actual;
+  }
+
+  absl::optional<size_t> FindVirtualHost(const VirtualHosts& vhosts,
+                                         absl::string_view domain) {
+    XdsRouting::VirtualHostIndex index(vhosts);
+    auto expected = XdsRouting::FindVirtualHostForDomain(vhosts, domain);
+    auto actual = index.Find(domain);
+    EXPECT_EQ(actual, expected) << domain;
+    return actual;
+  }
+
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test");
+  ScopedArenaPtr arena_ = MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch metadata_{arena_.get()};
+};
+
+TEST_F(XdsRoutingTest, RouteIndexUsesFirstMatchingRoute) {
+  Routes routes;
+  routes.Add(StringMatcher::Type::kPrefix, "/pkg.Service/")
+      .WithHeader("env", "canary")
+      .Add(StringMatcher::Type::kExact, "/pkg.Service/Method")
+      .Add(StringMatcher::Type::kPrefix, "/pkg.")
+      .Add(StringMatcher::Type::kPrefix, "");
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Method"), 1);
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Other"), 2);
+  EXPECT_EQ(GetRoute(routes, "/other.Service/Method"), 3);
+  metadata_.Append("env", Slice::FromStaticString("canary"),
+                   [](absl::string_view, const Slice&) { abort(); });
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Method"), 0);
+}
+
+TEST_F(XdsRoutingTest, RouteIndexCaseInsensitivePaths) {
+  Routes routes;
+  routes.Add(StringMatcher::Type::kExact, "/Pkg.Service/Method", false)
+      .Add(StringMatcher::Type::kPrefix, "/PKG.", false)
+      .Add(StringMatcher::Type::kPrefix, "/pkg.Service/");
+  EXPECT_EQ(GetRoute(routes, "/pkg.service/METHOD"), 0);
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Other"), 1);
+  EXPECT_EQ(GetRoute(routes, "/other"), absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, RouteIndexRegexes) {
+  Routes routes;
+  routes.Add(StringMatcher::Type::kSafeRegex, "/pkg\\.Service[0-9]+/.*")
+      .Add(StringMatcher::Type::kPrefix, "/pkg.Service1/")
+      .Add(StringMatcher::Type::kSafeRegex, ".*/Method")
+      .Add(StringMatcher::Type::kSafeRegex, "/pkg");
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service12/Method"), 0);
+  EXPECT_EQ(GetRoute(routes, "/pkg.ServiceX/Method"), 2);
+  EXPECT_EQ(GetRoute(routes, "/pkg.ServiceX/Other"), absl::nullopt);
+  // Regexes must match the whole path.
+  EXPECT_EQ(GetRoute(routes, "/pkg/Other"), absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, RouteIndexUnindexedMatchers) {
+  Routes routes;
+  routes.Add(StringMatcher::Type::kSuffix, "/Method")
+      .Add(StringMatcher::Type::kExact, "/pkg.Service/Method")
+      .Add(StringMatcher::Type::kContains, "Service");
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Method"), 0);
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Other"), 2);
+  EXPECT_EQ(GetRoute(routes, "/pkg.Other/Other"), absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, EmptyRouteIndex) {
+  Routes routes;
+  EXPECT_EQ(GetRoute(routes, "/pkg.Service/Method"), absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, VirtualHostIndexSearchOrder) {
+  VirtualHosts vhosts;
+  vhosts.Add({"*"});
+  vhosts.Add({"foo.*", "*.example.com"});
+  vhosts.Add({"*.com", "foo.bar.*"});
+  vhosts.Add({"WWW.example.com"});
+  vhosts.Add({"www.example.com", "*.example.com"});
+  EXPECT_EQ(FindVirtualHost(vhosts, "www.EXAMPLE.com"), 3);
+  EXPECT_EQ(FindVirtualHost(vhosts, "api.example.com"), 1);
+  EXPECT_EQ(FindVirtualHost(vhosts, "foo.bar.com"), 2);
+  EXPECT_EQ(FindVirtualHost(vhosts, "foo.bar.net"), 2);
+  EXPECT_EQ(FindVirtualHost(vhosts, "foo.net"), 1);
+  EXPECT_EQ(FindVirtualHost(vhosts, "example.net"), 0);
+  // The asterisk must match at least one char.
+  EXPECT_EQ(FindVirtualHost(vhosts, ".example.com"), 2);
+  EXPECT_EQ(FindVirtualHost(vhosts, "foo."), 0);
+  EXPECT_EQ(FindVirtualHost(vhosts, ""), 0);
+}
+
+TEST_F(XdsRoutingTest, VirtualHostIndexWithoutUniverse) {
+  VirtualHosts vhosts;
+  vhosts.Add({"foo.example.com"});
+  vhosts.Add({"*.example.com"});
+  EXPECT_EQ(FindVirtualHost(vhosts, "foo.example.com"), 0);
+  EXPECT_EQ(FindVirtualHost(vhosts, "bar.example.com"), 1);
+  EXPECT_EQ(FindVirtualHost(vhosts, "example.com"), absl::nullopt);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
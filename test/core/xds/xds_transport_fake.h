@@ -49,6 +49,9 @@ class FakeXdsTransportFactory : public XdsTransportFactory {
   static constexpr char kAdsMethod[] =
       "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
       "StreamAggregatedResources";
+  static constexpr char kDeltaAdsMethod[] =
+      "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+      "DeltaAggregatedResources";
   static constexpr char kLrsMethod[] =
       "/envoy.service.load_stats.v3.LoadReportingService/StreamLoadStats";
 
@@ -16,6 +16,11 @@
  *
  */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
 #include <grpc/byte_buffer.h>
@@ -184,6 +189,83 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+using ::google::protobuf::StringValue;
+
+StringValue MakeMessage(size_t size) {
+  StringValue msg;
+  std::string value(size, '\0');
+  for (size_t i = 0; i < size; ++i) value[i] = static_cast<char>(i % 128);
+  msg.set_value(value);
+  return msg;
+}
+
+// Messages larger than a ProtoBufferWriter block are still serialized into a
+// single slice.
+TEST_F(ProtoUtilsTest, SerializesIntoSingleSlice) {
+  for (size_t size : {size_t(10), size_t(1000),
+                      size_t(kProtoBufferWriterMaxBufferLength) * 3}) {
+    StringValue msg = MakeMessage(size);
+    ByteBuffer bb;
+    bool own_buffer;
+    ASSERT_TRUE(
+        SerializationTraits<StringValue>::Serialize(msg, &bb, &own_buffer)
+            .ok());
+    EXPECT_EQ(bb.Length(), msg.ByteSizeLong());
+    std::vector<Slice> slices;
+    ASSERT_TRUE(bb.Dump(&slices).ok());
+    EXPECT_EQ(slices.size(), 1u);
+  }
+}
+
+TEST_F(ProtoUtilsTest, LargerMessagesAreChunked) {
+  StringValue msg = MakeMessage(kProtoBufferSingleSliceMaxLength);
+  ByteBuffer bb;
+  bool own_buffer;
+  ASSERT_TRUE(
+      SerializationTraits<StringValue>::Serialize(msg, &bb, &own_buffer).ok());
+  EXPECT_EQ(bb.Length(), msg.ByteSizeLong());
+  std::vector<Slice> slices;
+  ASSERT_TRUE(bb.Dump(&slices).ok());
+  EXPECT_GT(slices.size(), 1u);
+}
+
+// Parses the serialized message split into `num_slices` slices.
+void RoundTrip(size_t size, size_t num_slices) {
+  StringValue msg = MakeMessage(size);
+  std::string serialized = msg.SerializeAsString();
+  std::vector<Slice> slices;
+  const size_t slice_size = (serialized.size() + num_slices - 1) / num_slices;
+  for (size_t start = 0; start < serialized.size(); start += slice_size) {
+    slices.emplace_back(serialized.data() + start,
+                        std::min(slice_size, serialized.size() - start));
+  }
+  ByteBuffer bb(slices.data(), slices.size());
+  StringValue parsed;
+  ASSERT_TRUE(SerializationTraits<StringValue>::Deserialize(&bb, &parsed).ok());
+  EXPECT_EQ(parsed.value(), msg.value());
+  EXPECT_FALSE(bb.Valid());
+}
+
+TEST_F(ProtoUtilsTest, DeserializeSingleSlice) {
+  RoundTrip(10, 1);
+  RoundTrip(100000, 1);
+}
+
+TEST_F(ProtoUtilsTest, DeserializeMultipleSlices) {
+  RoundTrip(10, 3);
+  RoundTrip(100000, 7);
+}
+
+TEST_F(ProtoUtilsTest, DeserializeInvalidSingleSlice) {
+  // A length-delimited field whose length runs past the end of the buffer.
+  const char kInvalid[] = {0x0a, 0x7f, 'a'};
+  Slice slice(kInvalid, sizeof(kInvalid));
+  ByteBuffer bb(&slice, 1);
+  StringValue parsed;
+  EXPECT_FALSE(
+      SerializationTraits<StringValue>::Deserialize(&bb, &parsed).ok());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
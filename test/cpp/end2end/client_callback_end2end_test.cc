@@ -1320,6 +1320,71 @@ TEST_P(ClientCallbackEnd2endTest, BidiStreamServerCancelAfter) {
   }
 }
 
+// Client streaming through a write queue small enough that it refuses
+// messages and has to wait for OnWriteQueueLow before queueing more.
+TEST_P(ClientCallbackEnd2endTest, BidiStreamWriteQueue) {
+  ResetStub();
+  class Client : public grpc::ClientBidiReactor<EchoRequest, EchoResponse> {
+   public:
+    explicit Client(grpc::testing::EchoTestService::Stub* stub) {
+      request_.set_message("Hello queued fren ");
+      stub->async()->BidiStream(&context_, this);
+      EnableWriteQueue(/*max_messages=*/2, /*max_bytes=*/1024,
+                       /*low_water_bytes=*/0);
+      MaybeWrite();
+      StartRead(&response_);
+      StartCall();
+    }
+    void OnReadDone(bool ok) override {
+      if (!ok) return;
+      EXPECT_EQ(response_.message(), request_.message());
+      reads_complete_++;
+      StartRead(&response_);
+    }
+    void OnWriteQueueLow(bool ok) override {
+      EXPECT_TRUE(ok);
+      queue_low_++;
+      MaybeWrite();
+    }
+    void OnDone(const Status& s) override {
+      EXPECT_TRUE(s.ok());
+      EXPECT_EQ(writes_queued_, kMsgsToSend);
+      EXPECT_EQ(reads_complete_, kMsgsToSend);
+      EXPECT_GT(queue_low_, 0);
+      std::unique_lock<std::mutex> l(mu_);
+      done_ = true;
+      cv_.notify_one();
+    }
+    void Await() {
+      std::unique_lock<std::mutex> l(mu_);
+      while (!done_) {
+        cv_.wait(l);
+      }
+    }
+
+   private:
+    static constexpr int kMsgsToSend = 20;
+    void MaybeWrite() {
+      while (writes_queued_ < kMsgsToSend) {
+        if (!StartQueuedWrite(&request_)) return;
+        writes_queued_++;
+      }
+      StartWritesDone();
+    }
+    EchoRequest request_;
+    EchoResponse response_;
+    ClientContext context_;
+    int writes_queued_{0};
+    int reads_complete_{0};
+    int queue_low_{0};
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool done_ = false;
+  } test{stub_.get()};
+
+  test.Await();
+}
+
 TEST_P(ClientCallbackEnd2endTest, SimultaneousReadAndWritesDone) {
   ResetStub();
   class Client : public grpc::ClientBidiReactor<EchoRequest, EchoResponse> {
@@ -710,6 +710,40 @@ class LoggingInterceptorFactory
   }
 };
 
+// Declares that it only acts on PRE_SEND_INITIAL_METADATA, and checks that it
+// is never handed a batch without it.
+class InitialMetadataOnlyInterceptor : public experimental::Interceptor {
+ public:
+  void Intercept(experimental::InterceptorBatchMethods* methods) override {
+    EXPECT_TRUE(methods->QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA));
+    num_times_run_++;
+    methods->Proceed();
+  }
+
+  uint32_t InterceptionHookPointsMask() const override {
+    return experimental::InterceptionHookPointBit(
+        experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA);
+  }
+
+  static void Reset() { num_times_run_.store(0); }
+  static int GetNumTimesRun() { return num_times_run_.load(); }
+
+ private:
+  static std::atomic<int> num_times_run_;
+};
+
+std::atomic<int> InitialMetadataOnlyInterceptor::num_times_run_;
+
+class InitialMetadataOnlyInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* /*info*/) override {
+    return new InitialMetadataOnlyInterceptor();
+  }
+};
+
 class TestScenario {
  public:
   explicit TestScenario(const ChannelType& channel_type,
@@ -1164,6 +1198,47 @@ TEST_F(ClientInterceptorsStreamingEnd2endTest, BidiStreamingTest) {
   EXPECT_EQ(PhonyInterceptor::GetNumTimesRun(), 20);
 }
 
+TEST_F(ClientInterceptorsStreamingEnd2endTest,
+       BidiStreamingHookPointsMaskTest) {
+  ChannelArguments args;
+  PhonyInterceptor::Reset();
+  InitialMetadataOnlyInterceptor::Reset();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  creators.push_back(std::make_unique<LoggingInterceptorFactory>());
+  // Interleave interceptors that only act on initial metadata with ones that
+  // act on every hook point
+  for (auto i = 0; i < 5; i++) {
+    creators.push_back(
+        std::make_unique<InitialMetadataOnlyInterceptorFactory>());
+    creators.push_back(std::make_unique<PhonyInterceptorFactory>());
+  }
+  auto channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeBidiStreamingCall(channel);
+  LoggingInterceptor::VerifyBidiStreamingCall();
+  EXPECT_EQ(PhonyInterceptor::GetNumTimesRun(), 5);
+  EXPECT_EQ(InitialMetadataOnlyInterceptor::GetNumTimesRun(), 5);
+}
+
+TEST_F(ClientInterceptorsStreamingEnd2endTest,
+       BidiStreamingOnlyHookPointsMaskTest) {
+  ChannelArguments args;
+  InitialMetadataOnlyInterceptor::Reset();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  // Every other batch bypasses the interceptors entirely
+  for (auto i = 0; i < 5; i++) {
+    creators.push_back(
+        std::make_unique<InitialMetadataOnlyInterceptorFactory>());
+  }
+  auto channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeBidiStreamingCall(channel);
+  MakeCall(channel);
+  EXPECT_EQ(InitialMetadataOnlyInterceptor::GetNumTimesRun(), 10);
+}
+
 class ClientGlobalInterceptorEnd2endTest : public ::testing::Test {
  protected:
   ClientGlobalInterceptorEnd2endTest() {
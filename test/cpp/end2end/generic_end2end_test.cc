@@ -16,8 +16,12 @@
  *
  */
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -417,6 +421,232 @@ TEST_F(GenericEnd2endTest, ShortDeadline) {
   driver.join();
 }
 
+std::string ToString(grpc::string_ref s) {
+  return std::string(s.data(), s.size());
+}
+
+// The backend behind the proxy. Echoes every request and returns the "x-"
+// client metadata as both initial and trailing metadata.
+class ProxyBackendService : public CallbackGenericService {
+ public:
+  static constexpr char kEchoMethod[] = "/grpc.testing.Backend/Echo";
+  static constexpr char kFailMethod[] = "/grpc.testing.Backend/Fail";
+  // Finishes after echoing one request, without waiting for the client to
+  // half-close.
+  static constexpr char kEchoOnceMethod[] = "/grpc.testing.Backend/EchoOnce";
+
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* ctx) override {
+    class Reactor : public ServerGenericBidiReactor {
+     public:
+      explicit Reactor(GenericCallbackServerContext* ctx)
+          : echo_once_(ctx->method() == kEchoOnceMethod) {
+        if (ctx->method() == kFailMethod) {
+          Finish(Status(StatusCode::PERMISSION_DENIED, "denied"));
+          return;
+        }
+        for (const auto& entry : ctx->client_metadata()) {
+          if (ToString(entry.first).rfind("x-", 0) != 0) continue;
+          ctx->AddInitialMetadata(ToString(entry.first),
+                                  ToString(entry.second));
+          ctx->AddTrailingMetadata(ToString(entry.first),
+                                   ToString(entry.second));
+        }
+        StartRead(&message_);
+      }
+      void OnReadDone(bool ok) override {
+        if (!ok) {
+          Finish(Status::OK);
+        } else if (echo_once_) {
+          StartWriteAndFinish(&message_, WriteOptions(), Status::OK);
+        } else {
+          StartWrite(&message_);
+        }
+      }
+      void OnWriteDone(bool ok) override {
+        if (ok) {
+          StartRead(&message_);
+        } else {
+          Finish(Status::CANCELLED);
+        }
+      }
+      void OnDone() override { delete this; }
+
+     private:
+      const bool echo_once_;
+      ByteBuffer message_;
+    };
+    return new Reactor(ctx);
+  }
+};
+
+constexpr char ProxyBackendService::kEchoMethod[];
+constexpr char ProxyBackendService::kFailMethod[];
+constexpr char ProxyBackendService::kEchoOnceMethod[];
+
+// Writes num_messages requests, one at a time, and reads responses until the
+// call ends.
+class ProxyBidiClient : public ClientBidiReactor<ByteBuffer, ByteBuffer> {
+ public:
+  ProxyBidiClient(GenericStub* stub, const std::string& method,
+                  int num_messages, bool writes_done)
+      : num_messages_(num_messages), writes_done_(writes_done) {
+    stub->PrepareBidiStreamingCall(&context_, method, StubOptions(), this);
+    WriteNext();
+    StartRead(&response_);
+    StartCall();
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (ok) WriteNext();
+  }
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    EchoRequest response;
+    EXPECT_TRUE(ParseFromByteBuffer(&response_, &response));
+    responses_.push_back(response.message());
+    StartRead(&response_);
+  }
+  void OnDone(const Status& s) override {
+    std::lock_guard<std::mutex> l(mu_);
+    status_ = s;
+    done_ = true;
+    cv_.notify_one();
+  }
+
+  Status Await() {
+    std::unique_lock<std::mutex> l(mu_);
+    while (!done_) cv_.wait(l);
+    return status_;
+  }
+  const std::vector<std::string>& responses() const { return responses_; }
+
+ private:
+  void WriteNext() {
+    if (num_sent_ == num_messages_) {
+      if (writes_done_) StartWritesDone();
+      return;
+    }
+    EchoRequest request;
+    request.set_message("message " + std::to_string(num_sent_++));
+    EXPECT_TRUE(SerializeToByteBufferInPlace(&request, &request_));
+    StartWrite(&request_);
+  }
+
+  const int num_messages_;
+  const bool writes_done_;
+  int num_sent_ = 0;
+  ClientContext context_;
+  ByteBuffer request_;
+  ByteBuffer response_;
+  std::vector<std::string> responses_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool done_ = false;
+  Status status_;
+};
+
+class GenericProxyEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ServerBuilder backend_builder;
+    backend_builder.RegisterCallbackGenericService(&backend_service_);
+    backend_ = backend_builder.BuildAndStart();
+    proxy_service_ =
+        std::make_unique<experimental::CallbackGenericProxyService>(
+            backend_->InProcessChannel(ChannelArguments()));
+    ServerBuilder proxy_builder;
+    proxy_builder.RegisterCallbackGenericService(proxy_service_.get());
+    proxy_ = proxy_builder.BuildAndStart();
+    generic_stub_ = std::make_unique<GenericStub>(
+        proxy_->InProcessChannel(ChannelArguments()));
+  }
+
+  void TearDown() override {
+    proxy_->Shutdown();
+    backend_->Shutdown();
+  }
+
+  Status UnaryCall(ClientContext* context, const std::string& method,
+                   EchoRequest request, EchoRequest* response) {
+    std::unique_ptr<ByteBuffer> send_buffer = SerializeToByteBuffer(&request);
+    ByteBuffer recv_buffer;
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    Status status;
+    generic_stub_->UnaryCall(context, method, StubOptions(), send_buffer.get(),
+                             &recv_buffer,
+                             [&mu, &cv, &done, &status](Status s) {
+                               std::lock_guard<std::mutex> l(mu);
+                               status = std::move(s);
+                               done = true;
+                               cv.notify_one();
+                             });
+    std::unique_lock<std::mutex> l(mu);
+    while (!done) cv.wait(l);
+    if (status.ok()) EXPECT_TRUE(ParseFromByteBuffer(&recv_buffer, response));
+    return status;
+  }
+
+  ProxyBackendService backend_service_;
+  std::unique_ptr<Server> backend_;
+  std::unique_ptr<experimental::CallbackGenericProxyService> proxy_service_;
+  std::unique_ptr<Server> proxy_;
+  std::unique_ptr<GenericStub> generic_stub_;
+};
+
+TEST_F(GenericProxyEnd2endTest, UnaryRpc) {
+  ClientContext context;
+  context.AddMetadata("x-request-id", "42");
+  EchoRequest request;
+  EchoRequest response;
+  request.set_message("Hello world. Hello world. Hello world.");
+  Status s = UnaryCall(&context, ProxyBackendService::kEchoMethod, request,
+                       &response);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(request.message(), response.message());
+  const auto& initial_metadata = context.GetServerInitialMetadata();
+  auto it = initial_metadata.find("x-request-id");
+  ASSERT_NE(it, initial_metadata.end());
+  EXPECT_EQ(ToString(it->second), "42");
+  const auto& trailing_metadata = context.GetServerTrailingMetadata();
+  it = trailing_metadata.find("x-request-id");
+  ASSERT_NE(it, trailing_metadata.end());
+  EXPECT_EQ(ToString(it->second), "42");
+}
+
+TEST_F(GenericProxyEnd2endTest, ErrorStatus) {
+  ClientContext context;
+  EchoRequest request;
+  EchoRequest response;
+  Status s = UnaryCall(&context, ProxyBackendService::kFailMethod, request,
+                       &response);
+  EXPECT_EQ(s.error_code(), StatusCode::PERMISSION_DENIED);
+  EXPECT_EQ(s.error_message(), "denied");
+}
+
+TEST_F(GenericProxyEnd2endTest, BidiStreaming) {
+  ProxyBidiClient client(generic_stub_.get(), ProxyBackendService::kEchoMethod,
+                         10, /*writes_done=*/true);
+  EXPECT_TRUE(client.Await().ok());
+  ASSERT_EQ(client.responses().size(), 10u);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(client.responses()[i], "message " + std::to_string(i));
+  }
+}
+
+TEST_F(GenericProxyEnd2endTest, BackendFinishesBeforeHalfClose) {
+  // The proxy must forward the backend's status even though the client never
+  // half-closes its side of the stream.
+  ProxyBidiClient client(generic_stub_.get(),
+                         ProxyBackendService::kEchoOnceMethod, 1,
+                         /*writes_done=*/false);
+  EXPECT_TRUE(client.Await().ok());
+  ASSERT_EQ(client.responses().size(), 1u);
+  EXPECT_EQ(client.responses()[0], "message 0");
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
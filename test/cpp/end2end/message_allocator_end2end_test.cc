@@ -23,6 +23,7 @@
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <string>
 #include <thread>
 
 #include <google/protobuf/arena.h>
@@ -37,6 +38,7 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/client_callback.h>
 #include <grpcpp/support/message_allocator.h>
+#include <grpcpp/support/pooled_message_allocator.h>
 
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -77,6 +79,22 @@ class CallbackTestServiceImpl : public EchoTestService::CallbackService {
       allocator_mutator_;
 };
 
+// Counts the RPCs whose request and response share a protobuf arena.
+class SyncTestServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    if (request->GetArena() != nullptr &&
+        request->GetArena() == response->GetArena()) {
+      arena_rpc_count++;
+    }
+    return Status::OK;
+  }
+
+  std::atomic_int arena_rpc_count{0};
+};
+
 enum class Protocol { INPROC, TCP };
 
 class TestScenario {
@@ -107,7 +125,9 @@ class MessageAllocatorEnd2endTestBase
 
   ~MessageAllocatorEnd2endTestBase() override = default;
 
-  void CreateServer(MessageAllocator<EchoRequest, EchoResponse>* allocator) {
+  void CreateServer(MessageAllocator<EchoRequest, EchoResponse>* allocator,
+                    const std::string& protobuf_arena_name = "",
+                    Service* service = nullptr) {
     ServerBuilder builder;
 
     auto server_creds = GetCredentialsProvider()->GetServerCredentials(
@@ -117,8 +137,19 @@ class MessageAllocatorEnd2endTestBase
       server_address_ << "localhost:" << picked_port_;
       builder.AddListeningPort(server_address_.str(), server_creds);
     }
-    callback_service_.SetMessageAllocatorFor_Echo(allocator);
-    builder.RegisterService(&callback_service_);
+    if (!protobuf_arena_name.empty()) {
+      builder.experimental().EnableProtobufArena(protobuf_arena_name);
+    }
+    if (message_pool_capacity_ > 0) {
+      builder.experimental().EnablePooledMessageAllocator(
+          message_pool_capacity_);
+    }
+    if (service != nullptr) {
+      builder.RegisterService(service);
+    } else {
+      callback_service_.SetMessageAllocatorFor_Echo(allocator);
+      builder.RegisterService(&callback_service_);
+    }
 
     server_ = builder.BuildAndStart();
   }
@@ -188,6 +219,7 @@ class MessageAllocatorEnd2endTestBase
   }
 
   int picked_port_{0};
+  size_t message_pool_capacity_{0};
   std::shared_ptr<Channel> channel_;
   std::unique_ptr<EchoTestService::Stub> stub_;
   CallbackTestServiceImpl callback_service_;
@@ -352,6 +384,200 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+class ProtobufArenaTest : public MessageAllocatorEnd2endTestBase {
+ protected:
+  void ExpectCallbackMessagesOnArena(bool on_arena) {
+    auto mutator = [this, on_arena](RpcAllocatorState* /*allocator_state*/,
+                                    const EchoRequest* req,
+                                    EchoResponse* resp) {
+      EXPECT_EQ(on_arena, req->GetArena() != nullptr);
+      EXPECT_EQ(req->GetArena(), resp->GetArena());
+      rpc_count_++;
+    };
+    callback_service_.SetAllocatorMutator(mutator);
+  }
+
+  std::atomic_int rpc_count_{0};
+};
+
+TEST_P(ProtobufArenaTest, CallbackService) {
+  const int kRpcCount = 10;
+  ExpectCallbackMessagesOnArena(true);
+  CreateServer(nullptr, "grpc.testing.EchoTestService");
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, rpc_count_);
+}
+
+TEST_P(ProtobufArenaTest, CallbackMethod) {
+  const int kRpcCount = 10;
+  ExpectCallbackMessagesOnArena(true);
+  CreateServer(nullptr, "/grpc.testing.EchoTestService/Echo");
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, rpc_count_);
+}
+
+TEST_P(ProtobufArenaTest, CallbackOtherMethod) {
+  const int kRpcCount = 10;
+  ExpectCallbackMessagesOnArena(false);
+  CreateServer(nullptr, "/grpc.testing.EchoTestService/Echo1");
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, rpc_count_);
+}
+
+TEST_P(ProtobufArenaTest, CustomAllocatorTakesPrecedence) {
+  const int kRpcCount = 10;
+  std::unique_ptr<SimpleAllocatorTest::SimpleAllocator> allocator(
+      new SimpleAllocatorTest::SimpleAllocator);
+  ExpectCallbackMessagesOnArena(false);
+  CreateServer(allocator.get(), "grpc.testing.EchoTestService");
+  ResetStub();
+  SendRpcs(kRpcCount);
+  DestroyServer();
+  EXPECT_EQ(kRpcCount, allocator->allocation_count);
+  EXPECT_EQ(kRpcCount, allocator->messages_deallocation_count);
+}
+
+TEST_P(ProtobufArenaTest, SyncService) {
+  const int kRpcCount = 10;
+  SyncTestServiceImpl service;
+  CreateServer(nullptr, "grpc.testing.EchoTestService", &service);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, service.arena_rpc_count);
+}
+
+TEST_P(ProtobufArenaTest, SyncServiceNotEnabled) {
+  const int kRpcCount = 10;
+  SyncTestServiceImpl service;
+  CreateServer(nullptr, "", &service);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(0, service.arena_rpc_count);
+}
+
+class PooledAllocatorTest : public MessageAllocatorEnd2endTestBase {
+ protected:
+  // Checks that reused responses were cleared, then leaves a field set that
+  // the next RPC must not see.
+  void ExpectClearedMessages() {
+    auto mutator = [this](RpcAllocatorState* /*allocator_state*/,
+                          const EchoRequest* req, EchoResponse* resp) {
+      EXPECT_FALSE(req->has_param());
+      EXPECT_FALSE(resp->has_param());
+      resp->mutable_param()->set_host("pooled");
+      rpc_count_++;
+    };
+    callback_service_.SetAllocatorMutator(mutator);
+  }
+
+  std::atomic_int rpc_count_{0};
+};
+
+TEST_P(PooledAllocatorTest, CustomAllocator) {
+  const int kRpcCount = 50;
+  experimental::PooledMessageAllocator<EchoRequest, EchoResponse> allocator(
+      /*capacity=*/4);
+  ExpectClearedMessages();
+  CreateServer(&allocator);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  DestroyServer();
+  EXPECT_EQ(kRpcCount, rpc_count_);
+  // RPCs run one at a time, so a new pair is only allocated from a shard
+  // that has none to reuse yet.
+  EXPECT_LT(allocator.messages_allocated(), static_cast<size_t>(kRpcCount));
+}
+
+TEST_P(PooledAllocatorTest, ServerBuilderOption) {
+  const int kRpcCount = 50;
+  message_pool_capacity_ = 4;
+  ExpectClearedMessages();
+  CreateServer(nullptr);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, rpc_count_);
+}
+
+TEST_P(PooledAllocatorTest, CustomAllocatorTakesPrecedence) {
+  const int kRpcCount = 10;
+  std::unique_ptr<SimpleAllocatorTest::SimpleAllocator> allocator(
+      new SimpleAllocatorTest::SimpleAllocator);
+  message_pool_capacity_ = 4;
+  CreateServer(allocator.get());
+  ResetStub();
+  SendRpcs(kRpcCount);
+  DestroyServer();
+  EXPECT_EQ(kRpcCount, allocator->allocation_count);
+  EXPECT_EQ(kRpcCount, allocator->messages_deallocation_count);
+}
+
+TEST_P(PooledAllocatorTest, ProtobufArenaTakesPrecedence) {
+  const int kRpcCount = 10;
+  message_pool_capacity_ = 4;
+  std::atomic_int arena_rpc_count{0};
+  callback_service_.SetAllocatorMutator(
+      [&arena_rpc_count](RpcAllocatorState* /*allocator_state*/,
+                         const EchoRequest* req, EchoResponse* /*resp*/) {
+        if (req->GetArena() != nullptr) arena_rpc_count++;
+      });
+  CreateServer(nullptr, "grpc.testing.EchoTestService");
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, arena_rpc_count);
+}
+
+// A message that counts its live instances.
+class CountedMessage {
+ public:
+  CountedMessage() { live_.fetch_add(1, std::memory_order_relaxed); }
+  ~CountedMessage() { live_.fetch_sub(1, std::memory_order_relaxed); }
+  void Clear() {}
+  static int live() { return live_.load(std::memory_order_relaxed); }
+
+ private:
+  static std::atomic_int live_;
+};
+std::atomic_int CountedMessage::live_{0};
+
+TEST(PooledMessageAllocatorTest, AllocatorFreesPooledMessages) {
+  const int kThreads = 4;
+  const int kPairsPerThread = 8;
+  {
+    experimental::PooledMessageAllocator<CountedMessage, CountedMessage>
+        allocator(/*capacity=*/kPairsPerThread);
+    // Short-lived threads allocate pairs that this thread releases, so that
+    // they are kept for reuse.
+    std::vector<MessageHolder<CountedMessage, CountedMessage>*> holders;
+    std::mutex mu;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; i++) {
+      threads.emplace_back([&allocator, &holders, &mu] {
+        for (int j = 0; j < kPairsPerThread; j++) {
+          auto* holder = allocator.AllocateMessages();
+          std::lock_guard<std::mutex> l(mu);
+          holders.push_back(holder);
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto* holder : holders) holder->Release();
+    EXPECT_GT(CountedMessage::live(), 0);
+    // A pair released by another thread goes back to where it came from, so
+    // it is reused by the allocating thread.
+    auto* holder = allocator.AllocateMessages();
+    std::thread([holder] { holder->Release(); }).join();
+    const size_t allocated = allocator.messages_allocated();
+    allocator.AllocateMessages()->Release();
+    EXPECT_EQ(allocator.messages_allocated(), allocated);
+  }
+  // Destroying the allocator frees the pairs it kept, even those released by
+  // a thread that is still running.
+  EXPECT_EQ(CountedMessage::live(), 0);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<std::string> credentials_types{
@@ -387,6 +613,10 @@ INSTANTIATE_TEST_SUITE_P(SimpleAllocatorTest, SimpleAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
 INSTANTIATE_TEST_SUITE_P(ArenaAllocatorTest, ArenaAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_SUITE_P(ProtobufArenaTest, ProtobufArenaTest,
+                         ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_SUITE_P(PooledAllocatorTest, PooledAllocatorTest,
+                         ::testing::ValuesIn(CreateTestScenarios(true)));
 
 }  // namespace
 }  // namespace testing
@@ -177,6 +177,25 @@ class CommonStressTestSyncServerLowThreadCount : public BaseClass {
   TestServiceImpl service_;
 };
 
+template <class BaseClass, int max_concurrent_rpcs, int max_queued_rpcs>
+class CommonStressTestSyncServerExecutor : public BaseClass {
+ public:
+  void SetUp() override {
+    ServerBuilder builder;
+    this->SetUpStart(&builder, &service_);
+    builder.experimental().EnableSyncServerExecutor(max_concurrent_rpcs,
+                                                    max_queued_rpcs);
+    this->SetUpEnd(&builder);
+  }
+  void TearDown() override {
+    this->TearDownStart();
+    this->TearDownEnd();
+  }
+
+ private:
+  TestServiceImpl service_;
+};
+
 template <class BaseClass>
 class CommonStressTestAsyncServer : public BaseClass {
  public:
@@ -306,6 +325,10 @@ typedef ::testing::Types<
     CommonStressTestSyncServer<CommonStressTestInproc<TestServiceImpl, false>>,
     CommonStressTestSyncServerLowThreadCount<
         CommonStressTestInproc<TestServiceImpl, true>>,
+    CommonStressTestSyncServerExecutor<
+        CommonStressTestInsecure<TestServiceImpl>, 4, -1>,
+    CommonStressTestSyncServerExecutor<
+        CommonStressTestInproc<TestServiceImpl, true>, 1, 1>,
     CommonStressTestAsyncServer<
         CommonStressTestInsecure<grpc::testing::EchoTestService::AsyncService>>,
     CommonStressTestAsyncServer<CommonStressTestInproc<
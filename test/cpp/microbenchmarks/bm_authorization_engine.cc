@@ -0,0 +1,124 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark per-call RBAC evaluation against policies with many rules.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/rbac_policy.h"
+#include "test/core/util/evaluate_args_test_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+enum class RuleKind {
+  // Each rule allows one method.
+  kExactPath,
+  // Each rule allows all methods of one service.
+  kPrefixPath,
+  // Each rule matches a header, which can't be indexed by path.
+  kHeader,
+};
+
+std::string ServiceName(int i) { return absl::StrCat("/pkg.Service", i, "/"); }
+
+Rbac::Permission MakePermission(RuleKind kind, int i) {
+  switch (kind) {
+    case RuleKind::kExactPath:
+      return Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kExact,
+                                absl::StrCat(ServiceName(i), "Method"))
+              .value());
+    case RuleKind::kPrefixPath:
+      return Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kPrefix, ServiceName(i))
+              .value());
+    case RuleKind::kHeader:
+      return Rbac::Permission::MakeHeaderPermission(
+          HeaderMatcher::Create("tenant", HeaderMatcher::Type::kExact,
+                                absl::StrCat("tenant", i))
+              .value());
+  }
+  GPR_UNREACHABLE_CODE(return Rbac::Permission());
+}
+
+// Builds an allow engine with state.range(0) rules, each also restricted to
+// peers in 127.0.0.0/8, and evaluates a call matching the last rule.
+void BM_EvaluateLastRule(benchmark::State& state, RuleKind kind) {
+  const int num_rules = state.range(0);
+  std::map<std::string, Rbac::Policy> policies;
+  for (int i = 0; i < num_rules; ++i) {
+    policies[absl::StrCat("policy", i)] = Rbac::Policy(
+        MakePermission(kind, i), Rbac::Principal::MakeDirectRemoteIpPrincipal(
+                                     Rbac::CidrRange("127.0.0.0", 8)));
+  }
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  const int last = num_rules - 1;
+  const std::string path = absl::StrCat(ServiceName(last), "Method");
+  const std::string tenant = absl::StrCat("tenant", last);
+  EvaluateArgsTestUtil util;
+  util.SetPeerEndpoint("ipv4:127.0.0.1:443");
+  util.AddPairToMetadata(":path", path.c_str());
+  util.AddPairToMetadata("tenant", tenant.c_str());
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    AuthorizationEngine::Decision decision = engine.Evaluate(args);
+    if (decision.type != AuthorizationEngine::Decision::Type::kAllow) {
+      state.SkipWithError("call was not allowed");
+      break;
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_EvaluateLastRule, ExactPath, RuleKind::kExactPath)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+BENCHMARK_CAPTURE(BM_EvaluateLastRule, PrefixPath, RuleKind::kPrefixPath)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+BENCHMARK_CAPTURE(BM_EvaluateLastRule, Header, RuleKind::kHeader)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
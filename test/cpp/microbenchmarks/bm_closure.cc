@@ -18,12 +18,17 @@
 
 /* Test various closure related operations */
 
+#include <atomic>
+#include <memory>
 #include <sstream>
 
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
@@ -293,6 +298,68 @@ static void BM_ClosureSched4OnTwoCombiners(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureSched4OnTwoCombiners);
 
+// State shared by the threads of BM_ClosureSchedOnContendedCombiner.
+static grpc_core::Combiner* g_contended_combiner;
+static std::unique_ptr<grpc_core::GlobalStats> g_contended_stats_before;
+static std::atomic<int64_t> g_contended_closures_queued;
+static std::atomic<int64_t> g_contended_closures_run;
+static std::atomic<int> g_contended_threads_done;
+
+static void SpinAndCount(void* /*arg*/, grpc_error_handle /*error*/) {
+  // A little work, so that closures pile up behind each other.
+  for (int i = 0; i < 100; i++) benchmark::DoNotOptimize(i);
+  g_contended_closures_run.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Each thread queues closures on one combiner. The argument is the combiner's
+// batch quota: 0 for the default policy, which offloads when the combiner is
+// contended and the thread's exec_ctx is ready to finish.
+static void BM_ClosureSchedOnContendedCombiner(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    grpc_core::ExecCtx exec_ctx;
+    g_contended_combiner = grpc_combiner_create(state.range(0));
+    g_contended_closures_queued.store(0);
+    g_contended_closures_run.store(0);
+    g_contended_threads_done.store(0);
+    g_contended_stats_before = grpc_core::global_stats().Collect();
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (auto _ : state) {
+      g_contended_combiner->Run(
+          GRPC_CLOSURE_CREATE(SpinAndCount, nullptr, nullptr),
+          absl::OkStatus());
+      grpc_core::ExecCtx::Get()->Flush();
+    }
+  }
+  g_contended_closures_queued.fetch_add(state.iterations());
+  // The last thread out waits for the executor, and reports for all threads.
+  if (g_contended_threads_done.fetch_add(1) + 1 != state.threads()) return;
+  while (g_contended_closures_run.load() != g_contended_closures_queued.load()) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_COMBINER_UNREF(g_contended_combiner, "finished");
+  auto stats = grpc_core::global_stats().Collect()->Diff(
+      *g_contended_stats_before);
+  const double closures = g_contended_closures_queued.load();
+  state.counters["offloads_per_1k"] =
+      1000.0 * stats->combiner_locks_offloaded / closures;
+  state.counters["queue_us_p99"] =
+      stats->histogram(grpc_core::GlobalStats::Histogram::kCombinerTimeInQueue)
+          .Percentile(99);
+  state.counters["batch_p50"] =
+      stats->histogram(grpc_core::GlobalStats::Histogram::kCombinerBatchSize)
+          .Percentile(50);
+}
+BENCHMARK(BM_ClosureSchedOnContendedCombiner)
+    ->ArgName("batch_quota")
+    ->Arg(0)
+    ->Arg(4)
+    ->Arg(32)
+    ->ThreadRange(1, 4)
+    ->UseRealTime();
+
 // Helper that continuously reschedules the same closure against something until
 // the benchmark is complete
 class Rescheduler {
@@ -26,6 +26,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
@@ -180,6 +181,9 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 
   state.SetItemsProcessed(state.iterations());
+  if (grpc_core::IsShardedCompletionQueueEnabled()) {
+    state.SetLabel("sharded");
+  }
 
   gpr_mu_lock(&g_mu);
   g_threads_active--;
@@ -198,7 +202,9 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
-BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
+// Run with GRPC_EXPERIMENTS=sharded_completion_queue to measure the sharded
+// event queue, which keeps each poller's completions on its own shard.
+BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 64)->UseRealTime();
 
 namespace {
 const grpc_event_engine_vtable g_none_vtable =
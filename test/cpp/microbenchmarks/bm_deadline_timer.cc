@@ -0,0 +1,114 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark the per-call cost of the deadline filter timer: starting it when
+// the call starts and cancelling it when the call completes in time, with a
+// grpc_timer per call or with the CoalescedDeadlineTimer the filter uses.
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+namespace {
+
+struct PerCallTimer {
+  void Init(grpc_core::Timestamp deadline, grpc_closure* closure) {
+    grpc_timer_init(&timer, deadline, closure);
+  }
+  void Cancel() { grpc_timer_cancel(&timer); }
+
+  grpc_timer timer;
+};
+
+void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+}  // namespace
+
+// Calls start at 500k calls/s of simulated time, each with a deadline of
+// 200ms, and complete in order, with state.range(0) calls in flight. The
+// simulated clock runs an hour ahead of the real one, so that no timer fires
+// during the benchmark.
+template <class Timer>
+static void BM_DeadlineTimer(benchmark::State& state) {
+  constexpr int64_t kCallsPerSecond = 500000;
+  const size_t calls_in_flight = state.range(0);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<Timer> timers(calls_in_flight);
+  std::vector<grpc_closure> closures(calls_in_flight);
+  for (grpc_closure& closure : closures) {
+    GRPC_CLOSURE_INIT(&closure, DoNothing, nullptr, nullptr);
+  }
+  const grpc_core::Timestamp start = exec_ctx.Now() +
+                                     grpc_core::Duration::Hours(1) +
+                                     grpc_core::Duration::Milliseconds(200);
+  int64_t calls = 0;
+  for (auto _ : state) {
+    const size_t i = calls % calls_in_flight;
+    if (calls >= static_cast<int64_t>(calls_in_flight)) {
+      timers[i].Cancel();
+      // Run the closure of the cancelled timer before reusing it.
+      exec_ctx.Flush();
+    }
+    timers[i].Init(start + grpc_core::Duration::Milliseconds(
+                               calls * 1000 / kCallsPerSecond),
+                   &closures[i]);
+    ++calls;
+  }
+  for (int64_t i = 0; i < std::min<int64_t>(calls, calls_in_flight); i++) {
+    timers[i].Cancel();
+  }
+  exec_ctx.Flush();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_DeadlineTimer, PerCallTimer)
+    ->Arg(1)
+    ->Arg(1000)
+    ->Arg(100000);
+BENCHMARK_TEMPLATE(BM_DeadlineTimer, grpc_core::CoalescedDeadlineTimer)
+    ->Arg(1)
+    ->Arg(1000)
+    ->Arg(100000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
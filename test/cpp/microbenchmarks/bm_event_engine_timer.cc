@@ -0,0 +1,172 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark the posix event engine timer collections, TimerList and
+// TimerWheel, on the pattern of RPC deadlines: most timers are cancelled
+// before they fire, while many others are outstanding.
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+namespace {
+
+class FakeHost : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+        now.load(std::memory_order_relaxed));
+  }
+  void Kick() override {}
+
+  std::atomic<int64_t> now{1000};
+};
+
+class NoopClosure : public experimental::EventEngine::Closure {
+ public:
+  void Run() override {}
+};
+
+// A timer collection with \a outstanding timers due in the minute after
+// \a delay.
+template <class TimerListType>
+struct Fixture {
+  Fixture(int64_t outstanding, grpc_core::Duration delay)
+      : timers(new TimerListType(&host)), outstanding_timers(outstanding) {
+    std::mt19937 rng(42);
+    for (Timer& timer : outstanding_timers) {
+      timers->TimerInit(
+          &timer,
+          host.Now() + delay + grpc_core::Duration::Milliseconds(rng() % 60000),
+          &closure);
+    }
+  }
+
+  ~Fixture() {
+    for (Timer& timer : outstanding_timers) {
+      GPR_ASSERT(timers->TimerCancel(&timer));
+    }
+  }
+
+  FakeHost host;
+  NoopClosure closure;
+  std::unique_ptr<TimerListInterface> timers;
+  std::vector<Timer> outstanding_timers;
+};
+
+template <class TimerListType>
+Fixture<TimerListType>* g_fixture;
+
+}  // namespace
+
+// Arms a timer due in 200ms and cancels it, as a call with a deadline that
+// completes in time does, with state.range(0) timers outstanding. The
+// collection is shared by the threads of the benchmark.
+template <class TimerListType>
+static void BM_TimerArmCancel(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    g_fixture<TimerListType> = new Fixture<TimerListType>(
+        state.range(0), grpc_core::Duration::Seconds(1));
+  }
+  Timer timer;
+  for (auto _ : state) {
+    Fixture<TimerListType>* fixture = g_fixture<TimerListType>;
+    fixture->timers->TimerInit(
+        &timer,
+        fixture->host.Now() + grpc_core::Duration::Milliseconds(200),
+        &fixture->closure);
+    GPR_ASSERT(fixture->timers->TimerCancel(&timer));
+  }
+  if (state.thread_index() == 0) {
+    delete g_fixture<TimerListType>;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_TimerArmCancel, TimerList)
+    ->Arg(0)
+    ->Arg(1000)
+    ->Arg(1000000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TimerArmCancel, TimerWheel)
+    ->Arg(0)
+    ->Arg(1000)
+    ->Arg(1000000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Arms 10000 timers due over the next second, then runs them by checking for
+// expired timers every millisecond, with state.range(0) timers outstanding
+// that do not expire during the benchmark. Reports the cost per timer.
+template <class TimerListType>
+static void BM_TimerArmExpire(benchmark::State& state) {
+  constexpr int kTimers = 10000;
+  Fixture<TimerListType> fixture(state.range(0),
+                                 grpc_core::Duration::Hours(24));
+  std::vector<Timer> timers(kTimers);
+  for (auto _ : state) {
+    const grpc_core::Timestamp start = fixture.host.Now();
+    for (int i = 0; i < kTimers; i++) {
+      fixture.timers->TimerInit(
+          &timers[i],
+          start + grpc_core::Duration::Milliseconds(1 + i * 1000 / kTimers),
+          &fixture.closure);
+    }
+    size_t fired = 0;
+    while (fired < kTimers) {
+      fixture.host.now.fetch_add(1, std::memory_order_relaxed);
+      auto expired = fixture.timers->TimerCheck(nullptr);
+      GPR_ASSERT(expired.has_value());
+      fired += expired->size();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kTimers);
+}
+BENCHMARK_TEMPLATE(BM_TimerArmExpire, TimerList)->Arg(0)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_TimerArmExpire, TimerWheel)->Arg(0)->Arg(1000000);
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
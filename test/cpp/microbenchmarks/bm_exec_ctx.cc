@@ -17,9 +17,12 @@
 
 #include <benchmark/benchmark.h>
 
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
 #include <grpcpp/impl/grpc_library.h>
 
 #include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -85,6 +88,72 @@ BENCHMARK(BM_ExecCtx_RunCounted)
     ->Range(100, 10000)
     ->MeasureProcessCPUTime()
     ->UseRealTime();
+
+// Enter core from code that already holds an ExecCtx, as the C++ API layers
+// do, scheduling a closure (and reading the time, if read_now) each time. With
+// the pass_through_exec_ctx experiment the nested ExecCtx defers to the outer
+// one, whose closures are flushed every flush_every entries.
+void BM_ExecCtx_Nested(benchmark::State& state) {
+  const int flush_every = state.range(0);
+  const bool read_now = state.range(1) != 0;
+  // A closure may not be scheduled again before it ran: one per pending entry.
+  grpc_closure cbs[16];
+  GPR_ASSERT(flush_every <= 16);
+  for (grpc_closure& c : cbs) GRPC_CLOSURE_INIT(&c, NoOpCb, nullptr, nullptr);
+  grpc_core::ExecCtx outer;
+  int pending = 0;
+  for (auto _ : state) {
+    {
+      grpc_core::ExecCtx inner;
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, &cbs[pending], absl::OkStatus());
+      if (read_now) benchmark::DoNotOptimize(inner.Now());
+    }
+    if (++pending == flush_every) {
+      outer.Flush();
+      pending = 0;
+    }
+  }
+  outer.Flush();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecCtx_Nested)->ArgsProduct({{1, 16}, {0, 1}});
+
+// Per-call overhead of grpc_call_start_batch(), called from outside core or
+// (if nested) under an ExecCtx held by the caller. The empty batch completes
+// at once, and is reaped outside the ExecCtx.
+void BM_ExecCtx_CallStartBatch(benchmark::State& state) {
+  const bool nested = state.range(0) != 0;
+  grpc_channel* channel = grpc_lame_client_channel_create(
+      "localhost:1234", GRPC_STATUS_UNAUTHENTICATED, "blah");
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_call* call = grpc_channel_create_call(
+      channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+      grpc_slice_from_static_string("/grpc.testing.EchoTestService/Echo"),
+      nullptr, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  for (auto _ : state) {
+    if (nested) {
+      grpc_core::ExecCtx exec_ctx;
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_call_start_batch(call, nullptr, 0, call, nullptr));
+    } else {
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_call_start_batch(call, nullptr, 0, call, nullptr));
+    }
+    grpc_event ev = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+  }
+  grpc_call_unref(call);
+  grpc_channel_destroy(channel);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecCtx_CallStartBatch)->Arg(0)->Arg(1);
 }  // namespace
 
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
@@ -54,6 +54,40 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcess)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcessCHTTP2)->Arg(0);
 
+// The callback API, with one write per OnWriteDone or with the write queue
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, TCP, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, TCP, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, UDS, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, UDS, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, InProcess, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, InProcess, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, InProcessCHTTP2, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamClientToServer, InProcessCHTTP2, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, TCP, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, TCP, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, UDS, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, UDS, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, InProcess, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, InProcess, true)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, InProcessCHTTP2, false)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_CallbackPumpStreamServerToClient, InProcessCHTTP2, true)
+    ->Range(0, 128 * 1024 * 1024);
+
 }  // namespace testing
 }  // namespace grpc
 
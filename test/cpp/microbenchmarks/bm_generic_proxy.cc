@@ -0,0 +1,223 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark the latency and CPU that a generic proxy built on
+// SpliceGenericCall adds to each call and to each streamed message, by
+// calling an echo backend directly and through the proxy. Both hops are
+// in-process so that only the proxy's own work is measured.
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Writes back every message it reads.
+class GenericEchoService : public CallbackGenericService {
+ public:
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* /*ctx*/) override {
+    class Reactor : public ServerGenericBidiReactor {
+     public:
+      Reactor() { StartRead(&message_); }
+      void OnReadDone(bool ok) override {
+        if (ok) {
+          StartWrite(&message_);
+        } else {
+          Finish(Status::OK);
+        }
+      }
+      void OnWriteDone(bool ok) override {
+        if (ok) {
+          StartRead(&message_);
+        } else {
+          Finish(Status::CANCELLED);
+        }
+      }
+      void OnDone() override { delete this; }
+
+     private:
+      ByteBuffer message_;
+    };
+    return new Reactor;
+  }
+};
+
+// An echo backend, reached directly or through a proxy if \a proxied.
+class ProxyFixture {
+ public:
+  explicit ProxyFixture(bool proxied) {
+    ServerBuilder backend_builder;
+    backend_builder.RegisterCallbackGenericService(&backend_service_);
+    backend_ = backend_builder.BuildAndStart();
+    std::shared_ptr<Channel> channel =
+        backend_->InProcessChannel(ChannelArguments());
+    if (proxied) {
+      proxy_service_ =
+          std::make_unique<experimental::CallbackGenericProxyService>(channel);
+      ServerBuilder proxy_builder;
+      proxy_builder.RegisterCallbackGenericService(proxy_service_.get());
+      proxy_ = proxy_builder.BuildAndStart();
+      channel = proxy_->InProcessChannel(ChannelArguments());
+    }
+    stub_ = std::make_unique<GenericStub>(channel);
+  }
+
+  ~ProxyFixture() {
+    if (proxy_ != nullptr) proxy_->Shutdown();
+    backend_->Shutdown();
+  }
+
+  GenericStub* stub() { return stub_.get(); }
+
+ private:
+  GenericEchoService backend_service_;
+  std::unique_ptr<Server> backend_;
+  std::unique_ptr<experimental::CallbackGenericProxyService> proxy_service_;
+  std::unique_ptr<Server> proxy_;
+  std::unique_ptr<GenericStub> stub_;
+};
+
+ByteBuffer MakeMessage(size_t size) {
+  Slice slice(std::string(size, 'a'));
+  return ByteBuffer(&slice, 1);
+}
+
+// state.range(0) bytes per message, proxied if state.range(1) is set. One
+// unary call at a time.
+static void BM_GenericProxyUnary(benchmark::State& state) {
+  ProxyFixture fixture(state.range(1) != 0);
+  ByteBuffer request = MakeMessage(state.range(0));
+  for (auto _ : state) {
+    ClientContext context;
+    ByteBuffer response;
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    fixture.stub()->UnaryCall(&context, "/grpc.testing.Proxy/Echo",
+                              StubOptions(), &request, &response,
+                              [&mu, &cv, &done](Status s) {
+                                GPR_ASSERT(s.ok());
+                                std::lock_guard<std::mutex> l(mu);
+                                done = true;
+                                cv.notify_one();
+                              });
+    std::unique_lock<std::mutex> l(mu);
+    while (!done) cv.wait(l);
+  }
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+BENCHMARK(BM_GenericProxyUnary)
+    ->ArgsProduct({{1, 1024, 64 * 1024, 1024 * 1024}, {0, 1}})
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
+// Sends a message and waits for its echo, one message in flight at a time.
+class PingPongClient : public ClientBidiReactor<ByteBuffer, ByteBuffer> {
+ public:
+  PingPongClient(GenericStub* stub, ByteBuffer request)
+      : request_(std::move(request)) {
+    stub->PrepareBidiStreamingCall(&context_, "/grpc.testing.Proxy/Stream",
+                                   StubOptions(), this);
+    StartCall();
+  }
+
+  void PingPong() {
+    StartWrite(&request_);
+    StartRead(&response_);
+    std::unique_lock<std::mutex> l(mu_);
+    while (!read_done_) cv_.wait(l);
+    read_done_ = false;
+  }
+
+  void Finish() {
+    StartWritesDone();
+    std::unique_lock<std::mutex> l(mu_);
+    while (!done_) cv_.wait(l);
+  }
+
+  void OnReadDone(bool ok) override {
+    GPR_ASSERT(ok);
+    std::lock_guard<std::mutex> l(mu_);
+    read_done_ = true;
+    cv_.notify_one();
+  }
+
+  void OnDone(const Status& s) override {
+    GPR_ASSERT(s.ok());
+    std::lock_guard<std::mutex> l(mu_);
+    done_ = true;
+    cv_.notify_one();
+  }
+
+ private:
+  ClientContext context_;
+  ByteBuffer request_;
+  ByteBuffer response_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool read_done_ = false;
+  bool done_ = false;
+};
+
+// state.range(0) bytes per message, proxied if state.range(1) is set. Each
+// iteration is one round trip on a long-lived stream.
+static void BM_GenericProxyStreamingPingPong(benchmark::State& state) {
+  ProxyFixture fixture(state.range(1) != 0);
+  PingPongClient client(fixture.stub(), MakeMessage(state.range(0)));
+  for (auto _ : state) {
+    client.PingPong();
+  }
+  client.Finish();
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+BENCHMARK(BM_GenericProxyStreamingPingPong)
+    ->ArgsProduct({{1, 1024, 64 * 1024, 1024 * 1024}, {0, 1}})
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,137 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark the per-call cost of client interceptors that only inject
+// metadata, with and without declaring the hook points they act on.
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/client_interceptor.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_test_service.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Adds an entry to the initial metadata of every call, the way tracing and
+// auth interceptors do.
+class MetadataInterceptor : public experimental::Interceptor {
+ public:
+  explicit MetadataInterceptor(bool declare_hook_points)
+      : declare_hook_points_(declare_hook_points) {}
+
+  void Intercept(experimental::InterceptorBatchMethods* methods) override {
+    if (methods->QueryInterceptionHookPoint(
+            experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA)) {
+      methods->GetSendInitialMetadata()->emplace("x-bm-interceptor", "1");
+    }
+    methods->Proceed();
+  }
+
+  uint32_t InterceptionHookPointsMask() const override {
+    return declare_hook_points_
+               ? experimental::InterceptionHookPointBit(
+                     experimental::InterceptionHookPoints::
+                         PRE_SEND_INITIAL_METADATA)
+               : experimental::kAllInterceptionHookPoints;
+  }
+
+ private:
+  const bool declare_hook_points_;
+};
+
+class MetadataInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  explicit MetadataInterceptorFactory(bool declare_hook_points)
+      : declare_hook_points_(declare_hook_points) {}
+
+  experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* /*info*/) override {
+    return new MetadataInterceptor(declare_hook_points_);
+  }
+
+ private:
+  const bool declare_hook_points_;
+};
+
+// state.range(0) client interceptors, which declare their hook points if
+// state.range(1) is set. One unary callback call at a time.
+static void BM_UnaryInterceptorChain(benchmark::State& state) {
+  CallbackStreamingTestService service;
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  for (int i = 0; i < state.range(0); i++) {
+    creators.push_back(
+        std::make_unique<MetadataInterceptorFactory>(state.range(1) != 0));
+  }
+  auto channel = server->experimental().InProcessChannelWithInterceptors(
+      ChannelArguments(), std::move(creators));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(channel));
+  EchoRequest request;
+  request.set_message("hello");
+  for (auto _ : state) {
+    ClientContext context;
+    EchoResponse response;
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    stub->async()->Echo(&context, &request, &response,
+                        [&mu, &cv, &done](Status s) {
+                          GPR_ASSERT(s.ok());
+                          std::lock_guard<std::mutex> l(mu);
+                          done = true;
+                          cv.notify_one();
+                        });
+    std::unique_lock<std::mutex> l(mu);
+    while (!done) cv.wait(l);
+  }
+  server->Shutdown();
+}
+BENCHMARK(BM_UnaryInterceptorChain)->ArgsProduct({{0, 1, 5, 10}, {0, 1}});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,84 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark memory allocators of a shared memory quota used from many
+// threads, where allocators take memory from and return memory to the quota.
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Shared by all the benchmarks: threads may still use their allocators after
+// the first one is done with a benchmark.
+static MemoryQuota* GetMemoryQuota() {
+  static MemoryQuota* memory_quota = [] {
+    auto* memory_quota = new MemoryQuota("bm_memory_quota");
+    // Large enough that the benchmarks never run out of memory.
+    memory_quota->SetSize(size_t{1} << 40);
+    return memory_quota;
+  }();
+  return memory_quota;
+}
+
+// Creates an allocator, makes one small reservation and destroys the
+// allocator, as a new connection or call does.
+static void BM_AllocatorChurn(benchmark::State& state) {
+  MemoryQuota* memory_quota = GetMemoryQuota();
+  ExecCtx exec_ctx;
+  for (auto _ : state) {
+    MemoryAllocator allocator = memory_quota->CreateMemoryAllocator("churn");
+    allocator.Release(allocator.Reserve(MemoryRequest(8192)));
+  }
+}
+BENCHMARK(BM_AllocatorChurn)->ThreadRange(1, 16)->UseRealTime();
+
+// Reserves and releases more than an allocator keeps for itself, so that
+// each iteration takes memory from the quota and returns some of it.
+static void BM_ReserveReleaseLarge(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  MemoryAllocator allocator = GetMemoryQuota()->CreateMemoryAllocator("large");
+  for (auto _ : state) {
+    allocator.Release(allocator.Reserve(MemoryRequest(2 * 1024 * 1024)));
+  }
+}
+BENCHMARK(BM_ReserveReleaseLarge)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,186 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark hosting the concurrent parts of a call (send half, receive half,
+// ...) as one activity that joins them, or as the participants of a party.
+// Streaming wakes one part per message: the activity repolls every part, the
+// party only the woken one.
+
+#include <stddef.h>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
+#include "absl/utility/utility.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/join.h"
+#include "src/core/lib/promise/loop.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/party.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Messages are delivered from outside the activity: wakeups run it inline.
+struct InlineWakeupScheduler {
+  template <typename ActivityType>
+  void ScheduleWakeup(ActivityType* activity) {
+    activity->RunScheduledWakeup();
+  }
+};
+
+class BenchParty final : public Party {
+ private:
+  void ScheduleWakeup() override { RunParty(); }
+  void PartyOver() override { delete this; }
+};
+
+// Holds one message for one part of the call. A negative message ends the
+// part.
+class Mailbox {
+ public:
+  void Deliver(int message) {
+    message_ = message;
+    waker_.Wakeup();
+  }
+
+  auto Next() {
+    return [this]() -> Poll<int> {
+      if (message_.has_value()) {
+        const int message = *message_;
+        message_.reset();
+        return message;
+      }
+      waker_ = Activity::current()->MakeOwningWaker();
+      return Pending{};
+    };
+  }
+
+ private:
+  absl::optional<int> message_;
+  Waker waker_;
+};
+
+// One part of the call: takes messages until the last one.
+auto Part(Mailbox* mailbox) {
+  return Loop([mailbox]() {
+    return Map(mailbox->Next(), [](int message) -> LoopCtl<int> {
+      if (message < 0) return message;
+      return Continue();
+    });
+  });
+}
+
+struct ActivityCall {
+  template <size_t... kPart>
+  ActivityCall(Mailbox* mailboxes, bool* done, absl::index_sequence<kPart...>)
+      : activity(MakeActivity(
+            [mailboxes]() {
+              return Map(Join(Part(&mailboxes[kPart])...),
+                         [](auto) { return absl::OkStatus(); });
+            },
+            InlineWakeupScheduler(),
+            [done](absl::Status status) {
+              GPR_ASSERT(status.ok());
+              *done = true;
+            })) {}
+
+  ActivityPtr activity;
+};
+
+struct PartyCall {
+  template <size_t... kPart>
+  PartyCall(Mailbox* mailboxes, bool* done, absl::index_sequence<kPart...>)
+      : party(MakeOrphanable<BenchParty>()) {
+    Party::BulkSpawner spawner(party.get());
+    for (size_t i = 0; i < sizeof...(kPart); i++) {
+      Mailbox* mailbox = &mailboxes[i];
+      spawner.Spawn([mailbox]() { return Part(mailbox); },
+                    [this, done](int) {
+                      if (++parts_done == sizeof...(kPart)) *done = true;
+                    });
+    }
+  }
+
+  size_t parts_done = 0;
+  OrphanablePtr<BenchParty> party;
+};
+
+// Create a call whose kParts parts end at once, and destroy it.
+template <typename Call, size_t kParts>
+static void BM_CallCreate(benchmark::State& state) {
+  Mailbox mailboxes[kParts];
+  for (auto _ : state) {
+    bool done = false;
+    for (Mailbox& mailbox : mailboxes) mailbox.Deliver(-1);
+    Call call(mailboxes, &done, absl::make_index_sequence<kParts>());
+    GPR_ASSERT(done);
+  }
+}
+BENCHMARK_TEMPLATE(BM_CallCreate, ActivityCall, 2);
+BENCHMARK_TEMPLATE(BM_CallCreate, PartyCall, 2);
+BENCHMARK_TEMPLATE(BM_CallCreate, ActivityCall, 4);
+BENCHMARK_TEMPLATE(BM_CallCreate, PartyCall, 4);
+
+// Deliver one message per iteration, to each of kParts parts in turn.
+template <typename Call, size_t kParts>
+static void BM_CallStream(benchmark::State& state) {
+  Mailbox mailboxes[kParts];
+  bool done = false;
+  {
+    Call call(mailboxes, &done, absl::make_index_sequence<kParts>());
+    size_t part = 0;
+    for (auto _ : state) {
+      mailboxes[part].Deliver(1);
+      if (++part == kParts) part = 0;
+    }
+    for (Mailbox& mailbox : mailboxes) mailbox.Deliver(-1);
+    GPR_ASSERT(done);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_CallStream, ActivityCall, 2);
+BENCHMARK_TEMPLATE(BM_CallStream, PartyCall, 2);
+BENCHMARK_TEMPLATE(BM_CallStream, ActivityCall, 4);
+BENCHMARK_TEMPLATE(BM_CallStream, PartyCall, 4);
+BENCHMARK_TEMPLATE(BM_CallStream, ActivityCall, 8);
+BENCHMARK_TEMPLATE(BM_CallStream, PartyCall, 8);
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,133 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark protobuf serialization into and parsing out of ByteBuffers, via
+// SerializationTraits and via the chunked ProtoBufferWriter/ProtoBufferReader
+// streams.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/proto_buffer_reader.h>
+#include <grpcpp/support/proto_buffer_writer.h>
+#include <grpcpp/support/slice.h>
+
+#include "src/proto/grpc/testing/echo_messages.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+EchoRequest MakeRequest(size_t size) {
+  EchoRequest request;
+  request.set_message(std::string(size, 'a'));
+  return request;
+}
+
+void BM_SerializeProto(benchmark::State& state) {
+  EchoRequest request = MakeRequest(state.range(0));
+  for (auto _ : state) {
+    ByteBuffer bb;
+    bool own_buffer;
+    GPR_ASSERT(SerializationTraits<EchoRequest>::Serialize(request, &bb,
+                                                           &own_buffer)
+                   .ok());
+  }
+  state.SetBytesProcessed(state.iterations() * request.ByteSizeLong());
+}
+BENCHMARK(BM_SerializeProto)->RangeMultiplier(8)->Range(64, 8 << 20);
+
+// Serialization through ProtoBufferWriter in blocks of at most
+// kProtoBufferWriterMaxBufferLength.
+void BM_SerializeProtoChunked(benchmark::State& state) {
+  EchoRequest request = MakeRequest(state.range(0));
+  for (auto _ : state) {
+    ByteBuffer bb;
+    ProtoBufferWriter writer(&bb, kProtoBufferWriterMaxBufferLength,
+                             static_cast<int>(request.ByteSizeLong()));
+    GPR_ASSERT(request.SerializeToZeroCopyStream(&writer));
+  }
+  state.SetBytesProcessed(state.iterations() * request.ByteSizeLong());
+}
+BENCHMARK(BM_SerializeProtoChunked)->RangeMultiplier(8)->Range(64, 8 << 20);
+
+// Returns the request serialized into `num_slices` slices.
+std::vector<Slice> SerializedSlices(const EchoRequest& request,
+                                    size_t num_slices) {
+  std::string serialized = request.SerializeAsString();
+  std::vector<Slice> slices;
+  const size_t slice_size = (serialized.size() + num_slices - 1) / num_slices;
+  for (size_t start = 0; start < serialized.size(); start += slice_size) {
+    slices.emplace_back(serialized.data() + start,
+                        std::min(slice_size, serialized.size() - start));
+  }
+  return slices;
+}
+
+// state.range(1) is the number of slices the serialized message arrives in.
+void BM_DeserializeProto(benchmark::State& state) {
+  EchoRequest request = MakeRequest(state.range(0));
+  std::vector<Slice> slices = SerializedSlices(request, state.range(1));
+  for (auto _ : state) {
+    ByteBuffer bb(slices.data(), slices.size());
+    EchoRequest parsed;
+    GPR_ASSERT(
+        SerializationTraits<EchoRequest>::Deserialize(&bb, &parsed).ok());
+  }
+  state.SetBytesProcessed(state.iterations() * request.ByteSizeLong());
+}
+BENCHMARK(BM_DeserializeProto)
+    ->ArgsProduct({benchmark::CreateRange(64, 8 << 20, 8), {1, 4}});
+
+// Parsing through ProtoBufferReader, whatever the number of slices.
+void BM_DeserializeProtoStream(benchmark::State& state) {
+  EchoRequest request = MakeRequest(state.range(0));
+  std::vector<Slice> slices = SerializedSlices(request, state.range(1));
+  for (auto _ : state) {
+    ByteBuffer bb(slices.data(), slices.size());
+    EchoRequest parsed;
+    ProtoBufferReader reader(&bb);
+    GPR_ASSERT(parsed.ParseFromZeroCopyStream(&reader));
+  }
+  state.SetBytesProcessed(state.iterations() * request.ByteSizeLong());
+}
+BENCHMARK(BM_DeserializeProtoStream)
+    ->ArgsProduct({benchmark::CreateRange(64, 8 << 20, 8), {1, 4}});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
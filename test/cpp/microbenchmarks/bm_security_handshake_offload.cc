@@ -0,0 +1,176 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark latency of RPCs on an established TLS connection while other
+// clients continuously reconnect to the same server, with TLS handshakes
+// running either on the I/O threads or on the handshake offload pool.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/grpcpp.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+#include "test/cpp/util/test_credentials_provider.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class EchoServer final : public EchoTestService::Service {
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// Runs a TLS echo server; handshakes are offloaded to a pool of
+// offload_threads threads, or run inline if offload_threads is 0.
+class TlsEchoServer final {
+ public:
+  explicit TlsEchoServer(int offload_threads) {
+    ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort(
+        "localhost:0",
+        GetCredentialsProvider()->GetServerCredentials(kTlsCredentialsType),
+        &port);
+    builder.AddChannelArgument(
+        GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD_MAX_CONCURRENT, offload_threads);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    if (server_ == nullptr || port == 0) abort();
+    address_ = absl::StrCat("localhost:", port);
+  }
+
+  ~TlsEchoServer() { server_->Shutdown(); }
+
+  std::shared_ptr<Channel> NewChannel() const {
+    ChannelArguments args;
+    // Don't share subchannels, so that every channel performs its own
+    // handshake.
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto creds = GetCredentialsProvider()->GetChannelCredentials(
+        kTlsCredentialsType, &args);
+    return CreateCustomChannel(address_, creds, args);
+  }
+
+ private:
+  EchoServer service_;
+  std::unique_ptr<Server> server_;
+  std::string address_;
+};
+
+// Clients that connect, finish the handshake and disconnect in a loop until
+// destroyed.
+class ReconnectionStorm final {
+ public:
+  ReconnectionStorm(const TlsEchoServer* server, int num_clients) {
+    for (int i = 0; i < num_clients; ++i) {
+      threads_.emplace_back([this, server]() {
+        while (!done_.load(std::memory_order_relaxed)) {
+          auto channel = server->NewChannel();
+          if (channel->WaitForConnected(std::chrono::system_clock::now() +
+                                        std::chrono::seconds(5))) {
+            connections_.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+  }
+
+  ~ReconnectionStorm() {
+    done_.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads_) thread.join();
+  }
+
+  int64_t connections() const {
+    return connections_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<bool> done_{false};
+  std::atomic<int64_t> connections_{0};
+  std::vector<std::thread> threads_;
+};
+
+void BM_EstablishedConnectionUnaryDuringReconnectionStorm(
+    benchmark::State& state) {
+  const int offload_threads = state.range(0);
+  const int storm_clients = state.range(1);
+  TlsEchoServer server(offload_threads);
+  auto stub = EchoTestService::NewStub(server.NewChannel());
+  EchoRequest request;
+  request.set_message("ping");
+  EchoResponse response;
+  {
+    // Establish the connection before the storm starts.
+    ClientContext context;
+    if (!stub->Echo(&context, request, &response).ok()) abort();
+  }
+  ReconnectionStorm storm(&server, storm_clients);
+  for (auto _ : state) {
+    ClientContext context;
+    Status status = stub->Echo(&context, request, &response);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.counters["reconnects_per_second"] = benchmark::Counter(
+      storm.connections(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EstablishedConnectionUnaryDuringReconnectionStorm)
+    ->ArgNames({"offload_threads", "storm_clients"})
+    ->Args({0, 0})
+    ->Args({0, 4})
+    ->Args({0, 16})
+    ->Args({2, 4})
+    ->Args({2, 16})
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
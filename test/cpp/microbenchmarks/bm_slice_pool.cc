@@ -0,0 +1,88 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark the allocation of read buffers for a stream of incoming data, as
+// the TCP endpoint does: slices are made from a memory allocator, held while
+// the application consumes them, and then released.
+// Run with and without --grpc_experiments=slice_pool to compare.
+
+#include <deque>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Reads state.range(0) bytes at a time, keeping the last state.range(1) reads
+// alive as a stream's unconsumed data does.
+static void BM_StreamingReads(benchmark::State& state) {
+  const size_t read_size = state.range(0);
+  const size_t window = state.range(1);
+  MemoryQuota memory_quota("bm_slice_pool");
+  MemoryAllocator allocator = memory_quota.CreateMemoryAllocator("reads");
+  ExecCtx exec_ctx;
+  std::deque<grpc_slice> unconsumed;
+  const uint64_t mallocs_before = global_stats().Collect()->slice_pool_mallocs;
+  for (auto _ : state) {
+    unconsumed.push_back(allocator.MakeSlice(MemoryRequest(read_size)));
+    if (unconsumed.size() > window) {
+      grpc_slice_unref(unconsumed.front());
+      unconsumed.pop_front();
+    }
+  }
+  for (grpc_slice slice : unconsumed) grpc_slice_unref(slice);
+  // Without the pool, every slice is one malloc().
+  const double mallocs =
+      IsSlicePoolEnabled()
+          ? global_stats().Collect()->slice_pool_mallocs - mallocs_before
+          : state.iterations();
+  const double megabytes =
+      static_cast<double>(state.iterations()) * read_size / (1024 * 1024);
+  state.SetBytesProcessed(state.iterations() * read_size);
+  state.counters["mallocs_per_mb"] = mallocs / megabytes;
+}
+BENCHMARK(BM_StreamingReads)
+    ->ArgsProduct({{2048, 8192, 65536}, {1, 16}})
+    ->ArgNames({"read_size", "window"});
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
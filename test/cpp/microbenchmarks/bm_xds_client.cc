@@ -0,0 +1,208 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark XdsClient processing of an EDS update that changes one of many
+// subscribed clusters, over a fake xDS control plane, using either the
+// state-of-the-world or the incremental (delta) protocol.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+
+#include "src/core/ext/xds/xds_bootstrap_grpc.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/core/xds/xds_transport_fake.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using envoy::config::endpoint::v3::ClusterLoadAssignment;
+using envoy::service::discovery::v3::DeltaDiscoveryResponse;
+using envoy::service::discovery::v3::DiscoveryResponse;
+
+constexpr char kEdsTypeUrl[] =
+    "type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment";
+constexpr int kEndpointsPerCluster = 100;
+
+class CountingWatcher : public XdsEndpointResourceType::WatcherInterface {
+ public:
+  void OnResourceChanged(XdsEndpointResource /*resource*/) override {
+    updates_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void OnError(absl::Status /*status*/) override {}
+  void OnResourceDoesNotExist() override {}
+
+  int updates() const { return updates_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int> updates_{0};
+};
+
+std::string ClusterName(int i) { return absl::StrCat("cluster", i); }
+
+// The endpoint ports depend on generation, so that each generation is a
+// different resource.
+ClusterLoadAssignment MakeClusterLoadAssignment(int i, int generation) {
+  ClusterLoadAssignment cla;
+  cla.set_cluster_name(ClusterName(i));
+  auto* locality = cla.add_endpoints();
+  locality->mutable_locality()->set_region("region");
+  locality->mutable_load_balancing_weight()->set_value(1);
+  for (int j = 0; j < kEndpointsPerCluster; ++j) {
+    auto* socket_address = locality->add_lb_endpoints()
+                               ->mutable_endpoint()
+                               ->mutable_address()
+                               ->mutable_socket_address();
+    socket_address->set_address("127.0.0.1");
+    socket_address->set_port_value(1000 + generation * kEndpointsPerCluster +
+                                   j);
+  }
+  return cla;
+}
+
+// Serializes a response containing all clusters.  Cluster `changed` is at
+// the given generation, and all others are at generation 0.
+std::string MakeResponse(bool delta, int num_clusters, int changed,
+                         int generation, const std::string& nonce) {
+  std::string serialized;
+  if (delta) {
+    // A delta response carries only the changed cluster, unless this is the
+    // initial response.
+    DeltaDiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    response.set_nonce(nonce);
+    for (int i = 0; i < num_clusters; ++i) {
+      if (changed >= 0 && i != changed) continue;
+      auto* resource = response.add_resources();
+      resource->set_name(ClusterName(i));
+      resource->set_version(absl::StrCat(i == changed ? generation : 0));
+      resource->mutable_resource()->PackFrom(
+          MakeClusterLoadAssignment(i, i == changed ? generation : 0));
+    }
+    response.SerializeToString(&serialized);
+  } else {
+    DiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    response.set_version_info(absl::StrCat(generation));
+    response.set_nonce(nonce);
+    for (int i = 0; i < num_clusters; ++i) {
+      response.add_resources()->PackFrom(
+          MakeClusterLoadAssignment(i, i == changed ? generation : 0));
+    }
+    response.SerializeToString(&serialized);
+  }
+  return serialized;
+}
+
+// Subscribes to state.range(0) EDS resources and then repeatedly applies
+// an update that changes only one of them.  With the delta protocol
+// (state.range(1) == 1), the server sends only the changed resource.
+void BM_XdsClientUpdateOneCluster(benchmark::State& state) {
+  const int num_clusters = state.range(0);
+  const bool delta = state.range(1) != 0;
+  auto bootstrap = GrpcXdsBootstrap::Create(absl::StrCat(
+      "{\"xds_servers\":[{\"server_uri\":\"xds.example.com\","
+      "\"channel_creds\":[{\"type\":\"insecure\"}],"
+      "\"server_features\":[",
+      delta ? "\"delta_protocol\"" : "", "]}]}"));
+  if (!bootstrap.ok()) {
+    state.SkipWithError(bootstrap.status().ToString().c_str());
+    return;
+  }
+  auto transport_factory = MakeOrphanable<FakeXdsTransportFactory>();
+  auto* transport_factory_ptr = transport_factory.get();
+  auto xds_client = MakeRefCounted<XdsClient>(
+      std::move(*bootstrap), std::move(transport_factory),
+      grpc_event_engine::experimental::GetDefaultEventEngine());
+  std::vector<RefCountedPtr<CountingWatcher>> watchers;
+  for (int i = 0; i < num_clusters; ++i) {
+    watchers.push_back(MakeRefCounted<CountingWatcher>());
+    XdsEndpointResourceType::StartWatch(xds_client.get(), ClusterName(i),
+                                        watchers.back());
+  }
+  auto stream = transport_factory_ptr->WaitForStream(
+      xds_client->bootstrap().server(),
+      delta ? FakeXdsTransportFactory::kDeltaAdsMethod
+            : FakeXdsTransportFactory::kAdsMethod,
+      absl::Seconds(5));
+  if (stream == nullptr) {
+    state.SkipWithError("ADS stream not started");
+    return;
+  }
+  // Drain the subscription requests, then send the initial resources.
+  while (stream->WaitForMessageFromClient(absl::Milliseconds(100))
+             .has_value()) {
+  }
+  stream->SendMessageToClient(
+      MakeResponse(delta, num_clusters, /*changed=*/-1, 0, "initial"));
+  stream->WaitForMessageFromClient(absl::Seconds(5));
+  // Pre-serialize the updates, alternating between two generations of the
+  // changed cluster.
+  const int changed = num_clusters / 2;
+  const std::string updates[] = {
+      MakeResponse(delta, num_clusters, changed, 1, "A"),
+      MakeResponse(delta, num_clusters, changed, 2, "B"),
+  };
+  size_t n = 0;
+  for (auto _ : state) {
+    stream->SendMessageToClient(updates[n++ % 2]);
+    // Wait for the ACK, so that requests don't pile up.
+    stream->WaitForMessageFromClient(absl::Seconds(5));
+  }
+  if (watchers[changed]->updates() != static_cast<int>(n) + 1) {
+    state.SkipWithError("changed cluster's watcher not notified");
+  }
+  state.SetBytesProcessed(n * updates[0].size());
+  for (int i = 0; i < num_clusters; ++i) {
+    XdsEndpointResourceType::CancelWatch(xds_client.get(), ClusterName(i),
+                                         watchers[i].get());
+  }
+}
+BENCHMARK(BM_XdsClientUpdateOneCluster)
+    ->ArgNames({"clusters", "delta"})
+    ->ArgsProduct({{10, 100, 1000}, {0, 1}});
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,185 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmark xDS virtual host and route selection for large route
+// configurations, with and without the precompiled indexes.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Routes shaped like a large RDS config: mostly exact method routes, one
+// prefix route and one regex route per service, and a default route.
+class Routes : public XdsRouting::RouteListIterator {
+ public:
+  explicit Routes(int num_routes) {
+    const int num_services = std::max(1, num_routes / 12);
+    for (int service = 0; service < num_services; ++service) {
+      const std::string name = absl::StrCat("/pkg.Service", service, "/");
+      for (int method = 0; method < 10; ++method) {
+        Add(StringMatcher::Type::kExact, absl::StrCat(name, "Method", method));
+      }
+      Add(StringMatcher::Type::kSafeRegex,
+          absl::StrCat("/pkg\\.Service", service, "/Stream[0-9]+"));
+      Add(StringMatcher::Type::kPrefix, name);
+    }
+    Add(StringMatcher::Type::kPrefix, "");
+    // A request matching one of the last service's exact routes.
+    path_ = absl::StrCat("/pkg.Service", num_services - 1, "/Method9");
+  }
+
+  size_t Size() const override { return matchers_.size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return matchers_[index];
+  }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  void Add(StringMatcher::Type type, absl::string_view path) {
+    XdsRouteConfigResource::Route::Matchers matchers;
+    matchers.path_matcher = StringMatcher::Create(type, path).value();
+    matchers_.push_back(std::move(matchers));
+  }
+
+  std::vector<XdsRouteConfigResource::Route::Matchers> matchers_;
+  std::string path_;
+};
+
+class VirtualHosts : public XdsRouting::VirtualHostListIterator {
+ public:
+  explicit VirtualHosts(int num_vhosts) {
+    for (int i = 0; i < num_vhosts; ++i) {
+      domains_.push_back({absl::StrCat("service", i, ".example.com"),
+                          absl::StrCat("*.service", i, ".example.com")});
+    }
+    domains_.push_back({"*"});
+  }
+
+  size_t Size() const override { return domains_.size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return domains_[index];
+  }
+
+ private:
+  std::vector<std::vector<std::string>> domains_;
+};
+
+class Metadata {
+ public:
+  grpc_metadata_batch* batch() { return &batch_; }
+
+ private:
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+          "bm_xds_routing");
+  ScopedArenaPtr arena_ = MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch batch_{arena_.get()};
+};
+
+void BM_GetRouteForRequestLinear(benchmark::State& state) {
+  Routes routes(state.range(0));
+  Metadata metadata;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(XdsRouting::GetRouteForRequest(
+        routes, routes.path(), metadata.batch()));
+  }
+}
+BENCHMARK(BM_GetRouteForRequestLinear)->RangeMultiplier(10)->Range(10, 10000);
+
+void BM_GetRouteForRequestIndexed(benchmark::State& state) {
+  Routes routes(state.range(0));
+  XdsRouting::RouteIndex index(routes);
+  Metadata metadata;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        index.GetRouteForRequest(routes, routes.path(), metadata.batch()));
+  }
+}
+BENCHMARK(BM_GetRouteForRequestIndexed)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+
+void BM_BuildRouteIndex(benchmark::State& state) {
+  Routes routes(state.range(0));
+  for (auto _ : state) {
+    XdsRouting::RouteIndex index(routes);
+    benchmark::DoNotOptimize(&index);
+  }
+}
+BENCHMARK(BM_BuildRouteIndex)->RangeMultiplier(10)->Range(10, 10000);
+
+void BM_FindVirtualHostLinear(benchmark::State& state) {
+  VirtualHosts vhosts(state.range(0));
+  const std::string domain =
+      absl::StrCat("api.service", state.range(0) - 1, ".example.com");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        XdsRouting::FindVirtualHostForDomain(vhosts, domain));
+  }
+}
+BENCHMARK(BM_FindVirtualHostLinear)->RangeMultiplier(10)->Range(10, 10000);
+
+void BM_FindVirtualHostIndexed(benchmark::State& state) {
+  VirtualHosts vhosts(state.range(0));
+  XdsRouting::VirtualHostIndex index(vhosts);
+  const std::string domain =
+      absl::StrCat("api.service", state.range(0) - 1, ".example.com");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.Find(domain));
+  }
+}
+BENCHMARK(BM_FindVirtualHostIndexed)->RangeMultiplier(10)->Range(10, 10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -21,6 +21,9 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 
 #include <benchmark/benchmark.h>
@@ -160,6 +163,255 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
   fixture.reset();
   state.SetBytesProcessed(state.range(0) * state.iterations());
 }
+
+/*******************************************************************************
+ * CALLBACK API KERNELS
+ * The sender writes one message per iteration without waiting for the
+ * receiver, either with a StartWrite from each OnWriteDone or, with
+ * kWriteQueue, through the reactor's write queue. writes_per_msg counts the
+ * HTTP/2 writes per message (none for InProcess).
+ */
+
+// Writes one message per benchmark iteration from a callback bidi reactor.
+template <class Reactor, class Message>
+class CallbackPump {
+ public:
+  CallbackPump(benchmark::State* state, Reactor* reactor, const Message* msg,
+               bool write_queue)
+      : state_(state), reactor_(reactor), msg_(msg), write_queue_(write_queue) {
+    if (write_queue_) {
+      reactor_->EnableWriteQueue(kQueueMessages, kQueueBytes, kQueueBytes / 2);
+    }
+  }
+
+  // Called to start the writes and from each OnWriteDone or OnWriteQueueLow.
+  // Returns false once there is nothing left to write.
+  bool Pump() {
+    if (!write_queue_) {
+      if (!state_->KeepRunning()) return false;
+      reactor_->StartWrite(msg_);
+      return true;
+    }
+    while (pending_ || state_->KeepRunning()) {
+      // An iteration that the queue refuses is written on OnWriteQueueLow.
+      pending_ = true;
+      if (!reactor_->StartQueuedWrite(msg_)) return true;
+      pending_ = false;
+    }
+    return false;
+  }
+
+ private:
+  static constexpr size_t kQueueMessages = 64;
+  static constexpr size_t kQueueBytes = 1024 * 1024;
+
+  benchmark::State* const state_;
+  Reactor* const reactor_;
+  const Message* const msg_;
+  const bool write_queue_;
+  bool pending_ = false;
+};
+
+// Counts the HTTP/2 writes that a kernel needed per message.
+class CallbackPumpWrites {
+ public:
+  CallbackPumpWrites()
+      : writes_begun_(grpc_core::global_stats().Collect()->http2_writes_begun) {
+  }
+
+  void Report(benchmark::State& state) {
+    const uint64_t writes =
+        grpc_core::global_stats().Collect()->http2_writes_begun -
+        writes_begun_;
+    state.counters["writes_per_msg"] = benchmark::Counter(
+        static_cast<double>(writes) /
+        static_cast<double>(std::max<int64_t>(state.iterations(), 1)));
+  }
+
+ private:
+  const uint64_t writes_begun_;
+};
+
+// Waits for the OnDone of a client reactor.
+class CallbackPumpDone {
+ public:
+  void Notify() {
+    std::unique_lock<std::mutex> l(mu_);
+    done_ = true;
+    cv_.notify_one();
+  }
+
+  void Await() {
+    std::unique_lock<std::mutex> l(mu_);
+    while (!done_) {
+      cv_.wait(l);
+    }
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool done_ = false;
+};
+
+class CallbackPumpSinkService : public EchoTestService::CallbackService {
+ public:
+  ServerBidiReactor<EchoRequest, EchoResponse>* BidiStream(
+      CallbackServerContext* /*context*/) override {
+    class Reactor : public ServerBidiReactor<EchoRequest, EchoResponse> {
+     public:
+      Reactor() { StartRead(&request_); }
+      void OnReadDone(bool ok) override {
+        if (ok) {
+          StartRead(&request_);
+        } else {
+          Finish(Status::OK);
+        }
+      }
+      void OnDone() override { delete this; }
+
+     private:
+      EchoRequest request_;
+    };
+    return new Reactor;
+  }
+};
+
+template <class Fixture, bool kWriteQueue>
+static void BM_CallbackPumpStreamClientToServer(benchmark::State& state) {
+  CallbackPumpSinkService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  {
+    EchoRequest send_request;
+    if (state.range(0) > 0) {
+      send_request.set_message(std::string(state.range(0), 'a'));
+    }
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    class Client : public ClientBidiReactor<EchoRequest, EchoResponse> {
+     public:
+      Client(benchmark::State* state, const EchoRequest* request)
+          : pump_(state, this, request, kWriteQueue) {}
+      void Start(EchoTestService::Stub* stub) {
+        stub->async()->BidiStream(&cli_ctx_, this);
+        MaybeWritesDone(pump_.Pump());
+        StartCall();
+      }
+      void OnWriteDone(bool ok) override {
+        GPR_ASSERT(ok);
+        MaybeWritesDone(pump_.Pump());
+      }
+      void OnWriteQueueLow(bool ok) override {
+        GPR_ASSERT(ok);
+        MaybeWritesDone(pump_.Pump());
+      }
+      void OnDone(const Status& s) override {
+        GPR_ASSERT(s.ok());
+        done_.Notify();
+      }
+      void Await() { done_.Await(); }
+
+     private:
+      void MaybeWritesDone(bool writing) {
+        if (!writing) StartWritesDone();
+      }
+
+      ClientContext cli_ctx_;
+      CallbackPump<Client, EchoRequest> pump_;
+      CallbackPumpDone done_;
+    };
+    CallbackPumpWrites writes;
+    Client client(&state, &send_request);
+    client.Start(stub.get());
+    client.Await();
+    writes.Report(state);
+  }
+  fixture.reset();
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+template <bool kWriteQueue>
+class CallbackPumpSourceService : public EchoTestService::CallbackService {
+ public:
+  CallbackPumpSourceService(benchmark::State* state,
+                            const EchoResponse* response)
+      : state_(state), response_(response) {}
+
+  ServerBidiReactor<EchoRequest, EchoResponse>* BidiStream(
+      CallbackServerContext* /*context*/) override {
+    class Reactor : public ServerBidiReactor<EchoRequest, EchoResponse> {
+     public:
+      Reactor(benchmark::State* state, const EchoResponse* response)
+          : pump_(state, this, response, kWriteQueue) {
+        MaybeFinish(pump_.Pump());
+      }
+      void OnWriteDone(bool ok) override {
+        GPR_ASSERT(ok);
+        MaybeFinish(pump_.Pump());
+      }
+      void OnWriteQueueLow(bool ok) override {
+        GPR_ASSERT(ok);
+        MaybeFinish(pump_.Pump());
+      }
+      void OnDone() override { delete this; }
+
+     private:
+      void MaybeFinish(bool writing) {
+        if (!writing) Finish(Status::OK);
+      }
+
+      CallbackPump<Reactor, EchoResponse> pump_;
+    };
+    return new Reactor(state_, response_);
+  }
+
+ private:
+  benchmark::State* const state_;
+  const EchoResponse* const response_;
+};
+
+template <class Fixture, bool kWriteQueue>
+static void BM_CallbackPumpStreamServerToClient(benchmark::State& state) {
+  EchoResponse send_response;
+  if (state.range(0) > 0) {
+    send_response.set_message(std::string(state.range(0), 'a'));
+  }
+  CallbackPumpSourceService<kWriteQueue> service(&state, &send_response);
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  {
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    class Client : public ClientBidiReactor<EchoRequest, EchoResponse> {
+     public:
+      void Start(EchoTestService::Stub* stub) {
+        stub->async()->BidiStream(&cli_ctx_, this);
+        StartRead(&recv_response_);
+        StartWritesDone();
+        StartCall();
+      }
+      void OnReadDone(bool ok) override {
+        if (ok) StartRead(&recv_response_);
+      }
+      void OnDone(const Status& s) override {
+        GPR_ASSERT(s.ok());
+        done_.Notify();
+      }
+      void Await() { done_.Await(); }
+
+     private:
+      ClientContext cli_ctx_;
+      EchoResponse recv_response_;
+      CallbackPumpDone done_;
+    };
+    CallbackPumpWrites writes;
+    Client client;
+    client.Start(stub.get());
+    client.Await();
+    writes.Report(state);
+  }
+  fixture.reset();
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,161 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures in-process unary RPCs against a callback server, with the request
+// and response messages allocated for every call or reused through
+// ServerBuilder::experimental().EnablePooledMessageAllocator(), and counts
+// the operator new calls per RPC of the whole process. Allocations of the C
+// core go through gpr_malloc and are not counted.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <google/protobuf/field_mask.pb.h>
+
+#include "absl/flags/flag.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/impl/rpc_service_method.h>
+#include <grpcpp/impl/server_callback_handlers.h>
+#include <grpcpp/impl/service_type.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/qps/histogram.h"
+#include "test/cpp/qps/usage_timer.h"
+#include "test/cpp/util/test_config.h"
+
+ABSL_FLAG(int32_t, paths, 64, "Number of strings in the request.");
+ABSL_FLAG(int32_t, path_bytes, 32, "Size of each string of the request.");
+ABSL_FLAG(int32_t, warmup_rpcs, 200, "RPCs to run before measuring.");
+ABSL_FLAG(int32_t, rpcs, 5000, "RPCs to measure in each configuration.");
+ABSL_FLAG(int32_t, pool_capacity, 64,
+          "Messages kept per thread by the pooled allocator.");
+
+namespace {
+std::atomic<int64_t> g_allocations{0};
+}  // namespace
+
+// Count every C++ heap allocation of the process.
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace grpc {
+namespace testing {
+
+using google::protobuf::FieldMask;
+
+constexpr char kMethodName[] = "/grpc.testing.MessagePoolService/Echo";
+
+// Registers the method the way generated code does, without needing a
+// service definition for FieldMask.
+class MessagePoolService : public Service {
+ public:
+  MessagePoolService() {
+    AddMethod(new internal::RpcServiceMethod(
+        kMethodName, internal::RpcMethod::NORMAL_RPC, nullptr));
+    MarkMethodCallback(
+        0, new internal::CallbackUnaryHandler<FieldMask, FieldMask>(
+               [](CallbackServerContext* context, const FieldMask* request,
+                  FieldMask* response) {
+                 *response->mutable_paths() = request->paths();
+                 auto* reactor = context->DefaultReactor();
+                 reactor->Finish(Status::OK);
+                 return reactor;
+               }));
+  }
+};
+
+void RunConfiguration(bool pool, const FieldMask& request) {
+  MessagePoolService service;
+  ServerBuilder builder;
+  if (pool) {
+    builder.experimental().EnablePooledMessageAllocator(
+        absl::GetFlag(FLAGS_pool_capacity));
+  }
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  auto channel = server->InProcessChannel(ChannelArguments());
+  internal::RpcMethod method(kMethodName, internal::RpcMethod::NORMAL_RPC,
+                             channel);
+  FieldMask response;
+  auto run_rpc = [&]() {
+    ClientContext context;
+    Status status = internal::BlockingUnaryCall(channel.get(), method,
+                                                &context, request, &response);
+    GPR_ASSERT(status.ok());
+  };
+  for (int i = 0; i < absl::GetFlag(FLAGS_warmup_rpcs); ++i) run_rpc();
+  const int rpcs = absl::GetFlag(FLAGS_rpcs);
+  Histogram latencies;
+  const int64_t allocations_before = g_allocations.load();
+  UsageTimer timer;
+  for (int i = 0; i < rpcs; ++i) {
+    double start = UsageTimer::Now();
+    run_rpc();
+    latencies.Add((UsageTimer::Now() - start) * 1e9);
+  }
+  UsageTimer::Result usage = timer.Mark();
+  const int64_t allocations = g_allocations.load() - allocations_before;
+  server->Shutdown();
+  gpr_log(GPR_INFO,
+          "%s messages: %.1f allocations/rpc, %.0f rpcs/s, %.1f us cpu/rpc, "
+          "latency p50 %.1f us p99 %.1f us",
+          pool ? "pooled" : "per-call", static_cast<double>(allocations) / rpcs,
+          rpcs / usage.wall, (usage.user + usage.system) * 1e6 / rpcs,
+          latencies.Percentile(50) / 1e3, latencies.Percentile(99) / 1e3);
+}
+
+void RunBenchmark() {
+  FieldMask request;
+  for (int i = 0; i < absl::GetFlag(FLAGS_paths); ++i) {
+    request.add_paths(std::string(absl::GetFlag(FLAGS_path_bytes), 'a'));
+  }
+  gpr_log(GPR_INFO, "Request: %d strings, %zu bytes", request.paths_size(),
+          request.ByteSizeLong());
+  for (bool pool : {false, true}) {
+    RunConfiguration(pool, request);
+  }
+}
+
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, true);
+  grpc::testing::RunBenchmark();
+  return 0;
+}
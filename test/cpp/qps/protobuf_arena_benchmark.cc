@@ -0,0 +1,176 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures in-process unary RPCs carrying a large, deeply nested request,
+// with the server-side messages allocated on the heap or on a protobuf arena
+// (ServerBuilder::experimental().EnableProtobufArena()).
+
+#include <memory>
+#include <string>
+
+#include <google/protobuf/struct.pb.h>
+
+#include "absl/flags/flag.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/impl/rpc_service_method.h>
+#include <grpcpp/impl/server_callback_handlers.h>
+#include <grpcpp/impl/service_type.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/method_handler.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/qps/histogram.h"
+#include "test/cpp/qps/usage_timer.h"
+#include "test/cpp/util/test_config.h"
+
+ABSL_FLAG(int32_t, depth, 4, "Nesting depth of the request message.");
+ABSL_FLAG(int32_t, fanout, 8, "Number of fields of each nested message.");
+ABSL_FLAG(int32_t, warmup_rpcs, 200, "RPCs to run before measuring.");
+ABSL_FLAG(int32_t, rpcs, 2000, "RPCs to measure in each configuration.");
+ABSL_FLAG(std::string, api, "sync", "Server API to use: sync or callback.");
+
+namespace grpc {
+namespace testing {
+
+using google::protobuf::Struct;
+
+constexpr char kServiceName[] = "grpc.testing.ArenaBenchmarkService";
+constexpr char kMethodName[] = "/grpc.testing.ArenaBenchmarkService/Echo";
+
+// A Struct with `fanout` fields at each of `depth` levels, so that parsing
+// it allocates fanout^depth submessages and strings.
+void FillStruct(int depth, int fanout, Struct* s) {
+  for (int i = 0; i < fanout; ++i) {
+    auto& value = (*s->mutable_fields())[absl::StrCat("field", i)];
+    if (depth > 1) {
+      FillStruct(depth - 1, fanout, value.mutable_struct_value());
+    } else {
+      value.set_string_value(absl::StrCat("value", i));
+    }
+  }
+}
+
+int CountLeaves(const Struct& s) {
+  int leaves = 0;
+  for (const auto& field : s.fields()) {
+    leaves += field.second.has_struct_value()
+                  ? CountLeaves(field.second.struct_value())
+                  : 1;
+  }
+  return leaves;
+}
+
+// Responds with the number of leaves in the request, so that the whole
+// request has to be walked.
+void Echo(const Struct* request, Struct* response) {
+  (*response->mutable_fields())["leaves"].set_number_value(
+      CountLeaves(*request));
+}
+
+// Registers the method the way generated code does, without needing a
+// service definition for Struct.
+class ArenaBenchmarkService : public Service {
+ public:
+  explicit ArenaBenchmarkService(bool callback) {
+    AddMethod(new internal::RpcServiceMethod(
+        kMethodName, internal::RpcMethod::NORMAL_RPC,
+        new internal::RpcMethodHandler<ArenaBenchmarkService, Struct, Struct>(
+            [](ArenaBenchmarkService*, ServerContext*, const Struct* request,
+               Struct* response) {
+              Echo(request, response);
+              return Status::OK;
+            },
+            this)));
+    if (callback) {
+      MarkMethodCallback(
+          0, new internal::CallbackUnaryHandler<Struct, Struct>(
+                 [](CallbackServerContext* context, const Struct* request,
+                    Struct* response) {
+                   Echo(request, response);
+                   auto* reactor = context->DefaultReactor();
+                   reactor->Finish(Status::OK);
+                   return reactor;
+                 }));
+    }
+  }
+};
+
+void RunConfiguration(bool callback, bool arena, const Struct& request) {
+  ArenaBenchmarkService service(callback);
+  ServerBuilder builder;
+  if (arena) builder.experimental().EnableProtobufArena(kServiceName);
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  auto channel = server->InProcessChannel(ChannelArguments());
+  internal::RpcMethod method(kMethodName, internal::RpcMethod::NORMAL_RPC,
+                             channel);
+  auto run_rpc = [&]() {
+    ClientContext context;
+    Struct response;
+    Status status = internal::BlockingUnaryCall(channel.get(), method,
+                                                &context, request, &response);
+    GPR_ASSERT(status.ok());
+  };
+  for (int i = 0; i < absl::GetFlag(FLAGS_warmup_rpcs); ++i) run_rpc();
+  const int rpcs = absl::GetFlag(FLAGS_rpcs);
+  Histogram latencies;
+  UsageTimer timer;
+  for (int i = 0; i < rpcs; ++i) {
+    double start = UsageTimer::Now();
+    run_rpc();
+    latencies.Add((UsageTimer::Now() - start) * 1e9);
+  }
+  UsageTimer::Result usage = timer.Mark();
+  server->Shutdown();
+  gpr_log(GPR_INFO,
+          "%s server, %s messages: %.0f rpcs/s, %.1f us cpu/rpc, "
+          "latency p50 %.1f us p99 %.1f us",
+          callback ? "callback" : "sync", arena ? "arena" : "heap",
+          rpcs / usage.wall, (usage.user + usage.system) * 1e6 / rpcs,
+          latencies.Percentile(50) / 1e3, latencies.Percentile(99) / 1e3);
+}
+
+void RunBenchmark() {
+  const std::string api = absl::GetFlag(FLAGS_api);
+  GPR_ASSERT(api == "sync" || api == "callback");
+  Struct request;
+  FillStruct(absl::GetFlag(FLAGS_depth), absl::GetFlag(FLAGS_fanout),
+             &request);
+  gpr_log(GPR_INFO, "Request: %d leaves, %zu bytes", CountLeaves(request),
+          request.ByteSizeLong());
+  for (bool arena : {false, true}) {
+    RunConfiguration(api == "callback", arena, request);
+  }
+}
+
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, true);
+  grpc::testing::RunBenchmark();
+  return 0;
+}
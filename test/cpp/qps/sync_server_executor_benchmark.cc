@@ -0,0 +1,185 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Overloads an in-process sync server whose handler blocks for a while, and
+// compares the default ThreadManager dispatch with the sync server executor
+// (ServerBuilder::experimental().EnableSyncServerExecutor()): process thread
+// count, throughput, latency and the number of RPCs shed with
+// RESOURCE_EXHAUSTED.
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/wrappers.pb.h>
+
+#include "absl/flags/flag.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/impl/rpc_service_method.h>
+#include <grpcpp/impl/service_type.h>
+#include <grpcpp/impl/sync.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/method_handler.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/qps/histogram.h"
+#include "test/cpp/qps/usage_timer.h"
+#include "test/cpp/util/test_config.h"
+
+ABSL_FLAG(int32_t, client_threads, 64, "Threads issuing blocking RPCs.");
+ABSL_FLAG(int32_t, rpcs_per_thread, 50, "RPCs issued by each client thread.");
+ABSL_FLAG(int32_t, handler_us, 2000, "Time each handler blocks for.");
+ABSL_FLAG(int32_t, max_concurrent_rpcs, 16,
+          "Handlers running at once with the executor.");
+ABSL_FLAG(int32_t, max_queued_rpcs, 32,
+          "RPCs waiting for the executor before shedding load.");
+ABSL_FLAG(std::string, mode, "both",
+          "Sync server dispatch: thread_manager, executor or both.");
+
+namespace grpc {
+namespace testing {
+
+using google::protobuf::StringValue;
+
+constexpr char kMethodName[] = "/grpc.testing.BlockingService/Sleep";
+
+class BlockingService : public Service {
+ public:
+  BlockingService() {
+    AddMethod(new internal::RpcServiceMethod(
+        kMethodName, internal::RpcMethod::NORMAL_RPC,
+        new internal::RpcMethodHandler<BlockingService, StringValue,
+                                       StringValue>(
+            [](BlockingService*, ServerContext*, const StringValue* request,
+               StringValue* response) {
+              std::this_thread::sleep_for(std::chrono::microseconds(
+                  absl::GetFlag(FLAGS_handler_us)));
+              response->set_value(request->value());
+              return Status::OK;
+            },
+            this)));
+  }
+};
+
+// Returns the number of threads of this process, or 0 if unknown.
+int ProcessThreads() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) return std::stoi(line.substr(8));
+  }
+  return 0;
+}
+
+void RunConfiguration(bool executor) {
+  BlockingService service;
+  ServerBuilder builder;
+  if (executor) {
+    builder.experimental().EnableSyncServerExecutor(
+        absl::GetFlag(FLAGS_max_concurrent_rpcs),
+        absl::GetFlag(FLAGS_max_queued_rpcs));
+  }
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  auto channel = server->InProcessChannel(ChannelArguments());
+  internal::RpcMethod method(kMethodName, internal::RpcMethod::NORMAL_RPC,
+                             channel);
+  const int threads_before = ProcessThreads();
+
+  std::atomic<bool> done{false};
+  std::atomic<int> peak_threads{0};
+  std::thread sampler([&done, &peak_threads] {
+    while (!done.load(std::memory_order_relaxed)) {
+      const int threads = ProcessThreads();
+      if (threads > peak_threads.load(std::memory_order_relaxed)) {
+        peak_threads.store(threads, std::memory_order_relaxed);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  });
+
+  internal::Mutex mu;
+  Histogram latencies;
+  int ok = 0;
+  int exhausted = 0;
+  UsageTimer timer;
+  std::vector<std::thread> clients;
+  for (int i = 0; i < absl::GetFlag(FLAGS_client_threads); ++i) {
+    clients.emplace_back([&] {
+      StringValue request;
+      request.set_value("hello");
+      for (int j = 0; j < absl::GetFlag(FLAGS_rpcs_per_thread); ++j) {
+        ClientContext context;
+        StringValue response;
+        double start = UsageTimer::Now();
+        Status status = internal::BlockingUnaryCall(
+            channel.get(), method, &context, request, &response);
+        double latency = UsageTimer::Now() - start;
+        internal::MutexLock lock(&mu);
+        if (status.ok()) {
+          ++ok;
+          latencies.Add(latency * 1e9);
+        } else {
+          GPR_ASSERT(status.error_code() == StatusCode::RESOURCE_EXHAUSTED);
+          ++exhausted;
+        }
+      }
+    });
+  }
+  for (auto& client : clients) client.join();
+  UsageTimer::Result usage = timer.Mark();
+  done.store(true, std::memory_order_relaxed);
+  sampler.join();
+  server->Shutdown();
+
+  // The peak includes the client threads and the sampler.
+  gpr_log(GPR_INFO,
+          "%s: %d threads at peak (%d before the clients started), "
+          "%.0f ok rpcs/s, %d ok, %d RESOURCE_EXHAUSTED, "
+          "latency p50 %.1f ms p99 %.1f ms",
+          executor ? "executor" : "thread_manager", peak_threads.load(),
+          threads_before, ok / usage.wall, ok, exhausted,
+          latencies.Percentile(50) / 1e6, latencies.Percentile(99) / 1e6);
+}
+
+void RunBenchmark() {
+  const std::string mode = absl::GetFlag(FLAGS_mode);
+  GPR_ASSERT(mode == "thread_manager" || mode == "executor" || mode == "both");
+  if (mode != "executor") RunConfiguration(/*executor=*/false);
+  if (mode != "thread_manager") RunConfiguration(/*executor=*/true);
+}
+
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, true);
+  grpc::testing::RunBenchmark();
+  return 0;
+}
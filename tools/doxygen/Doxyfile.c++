@@ -1057,6 +1057,7 @@ include/grpcpp/support/config.h \
 include/grpcpp/support/interceptor.h \
 include/grpcpp/support/message_allocator.h \
 include/grpcpp/support/method_handler.h \
+include/grpcpp/support/pooled_message_allocator.h \
 include/grpcpp/support/proto_buffer_reader.h \
 include/grpcpp/support/proto_buffer_writer.h \
 include/grpcpp/support/server_callback.h \